@@ -0,0 +1,171 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "benchmark-utils.h"
+
+#include <QtTest/QtTest>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{0};
+
+void * allocate(std::size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (auto result = std::malloc(size ? size : 1))
+		return result;
+	throw std::bad_alloc{};
+}
+
+#ifdef __linux__
+
+int open_counter(std::uint64_t config, int group_descriptor)
+{
+	auto attributes = perf_event_attr{};
+	std::memset(&attributes, 0, sizeof(attributes));
+	attributes.type = PERF_TYPE_HARDWARE;
+	attributes.size = sizeof(attributes);
+	attributes.config = config;
+	attributes.disabled = group_descriptor == -1 ? 1 : 0;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+	attributes.read_format = PERF_FORMAT_GROUP;
+
+	return static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, group_descriptor, 0));
+}
+
+#endif
+
+}
+
+void * operator new (std::size_t size)
+{
+	return allocate(size);
+}
+
+void * operator new[] (std::size_t size)
+{
+	return allocate(size);
+}
+
+void operator delete (void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[] (void *p) noexcept
+{
+	std::free(p);
+}
+
+namespace injeqt { namespace bench {
+
+std::uint64_t allocation_count()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
+
+hardware_counters::hardware_counters()
+{
+#ifdef __linux__
+	for (auto config : {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES})
+	{
+		auto descriptor = open_counter(config, _descriptors.empty() ? -1 : _descriptors.front());
+		if (descriptor == -1)
+		{
+			for (auto d : _descriptors)
+				close(d);
+			_descriptors.clear();
+			return;
+		}
+		_descriptors.push_back(descriptor);
+	}
+#endif
+}
+
+hardware_counters::~hardware_counters()
+{
+#ifdef __linux__
+	for (auto d : _descriptors)
+		close(d);
+#endif
+}
+
+bool hardware_counters::available() const
+{
+	return !_descriptors.empty();
+}
+
+void hardware_counters::start()
+{
+#ifdef __linux__
+	if (!available())
+		return;
+
+	ioctl(_descriptors.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(_descriptors.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+counter_values hardware_counters::stop()
+{
+#ifdef __linux__
+	if (!available())
+		return counter_values{0, 0, 0, 0};
+
+	ioctl(_descriptors.front(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	// PERF_FORMAT_GROUP layout: number of counters followed by values in order of opening
+	std::uint64_t data[5] = {0, 0, 0, 0, 0};
+	if (read(_descriptors.front(), data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[0] != 4)
+		return counter_values{0, 0, 0, 0};
+
+	return counter_values{data[1], data[2], data[3], data[4]};
+#else
+	return counter_values{0, 0, 0, 0};
+#endif
+}
+
+void report(const measurement &result)
+{
+	if (result.has_counters)
+		std::printf("    %.1f ns/op, %.2f allocations/op, %.1f cycles/op, %.1f instructions/op, %.3f cache-misses/op, %.3f branch-misses/op\n",
+			result.nanoseconds, result.allocations, result.cycles, result.instructions, result.cache_misses, result.branch_misses);
+	else
+		std::printf("    %.1f ns/op, %.2f allocations/op, hardware counters not available\n",
+			result.nanoseconds, result.allocations);
+	std::fflush(stdout);
+
+	QTest::setBenchmarkResult(result.nanoseconds, QTest::WalltimeNanoseconds);
+}
+
+}}
@@ -0,0 +1,148 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @brief Measurement helpers for micro benchmarks.
+ *
+ * Each measured operation is reported as nanoseconds, allocations and hardware
+ * counter values per operation. Allocations are counted by replacing global
+ * operator new in benchmark-utils.cpp, hardware counters are read with
+ * perf_event_open and are only available on Linux (and only if kernel allows
+ * it, see /proc/sys/kernel/perf_event_paranoid).
+ */
+
+namespace injeqt { namespace bench {
+
+/**
+ * @return number of calls to global operator new since program start
+ */
+std::uint64_t allocation_count();
+
+/**
+ * @brief Values of hardware counters.
+ */
+struct counter_values
+{
+	std::uint64_t cycles;
+	std::uint64_t instructions;
+	std::uint64_t cache_misses;
+	std::uint64_t branch_misses;
+};
+
+/**
+ * @brief Group of hardware counters of current thread.
+ *
+ * All counters are opened as one perf_event group, so they are always scheduled
+ * together and values are comparable. If any of counters cannot be opened then
+ * available() returns false and stop() returns zeros.
+ */
+class hardware_counters final
+{
+
+public:
+	hardware_counters();
+	~hardware_counters();
+
+	hardware_counters(const hardware_counters &) = delete;
+	hardware_counters & operator = (const hardware_counters &) = delete;
+
+	bool available() const;
+
+	void start();
+	counter_values stop();
+
+private:
+	std::vector<int> _descriptors;
+
+};
+
+/**
+ * @brief Results of one micro benchmark, all values are per operation.
+ */
+struct measurement
+{
+	double nanoseconds;
+	double allocations;
+	bool has_counters;
+	double cycles;
+	double instructions;
+	double cache_misses;
+	double branch_misses;
+};
+
+/**
+ * @brief Print measurement and pass its time to QtTest benchmark result.
+ */
+void report(const measurement &result);
+
+/**
+ * @brief Minimal time of measured loop in nanoseconds.
+ */
+const auto minimal_measurement_time = qint64{100000000};
+
+/**
+ * @brief Measure @p f and report results.
+ * @param operations_per_call number of operations that one call to @p f performs
+ * @param f measured function
+ *
+ * @p f is called once to warm up caches and then repeatedly until minimal_measurement_time
+ * passes. Each result is divided by number of all operations performed.
+ */
+template<typename F>
+void benchmark(std::uint64_t operations_per_call, F f)
+{
+	f();
+
+	hardware_counters counters{};
+	auto timer = QElapsedTimer{};
+	auto calls = std::uint64_t{0};
+	auto allocations = allocation_count();
+
+	counters.start();
+	timer.start();
+	do
+	{
+		f();
+		calls++;
+	} while (timer.nsecsElapsed() < minimal_measurement_time);
+	auto nanoseconds = timer.nsecsElapsed();
+	auto values = counters.stop();
+	allocations = allocation_count() - allocations;
+
+	auto operations = static_cast<double>(calls * operations_per_call);
+	report(measurement{
+		nanoseconds / operations,
+		allocations / operations,
+		counters.available(),
+		values.cycles / operations,
+		values.instructions / operations,
+		values.cache_misses / operations,
+		values.branch_misses / operations
+	});
+}
+
+}}
@@ -0,0 +1,190 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include "graph.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const auto one_shot_repetitions = 7;
+const auto gets_per_thread = 1000000;
+
+/**
+ * @brief Run @p f in @p thread_count threads at once and return wall time in nanoseconds.
+ *
+ * @p f is called with index of thread. Time is measured from start of first thread to end of last one.
+ */
+template<typename F>
+qint64 run_threads(int thread_count, F f)
+{
+	auto threads = std::vector<std::thread>{};
+	auto timer = QElapsedTimer{};
+	timer.start();
+	for (auto t = 0; t < thread_count; t++)
+		threads.emplace_back(f, t);
+	for (auto &&thread : threads)
+		thread.join();
+	return timer.nsecsElapsed();
+}
+
+/**
+ * @brief Run @p setup and @p measured one_shot_repetitions times and return median time of @p measured.
+ */
+template<typename S, typename M>
+qint64 median_one_shot(S setup, M measured)
+{
+	auto samples = std::vector<qint64>{};
+	for (auto i = 0; i < one_shot_repetitions; i++)
+	{
+		auto context = setup();
+		samples.push_back(measured(context));
+	}
+
+	std::sort(std::begin(samples), std::end(samples));
+	return samples[samples.size() / 2];
+}
+
+std::unique_ptr<injeqt::injector> make_injector()
+{
+	return std::unique_ptr<injeqt::injector>{new injeqt::injector{make_graph_modules()}};
+}
+
+std::unique_ptr<injeqt::injector> make_instantiated_injector()
+{
+	auto result = make_injector();
+	for (auto &&t : graph_types())
+		result->get(t);
+	return result;
+}
+
+std::unique_ptr<injeqt::injector> make_frozen_injector()
+{
+	auto result = make_injector();
+	result->freeze();
+	return result;
+}
+
+/**
+ * @brief Measure gets of all graph types from @p injector in @p thread_count threads.
+ */
+void benchmark_steady_state_get(injeqt::injector &injector, int thread_count)
+{
+	auto types = graph_types();
+	auto nanoseconds = median_one_shot([](){ return 0; }, [&](int){
+		return run_threads(thread_count, [&](int t){
+			for (auto i = 0; i < gets_per_thread; i++)
+				injector.get(types[(i + t) % types.size()]);
+		});
+	});
+
+	// each thread did the same work, so this is time of one get as seen by one thread
+	auto per_get = static_cast<double>(nanoseconds) / gets_per_thread;
+	std::printf("    %.1f ns/get per thread, %.1f million gets/s in all threads\n", per_get, thread_count * 1000.0 / per_get);
+	std::fflush(stdout);
+	QTest::setBenchmarkResult(per_get, QTest::WalltimeNanoseconds);
+}
+
+void add_thread_counts()
+{
+	QTest::addColumn<int>("thread_count");
+	for (auto thread_count : {1, 2, 4, 8})
+		QTest::newRow(qPrintable(QString::number(thread_count))) << thread_count;
+}
+
+}
+
+/**
+ * @brief Benchmarks of injector used from many threads at once.
+ *
+ * Each benchmark is run with 1, 2, 4 and 8 threads. With perfect scaling time of steady_state_get
+ * and frozen_get does not change with number of threads and time of first_get drops proportionally.
+ */
+class concurrency_benchmark : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void steady_state_get_data();
+	void steady_state_get();
+	void frozen_get_data();
+	void frozen_get();
+	void first_get_data();
+	void first_get();
+
+};
+
+void concurrency_benchmark::steady_state_get_data()
+{
+	add_thread_counts();
+}
+
+void concurrency_benchmark::steady_state_get()
+{
+	QFETCH(int, thread_count);
+
+	auto injector = make_instantiated_injector();
+	benchmark_steady_state_get(*injector, thread_count);
+}
+
+void concurrency_benchmark::frozen_get_data()
+{
+	add_thread_counts();
+}
+
+void concurrency_benchmark::frozen_get()
+{
+	QFETCH(int, thread_count);
+
+	auto injector = make_frozen_injector();
+	benchmark_steady_state_get(*injector, thread_count);
+}
+
+void concurrency_benchmark::first_get_data()
+{
+	add_thread_counts();
+}
+
+void concurrency_benchmark::first_get()
+{
+	QFETCH(int, thread_count);
+
+	auto types = graph_types();
+	auto nanoseconds = median_one_shot(make_injector, [&](std::unique_ptr<injeqt::injector> &injector){
+		// each thread starts from other part of graph, so threads can create independent subgraphs
+		return run_threads(thread_count, [&](int t){
+			for (auto i = static_cast<std::size_t>(t); i < types.size(); i += thread_count)
+				injector->get(types[i]);
+		});
+	});
+
+	QTest::setBenchmarkResult(nanoseconds / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+QTEST_APPLESS_MAIN(concurrency_benchmark)
+#include "concurrency-benchmark.moc"
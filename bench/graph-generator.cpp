@@ -0,0 +1,303 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file
+ * @brief Generator of synthetic service graphs used by startup benchmarks.
+ *
+ * Usage: graph-generator shape size output-file
+ *
+ * Writes a header with size QObject-based services wired together in one of supported shapes:
+ * * chain - each node depends on next one
+ * * fan-out - each node depends on up to fan_out_width nodes from next level of a tree
+ * * diamond - nodes are layered, each node depends on two neighbour nodes from next layer
+ * * hierarchy - deep superClass() chains, only most derived types are configured and dependencies
+ *   are declared with base types of other chains
+ *
+ * Generated header contains:
+ * * graph_root type that (directly or not) depends on all nodes
+ * * graph_client type that is not configured in any module and can be used with inject_into
+ * * make_graph_modules() function returning modules with all configured types
+ * * wire_graph_by_hand() function that creates and wires the same graph without Injeqt
+ * * graph_types() function returning injeqt::type of each node
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const auto fan_out_width = std::size_t{8};
+const auto diamond_width = std::size_t{16};
+const auto hierarchy_depth = std::size_t{16};
+const auto client_dependencies = std::size_t{8};
+
+struct node
+{
+	std::string name;
+	std::string base;
+	bool configured;
+	std::vector<std::size_t> dependencies;
+};
+
+std::string node_name(std::size_t index)
+{
+	return "node_" + std::to_string(index);
+}
+
+std::vector<node> make_nodes(std::size_t size)
+{
+	auto result = std::vector<node>{};
+	result.reserve(size);
+	for (auto i = std::size_t{0}; i < size; i++)
+		result.push_back(node{node_name(i), "QObject", true, {}});
+	return result;
+}
+
+std::vector<node> make_chain(std::size_t size)
+{
+	auto result = make_nodes(size);
+	for (auto i = std::size_t{0}; i + 1 < size; i++)
+		result[i].dependencies.push_back(i + 1);
+	return result;
+}
+
+std::vector<node> make_fan_out(std::size_t size)
+{
+	auto result = make_nodes(size);
+	for (auto i = std::size_t{0}; i < size; i++)
+		for (auto j = i * fan_out_width + 1; j <= i * fan_out_width + fan_out_width && j < size; j++)
+			result[i].dependencies.push_back(j);
+	return result;
+}
+
+std::vector<node> make_diamond(std::size_t size)
+{
+	auto result = make_nodes(size);
+	for (auto i = std::size_t{0}; i + diamond_width < size; i++)
+	{
+		auto layer_start = (i / diamond_width + 1) * diamond_width;
+		auto left = layer_start + i % diamond_width;
+		auto right = layer_start + (i + 1) % diamond_width;
+		if (left < size)
+			result[i].dependencies.push_back(left);
+		if (right < size && right != left)
+			result[i].dependencies.push_back(right);
+	}
+	return result;
+}
+
+std::vector<node> make_hierarchy(std::size_t size)
+{
+	auto result = make_nodes(size);
+	auto chain_count = (size + hierarchy_depth - 1) / hierarchy_depth;
+	for (auto chain = std::size_t{0}; chain < chain_count; chain++)
+	{
+		auto first = chain * hierarchy_depth;
+		auto last = std::min(first + hierarchy_depth, size) - 1;
+		for (auto i = first + 1; i <= last; i++)
+		{
+			result[i].base = result[i - 1].name;
+			result[i - 1].configured = false;
+		}
+
+		// depend on base type of next chain, it will be resolved to its most derived type
+		if (chain + 1 < chain_count)
+			result[last].dependencies.push_back(first + hierarchy_depth);
+	}
+	return result;
+}
+
+std::vector<std::size_t> roots(const std::vector<node> &nodes)
+{
+	auto referenced = std::vector<bool>(nodes.size(), false);
+	for (auto &&n : nodes)
+		for (auto &&d : n.dependencies)
+			referenced[d] = true;
+
+	// base types of configured nodes are resolved to its most derived types, so these are referenced as well
+	auto result = std::vector<std::size_t>{};
+	for (auto i = std::size_t{0}; i < nodes.size(); i++)
+		if (nodes[i].configured && !referenced[i])
+		{
+			auto base = i;
+			while (base > 0 && nodes[base - 1].name == nodes[base].base)
+				base--;
+			if (base == i || !referenced[base])
+				result.push_back(base);
+		}
+	return result;
+}
+
+std::size_t implementation_of(const std::vector<node> &nodes, std::size_t index)
+{
+	while (!nodes[index].configured)
+		index++;
+	return index;
+}
+
+void write_class(std::ostream &out, const std::string &name, const std::string &base, bool invokable, const std::vector<std::string> &dependencies)
+{
+	out << "class " << name << " : public " << base << "\n{\n\tQ_OBJECT\n\npublic:\n";
+	if (invokable)
+		out << "\tQ_INVOKABLE " << name << "() {}\n";
+	else
+		out << "\t" << name << "() {}\n";
+	out << "\tvirtual ~" << name << "() {}\n\n";
+	out << "\tint init_count() const { return _init_count; }\n\n";
+	out << "public slots:\n";
+	for (auto &&d : dependencies)
+		out << "\tINJEQT_SET void set_" << d << "(" << d << " *x) { _" << d << " = x; }\n";
+	out << "\tINJEQT_INIT void init_" << name << "() { _init_count++; }\n\n";
+	out << "private:\n";
+	out << "\tint _init_count = 0;\n";
+	for (auto &&d : dependencies)
+		out << "\t" << d << " *_" << d << " = nullptr;\n";
+	out << "\n};\n\n";
+}
+
+void write_graph(std::ostream &out, const std::string &shape, const std::vector<node> &nodes)
+{
+	auto root_dependencies = std::vector<std::string>{};
+	for (auto &&r : roots(nodes))
+		root_dependencies.push_back(nodes[r].name);
+
+	auto client_dependency_names = std::vector<std::string>{};
+	for (auto i = std::size_t{0}; i < nodes.size() && client_dependency_names.size() < client_dependencies; i++)
+		if (nodes[i].configured)
+			client_dependency_names.push_back(nodes[i].name);
+
+	out << "// generated by graph-generator, do not edit\n";
+	out << "// shape: " << shape << ", nodes: " << nodes.size() << "\n\n";
+	out << "#pragma once\n\n";
+	out << "#include <injeqt/injeqt.h>\n#include <injeqt/module.h>\n#include <injeqt/type.h>\n\n";
+	out << "#include <QtCore/QObject>\n#include <memory>\n#include <vector>\n\n";
+
+	for (auto &&n : nodes)
+		out << "class " << n.name << ";\n";
+	out << "\n";
+
+	for (auto &&n : nodes)
+	{
+		auto dependencies = std::vector<std::string>{};
+		for (auto &&d : n.dependencies)
+			dependencies.push_back(nodes[d].name);
+		write_class(out, n.name, n.base, n.configured, dependencies);
+	}
+
+	write_class(out, "graph_root", "QObject", true, root_dependencies);
+	write_class(out, "graph_client", "QObject", false, client_dependency_names);
+
+	out << "class graph_module : public injeqt::module\n{\n\npublic:\n\tgraph_module()\n\t{\n";
+	out << "\t\tadd_type<graph_root>();\n";
+	for (auto &&n : nodes)
+		if (n.configured)
+			out << "\t\tadd_type<" << n.name << ">();\n";
+	out << "\t}\n\n\tvirtual ~graph_module() {}\n\n};\n\n";
+
+	out << "inline std::vector<std::unique_ptr<injeqt::module>> make_graph_modules()\n{\n";
+	out << "\tauto modules = std::vector<std::unique_ptr<injeqt::module>>{};\n";
+	out << "\tmodules.emplace_back(std::unique_ptr<injeqt::module>{new graph_module{}});\n";
+	out << "\treturn modules;\n}\n\n";
+
+	out << "inline std::vector<std::unique_ptr<QObject>> wire_graph_by_hand()\n{\n";
+	out << "\tauto objects = std::vector<std::unique_ptr<QObject>>(" << nodes.size() + 1 << ");\n";
+	for (auto i = std::size_t{0}; i < nodes.size(); i++)
+		if (nodes[i].configured)
+			out << "\tobjects[" << i << "].reset(new " << nodes[i].name << "{});\n";
+	out << "\tobjects[" << nodes.size() << "].reset(new graph_root{});\n";
+	auto write_setter = [&](const std::string &name, std::size_t index, std::size_t dependency){
+		auto implementation = implementation_of(nodes, dependency);
+		out << "\tstatic_cast<" << name << " *>(objects[" << index << "].get())->set_" << nodes[dependency].name
+			<< "(static_cast<" << nodes[implementation].name << " *>(objects[" << implementation << "].get()));\n";
+	};
+	for (auto i = std::size_t{0}; i < nodes.size(); i++)
+		if (nodes[i].configured)
+			for (auto &&d : nodes[i].dependencies)
+				write_setter(nodes[i].name, i, d);
+	for (auto &&r : roots(nodes))
+		write_setter("graph_root", nodes.size(), r);
+	for (auto i = std::size_t{0}; i < nodes.size(); i++)
+		if (nodes[i].configured)
+		{
+			// call init methods in the same order as Injeqt does - base classes first
+			auto base = i;
+			while (base > 0 && nodes[base - 1].name == nodes[base].base)
+				base--;
+			for (auto j = base; j <= i; j++)
+				out << "\tstatic_cast<" << nodes[j].name << " *>(objects[" << i << "].get())->init_" << nodes[j].name << "();\n";
+		}
+	out << "\tstatic_cast<graph_root *>(objects[" << nodes.size() << "].get())->init_graph_root();\n";
+	out << "\treturn objects;\n}\n\n";
+
+	out << "inline std::vector<injeqt::type> graph_types()\n{\n";
+	out << "\treturn std::vector<injeqt::type>{\n";
+	for (auto &&n : nodes)
+		out << "\t\tinjeqt::make_type<" << n.name << ">(),\n";
+	out << "\t};\n}\n";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc != 4)
+	{
+		std::cerr << "usage: " << argv[0] << " chain|fan-out|diamond|hierarchy size output-file" << std::endl;
+		return 1;
+	}
+
+	auto shape = std::string{argv[1]};
+	auto size = static_cast<std::size_t>(std::strtoul(argv[2], nullptr, 10));
+	if (size == 0)
+	{
+		std::cerr << "invalid size: " << argv[2] << std::endl;
+		return 1;
+	}
+
+	auto nodes = std::vector<node>{};
+	if (shape == "chain")
+		nodes = make_chain(size);
+	else if (shape == "fan-out")
+		nodes = make_fan_out(size);
+	else if (shape == "diamond")
+		nodes = make_diamond(size);
+	else if (shape == "hierarchy")
+		nodes = make_hierarchy(size);
+	else
+	{
+		std::cerr << "unknown shape: " << shape << std::endl;
+		return 1;
+	}
+
+	std::ofstream out{argv[3]};
+	if (!out)
+	{
+		std::cerr << "cannot write: " << argv[3] << std::endl;
+		return 1;
+	}
+
+	write_graph(out, shape, nodes);
+	return 0;
+}
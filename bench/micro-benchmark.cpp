@@ -0,0 +1,500 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal/action-method.h"
+#include "internal/dependencies.h"
+#include "internal/interfaces-utils.h"
+#include "internal/setter-method.h"
+#include "internal/sorted-unique-vector.h"
+#include "internal/types-by-name.h"
+
+#include "benchmark-utils.h"
+#include "graph.h"
+
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace injeqt::bench;
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class dependency_a : public QObject
+{
+	Q_OBJECT
+};
+
+class dependency_b : public QObject
+{
+	Q_OBJECT
+};
+
+class dependency_c : public QObject
+{
+	Q_OBJECT
+};
+
+class dependency_d : public QObject
+{
+	Q_OBJECT
+};
+
+class service_base : public QObject
+{
+	Q_OBJECT
+
+signals:
+	void changed();
+
+public slots:
+	INJEQT_SET void set_dependency_a(dependency_a *) {}
+	INJEQT_INIT void init_base() {}
+	INJEQT_DONE void done_base() {}
+
+	void update() {}
+	void reset() {}
+
+};
+
+class service : public service_base
+{
+	Q_OBJECT
+
+signals:
+	void started();
+	void stopped();
+	void progress(int);
+
+public slots:
+	INJEQT_SET void set_dependency_b(dependency_b *) {}
+	INJEQT_SET void set_dependency_c(dependency_c *) {}
+	INJEQT_SET void set_dependency_d(dependency_d *) {}
+	INJEQT_INIT void init_service() {}
+	INJEQT_DONE void done_service() {}
+
+	void start() {}
+	void stop() {}
+	void pause() {}
+	void resume() {}
+	void set_name(const QString &) {}
+	void set_size(int) {}
+	void set_enabled(bool) {}
+	void refresh() {}
+	void load() {}
+	void save() {}
+	void clear() {}
+	void process(QObject *) {}
+
+};
+
+class derived_service : public service
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_node_0(node_0 *) {}
+	INJEQT_SET void set_node_1(node_1 *) {}
+	INJEQT_INIT void init_derived() {}
+
+	void reload() {}
+	void validate() {}
+
+};
+
+namespace {
+
+int extract_key(const int &x)
+{
+	return x;
+}
+
+using suv_int = sorted_unique_vector<int, int, extract_key>;
+
+/**
+ * @return even keys from 0 to 2 * (size - 1) in random order
+ *
+ * Odd keys are never present, so these can be used to benchmark failed lookups.
+ */
+std::vector<int> make_keys(int size)
+{
+	auto result = std::vector<int>{};
+	result.reserve(size);
+	for (auto i = 0; i < size; i++)
+		result.push_back(2 * i);
+
+	auto generator = std::mt19937{static_cast<std::mt19937::result_type>(size)};
+	std::shuffle(std::begin(result), std::end(result), generator);
+	return result;
+}
+
+/**
+ * @return found and missing keys in random order
+ */
+std::vector<int> make_lookups(int size)
+{
+	auto result = make_keys(size);
+	auto missing = make_keys(size);
+	for (auto &&k : missing)
+		result.push_back(k + 1);
+
+	auto generator = std::mt19937{static_cast<std::mt19937::result_type>(size)};
+	std::shuffle(std::begin(result), std::end(result), generator);
+	return result;
+}
+
+std::vector<type> service_types()
+{
+	return std::vector<type>{
+		make_type<QObject>(),
+		make_type<service_base>(),
+		make_type<service>(),
+		make_type<derived_service>()
+	};
+}
+
+types_by_name make_known_types(int size)
+{
+	auto all_types = graph_types();
+	all_types.resize(std::min(all_types.size(), static_cast<std::size_t>(size)));
+	for (auto &&t : {make_type<dependency_a>(), make_type<dependency_b>(), make_type<dependency_c>(), make_type<dependency_d>()})
+		all_types.push_back(t);
+	return types_by_name{all_types};
+}
+
+void add_container_sizes()
+{
+	QTest::addColumn<int>("size");
+	for (auto size : {16, 256, 4096, 16384})
+		QTest::newRow(qPrintable(QString::number(size))) << size;
+}
+
+void add_known_types_sizes()
+{
+	QTest::addColumn<int>("size");
+	for (auto size : {10, 100, 1000})
+		QTest::newRow(qPrintable(QString::number(size))) << size;
+}
+
+void add_service_types()
+{
+	QTest::addColumn<int>("index");
+	auto index = 0;
+	for (auto &&t : service_types())
+		QTest::newRow(t.name().c_str()) << index++;
+}
+
+}
+
+class micro_benchmark : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void add_random_data();
+	void add_random();
+	void add_ascending_data();
+	void add_ascending();
+	void add_all_random_data();
+	void add_all_random();
+	void merge_data();
+	void merge();
+	void get_data();
+	void get();
+	void contains_key_data();
+	void contains_key();
+	void match_data();
+	void match();
+	void match_streaming_data();
+	void match_streaming();
+	void extract_interfaces_data();
+	void extract_interfaces();
+	void extract_dependencies_data();
+	void extract_dependencies();
+	void extract_actions_data();
+	void extract_actions();
+	void type_by_pointer_data();
+	void type_by_pointer();
+	void invoke_setter_data();
+	void invoke_setter();
+
+};
+
+void micro_benchmark::add_random_data()
+{
+	add_container_sizes();
+}
+
+void micro_benchmark::add_random()
+{
+	QFETCH(int, size);
+
+	auto keys = make_keys(size);
+	benchmark(keys.size(), [&](){
+		auto v = suv_int{};
+		for (auto &&k : keys)
+			v.add(k);
+	});
+}
+
+void micro_benchmark::add_ascending_data()
+{
+	add_container_sizes();
+}
+
+void micro_benchmark::add_ascending()
+{
+	QFETCH(int, size);
+
+	auto keys = make_keys(size);
+	std::sort(std::begin(keys), std::end(keys));
+	benchmark(keys.size(), [&](){
+		auto v = suv_int{};
+		for (auto &&k : keys)
+			v.add(k);
+	});
+}
+
+void micro_benchmark::add_all_random_data()
+{
+	add_container_sizes();
+}
+
+void micro_benchmark::add_all_random()
+{
+	QFETCH(int, size);
+
+	auto keys = make_keys(size);
+	benchmark(keys.size(), [&](){
+		auto v = suv_int{};
+		v.add_all(keys);
+	});
+}
+
+void micro_benchmark::merge_data()
+{
+	add_container_sizes();
+}
+
+void micro_benchmark::merge()
+{
+	QFETCH(int, size);
+
+	// half of keys overlap, copy of left vector is included in results
+	auto keys = make_keys(size);
+	auto left = suv_int{std::vector<int>(std::begin(keys), std::begin(keys) + size * 3 / 4)};
+	auto right = suv_int{std::vector<int>(std::begin(keys) + size / 4, std::end(keys))};
+	benchmark(1, [&](){
+		auto v = left;
+		v.merge(right);
+	});
+}
+
+void micro_benchmark::get_data()
+{
+	add_container_sizes();
+}
+
+void micro_benchmark::get()
+{
+	QFETCH(int, size);
+
+	auto v = suv_int{make_keys(size)};
+	auto lookups = make_lookups(size);
+	auto found = std::size_t{0};
+	benchmark(lookups.size(), [&](){
+		for (auto &&k : lookups)
+			if (v.get(k) != std::end(v))
+				found++;
+	});
+	QVERIFY(found > 0);
+}
+
+void micro_benchmark::contains_key_data()
+{
+	add_container_sizes();
+}
+
+void micro_benchmark::contains_key()
+{
+	QFETCH(int, size);
+
+	auto v = suv_int{make_keys(size)};
+	auto lookups = make_lookups(size);
+	auto found = std::size_t{0};
+	benchmark(lookups.size(), [&](){
+		for (auto &&k : lookups)
+			if (v.contains_key(k))
+				found++;
+	});
+	QVERIFY(found > 0);
+}
+
+void micro_benchmark::match_data()
+{
+	add_container_sizes();
+}
+
+void micro_benchmark::match()
+{
+	QFETCH(int, size);
+
+	// half of keys are matched, each quarter is unmatched on one side
+	auto keys = make_keys(size);
+	auto left = suv_int{std::vector<int>(std::begin(keys), std::begin(keys) + size * 3 / 4)};
+	auto right = suv_int{std::vector<int>(std::begin(keys) + size / 4, std::end(keys))};
+	auto matched = std::size_t{0};
+	benchmark(1, [&](){
+		auto result = injeqt::internal::match(left, right);
+		matched += result.matched.size();
+	});
+	QVERIFY(matched > 0);
+}
+
+void micro_benchmark::match_streaming_data()
+{
+	add_container_sizes();
+}
+
+void micro_benchmark::match_streaming()
+{
+	QFETCH(int, size);
+
+	auto keys = make_keys(size);
+	auto left = suv_int{std::vector<int>(std::begin(keys), std::begin(keys) + size * 3 / 4)};
+	auto right = suv_int{std::vector<int>(std::begin(keys) + size / 4, std::end(keys))};
+	auto matched = std::size_t{0};
+	benchmark(1, [&](){
+		injeqt::internal::match(left, right, extract_key, extract_key,
+			[&matched](int, int){ matched++; },
+			match_ignore{},
+			match_ignore{});
+	});
+	QVERIFY(matched > 0);
+}
+
+void micro_benchmark::extract_interfaces_data()
+{
+	add_service_types();
+}
+
+void micro_benchmark::extract_interfaces()
+{
+	QFETCH(int, index);
+
+	auto for_type = service_types()[index];
+	auto found = std::size_t{0};
+	benchmark(1, [&](){
+		found += injeqt::internal::extract_interfaces(for_type).size();
+	});
+	QVERIFY(index == 0 || found > 0);
+}
+
+void micro_benchmark::extract_dependencies_data()
+{
+	add_service_types();
+}
+
+void micro_benchmark::extract_dependencies()
+{
+	QFETCH(int, index);
+
+	auto known_types = make_known_types(1000);
+	auto for_type = service_types()[index];
+	auto found = std::size_t{0};
+	benchmark(1, [&](){
+		found += injeqt::internal::extract_dependencies(known_types, for_type).size();
+	});
+	QVERIFY(index == 0 || found > 0);
+}
+
+void micro_benchmark::extract_actions_data()
+{
+	add_service_types();
+}
+
+void micro_benchmark::extract_actions()
+{
+	QFETCH(int, index);
+
+	auto for_type = service_types()[index];
+	auto found = std::size_t{0};
+	benchmark(1, [&](){
+		found += injeqt::internal::extract_actions("INJEQT_INIT", for_type).size();
+	});
+	QVERIFY(index == 0 || found > 0);
+}
+
+void micro_benchmark::type_by_pointer_data()
+{
+	add_known_types_sizes();
+}
+
+void micro_benchmark::type_by_pointer()
+{
+	QFETCH(int, size);
+
+	auto known_types = make_known_types(size);
+	auto lookups = std::vector<std::string>{};
+	for (auto &&t : known_types)
+	{
+		lookups.push_back(t.name() + "*");
+		lookups.push_back(t.name() + "_missing*");
+	}
+
+	auto found = std::size_t{0};
+	benchmark(lookups.size(), [&](){
+		for (auto &&l : lookups)
+			if (!injeqt::internal::type_by_pointer(known_types, l).is_empty())
+				found++;
+	});
+	QVERIFY(found > 0);
+}
+
+void micro_benchmark::invoke_setter_data()
+{
+	QTest::addColumn<bool>("meta_method");
+	QTest::newRow("setter_method") << false;
+	QTest::newRow("QMetaMethod") << true;
+}
+
+void micro_benchmark::invoke_setter()
+{
+	QFETCH(bool, meta_method);
+
+	service on;
+	dependency_b with;
+	auto meta_object = &service::staticMetaObject;
+	auto setter = setter_method{make_type<dependency_b>(), meta_object->method(meta_object->indexOfMethod("set_dependency_b(dependency_b*)"))};
+	if (meta_method)
+		benchmark(1, [&](){
+			setter.meta_method().invoke(&on, Q_ARG(QObject *, &with));
+		});
+	else
+		benchmark(1, [&](){
+			setter.invoke(&on, &with);
+		});
+}
+
+QTEST_APPLESS_MAIN(micro_benchmark)
+#include "micro-benchmark.moc"
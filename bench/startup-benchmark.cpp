@@ -0,0 +1,169 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include "graph.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const auto one_shot_repetitions = 7;
+
+/**
+ * @brief Run @p setup and @p measured one_shot_repetitions times and report median time of @p measured.
+ *
+ * QBENCHMARK repeats its body many times in one context, so it is not suitable for operations
+ * that can be done only once on given object - like constructing, first get or destroying an injector.
+ */
+template<typename S, typename M>
+void benchmark_one_shot(S setup, M measured)
+{
+	auto samples = std::vector<qint64>{};
+	for (auto i = 0; i < one_shot_repetitions; i++)
+	{
+		auto context = setup();
+		auto timer = QElapsedTimer{};
+		timer.start();
+		measured(context);
+		samples.push_back(timer.nsecsElapsed());
+	}
+
+	std::sort(std::begin(samples), std::end(samples));
+	QTest::setBenchmarkResult(samples[samples.size() / 2] / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+struct injector_context
+{
+	std::vector<std::unique_ptr<injeqt::module>> modules;
+	std::unique_ptr<injeqt::injector> injector;
+};
+
+injector_context make_modules()
+{
+	return injector_context{make_graph_modules(), nullptr};
+}
+
+injector_context make_injector()
+{
+	return injector_context{{}, std::unique_ptr<injeqt::injector>{new injeqt::injector{make_graph_modules()}}};
+}
+
+injector_context make_instantiated_injector()
+{
+	auto result = make_injector();
+	result.injector->get<graph_root>();
+	return result;
+}
+
+}
+
+class startup_benchmark : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void construct_injector();
+	void first_get();
+	void instantiate_all();
+	void instantiate_all_in_parallel();
+	void steady_state_get();
+	void inject_into();
+	void destroy_injector();
+	void construct_by_hand();
+	void destroy_by_hand();
+
+};
+
+void startup_benchmark::construct_injector()
+{
+	benchmark_one_shot(make_modules, [](injector_context &c){
+		c.injector.reset(new injeqt::injector{std::move(c.modules)});
+	});
+}
+
+void startup_benchmark::first_get()
+{
+	benchmark_one_shot(make_injector, [](injector_context &c){
+		QVERIFY(c.injector->get<graph_root>());
+	});
+}
+
+void startup_benchmark::instantiate_all()
+{
+	benchmark_one_shot(make_injector, [](injector_context &c){
+		c.injector->instantiate_all();
+	});
+}
+
+void startup_benchmark::instantiate_all_in_parallel()
+{
+	benchmark_one_shot(make_injector, [](injector_context &c){
+		c.injector->instantiate_all_in_parallel();
+	});
+}
+
+void startup_benchmark::steady_state_get()
+{
+	auto c = make_instantiated_injector();
+	QBENCHMARK
+	{
+		c.injector->get<graph_root>();
+	}
+}
+
+void startup_benchmark::inject_into()
+{
+	auto c = make_instantiated_injector();
+	QBENCHMARK
+	{
+		graph_client client{};
+		c.injector->inject_into(&client);
+	}
+}
+
+void startup_benchmark::destroy_injector()
+{
+	benchmark_one_shot(make_instantiated_injector, [](injector_context &c){
+		c.injector.reset();
+	});
+}
+
+void startup_benchmark::construct_by_hand()
+{
+	benchmark_one_shot([](){ return std::vector<std::unique_ptr<QObject>>{}; }, [](std::vector<std::unique_ptr<QObject>> &objects){
+		objects = wire_graph_by_hand();
+	});
+}
+
+void startup_benchmark::destroy_by_hand()
+{
+	benchmark_one_shot(wire_graph_by_hand, [](std::vector<std::unique_ptr<QObject>> &objects){
+		objects.clear();
+	});
+}
+
+QTEST_APPLESS_MAIN(startup_benchmark)
+#include "startup-benchmark.moc"
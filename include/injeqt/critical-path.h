@@ -0,0 +1,78 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes for describing critical paths of instantiating objects.
+ */
+
+namespace injeqt { namespace v1 {
+
+/**
+ * @brief Longest chain of dependencies of one type, weighted with measured times.
+ * @see injector::find_critical_path(const type &)
+ *
+ * Time of type is time of its construction and of its INJEQT_INIT methods, in microseconds. It is
+ * measured only for objects already created by injector - time of other types is 0.
+ *
+ * First of types is root type, each next one is dependency of previous one or type required by
+ * its factory. Even if objects of independent branches of dependencies were created at the same
+ * time, objects on critical path must be created one after another - so only making one of these
+ * faster or not creating it at all can make instantiating root type faster.
+ */
+struct critical_path
+{
+	/**
+	 * @brief Names of types on path, starting with root type.
+	 */
+	std::vector<std::string> types;
+
+	/**
+	 * @brief Times of types on path, in the same order.
+	 */
+	std::vector<std::int64_t> times;
+
+	/**
+	 * @brief Sum of times of types on path.
+	 */
+	std::int64_t path_time;
+
+	/**
+	 * @brief Sum of times of root type and all its dependencies.
+	 */
+	std::int64_t total_time;
+
+	/**
+	 * @brief Time that could be saved if independent branches were created at the same time.
+	 *
+	 * Equal to total_time - path_time.
+	 */
+	std::int64_t parallel_saving;
+};
+
+}}
@@ -18,23 +18,22 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include "resolve-dependencies.h"
+#pragma once
 
-#include "dependency.h"
-#include "implementations.h"
-#include "resolved-dependency.h"
+#include <injeqt/exception/exception.h>
 
-namespace injeqt { namespace internal {
+namespace injeqt { namespace v1 { namespace exception {
 
-resolve_dependencies_result resolve_dependencies(const dependencies &to_resolve, const implementations &resolve_with)
+/**
+ * @brief Exception thrown when frozen injector would have to create new object
+ */
+class INJEQT_API injector_frozen : public exception
 {
-	auto match_result = match(to_resolve, resolve_with, type_from_dependency, type_from_implementation, match_increment_mode::left);
-	auto resolved = std::vector<resolved_dependency>{};
 
-	for (auto &&match : match_result.matched)
-		resolved.emplace_back(match.second, match.first.setter());
+public:
+	explicit injector_frozen(std::string what = std::string{});
+	virtual ~injector_frozen();
 
-	return {dependencies{match_result.unmatched_1}, resolved};
-}
+};
 
-}}
+}}}
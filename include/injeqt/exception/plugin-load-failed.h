@@ -0,0 +1,39 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/exception/exception.h>
+
+namespace injeqt { namespace v1 { namespace exception {
+
+/**
+ * @brief Exception thrown when plugin declared with module::add_plugin() could not be loaded or does not provide declared types
+ */
+class INJEQT_API plugin_load_failed : public exception
+{
+
+public:
+	explicit plugin_load_failed(std::string what = std::string{});
+	virtual ~plugin_load_failed();
+
+};
+
+}}}
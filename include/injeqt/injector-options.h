@@ -0,0 +1,121 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include <string>
+
+/**
+ * @file
+ * @brief Contains options of creating injectors.
+ */
+
+namespace injeqt { namespace v1 {
+
+/**
+ * @brief How much of configuration injector validates in its constructor.
+ * @see injector_options::validation
+ */
+enum class validation_level
+{
+	/**
+	 * @brief Whole configuration is validated in constructor.
+	 */
+	strict,
+
+	/**
+	 * @brief Configuration of each type is validated when its object is first created.
+	 *
+	 * Ambiguous types, types required by factories that are not configured and unresolvable dependencies
+	 * are reported when object of type is created or requested, not in constructor. Invalid setters are
+	 * still reported by constructor, as setters of all types are read there.
+	 */
+	deferred,
+
+	/**
+	 * @brief Configuration is not validated and debug assertions of injector internals are skipped.
+	 *
+	 * Use only for configurations that are known to be valid, for example because the same configuration
+	 * was validated by injector with strict level in tests. Behavior of injector with invalid configuration
+	 * is undefined - objects with unresolvable dependencies can be created without these.
+	 */
+	trusted
+};
+
+/**
+ * @brief Options of creating injector.
+ * @see injector::injector(std::vector<std::unique_ptr<module>>, injector_options)
+ *
+ * Default constructed options give the same injector as constructors without options.
+ * Change selected members of default constructed object:
+ *
+ *     auto options = injeqt::injector_options{};
+ *     options.lazy = true;
+ *     auto injector = injeqt::injector{std::move(modules), options};
+ */
+struct injector_options
+{
+	/**
+	 * @brief Configure types only when they are first needed.
+	 *
+	 * By default injector creates providers, reads dependencies and validates configuration of all types from
+	 * all modules in its constructor. Lazy injector only stores configuration of modules in its constructor. When
+	 * a type is first needed, providers of the type and of all types it depends on are created and validated
+	 * together, so types that are never needed cost almost nothing.
+	 *
+	 * Errors in configuration of a type are reported when it is first needed, not in constructor. Call
+	 * injector::validate_all() in tests to check whole configuration at once.
+	 *
+	 * Interface implemented by many configured types is not available in non-lazy injector. Lazy injector
+	 * returns object of such interface if only one of its implementations was configured yet, for example
+	 * because it was requested by its own type first.
+	 *
+	 * Dependency graph and critical paths are not available for lazy injector, these methods throw
+	 * exception::not_supported.
+	 */
+	bool lazy = false;
+
+	/**
+	 * @brief File used to store validated model of types between runs, empty to disable.
+	 *
+	 * Non-lazy injector computes fingerprint of all configured types - their names, superclasses, tagged
+	 * setters and providers. If this file contains model written for the same fingerprint, the model is used
+	 * without validating configuration again. Otherwise configuration is validated as usual and the model is
+	 * written to this file, so next start of application is faster. Errors of reading and writing the file
+	 * are ignored, so a missing or outdated file only costs the usual validation.
+	 *
+	 * Lazy injector ignores this option, as it validates only parts of configuration, when these are needed.
+	 */
+	std::string model_cache_file;
+
+	/**
+	 * @brief Validation of configuration done by constructor.
+	 *
+	 * Validated model read from model_cache_file is used at each level. Model is written to this file only
+	 * by injectors with strict level, so a cache file written in tests lets injector with trusted level skip
+	 * validation safely. Call injector::validate_all() to validate whole configuration of injector with
+	 * other than strict level.
+	 */
+	validation_level validation = validation_level::strict;
+};
+
+}}
@@ -20,11 +20,17 @@
 
 #pragma once
 
+#include <injeqt/critical-path.h>
 #include <injeqt/injeqt.h>
+#include <injeqt/injector-options.h>
 #include <injeqt/type.h>
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
+#include <QtCore/QFuture>
+#include <QtCore/QFutureInterface>
 #include <QtCore/QObject>
 
 /**
@@ -32,6 +38,8 @@
  * @brief Contains classes and functions for creating injectors.
  */
 
+class QThread;
+
 namespace injeqt { namespace internal {
 	class injector_impl;
 }}
@@ -59,6 +67,18 @@ class module;
  * objects (configured with module::add_ready_object<T>(QObject *) is not managed by injector.
  * For clarity ready objects can be stored in module instances as unique pointers. Injector will own
  * then as it own modules.
+ *
+ * Methods get(), instantiate() and inject_into() can be called from many threads at once. Each object is
+ * created only once and is returned to other threads only after all its setters and INJEQT_INIT methods
+ * were called. Getting already created object does not take any lock. Note that objects are created in
+ * thread that first needed them and Qt thread affinity of objects is not changed, unless their type was
+ * bound to a thread with module::add_type<T>(QThread *) or module::add_factory<T, F>(QThread *).
+ *
+ * INJEQT_INIT methods can return QFuture<void> to do slow work (like opening connections) in background.
+ * INJEQT_INIT methods of objects created together then run at the same time. Injector waits for future
+ * of an object only before calling next INJEQT_INIT method of the same object or INJEQT_INIT methods of
+ * objects that depend on it, and before returning the objects. Asynchronous factories are described
+ * in module::add_factory<T, F>().
  */
 class INJEQT_API injector final
 {
@@ -113,6 +133,29 @@ public:
 	 */
 	explicit injector(std::vector<injector *> super_injectors, std::vector<std::unique_ptr<module>> modules);
 
+	/**
+	 * @brief Create new injector from provided modules with given @p options.
+	 * @param modules list of modules
+	 * @param options options of new injector
+	 * @see injector(std::vector<std::unique_ptr<module>>)
+	 * @see injector_options
+	 *
+	 * With default constructed @p options works like injector(std::vector<std::unique_ptr<module>>). If
+	 * injector_options::lazy is set, configuration of modules is not validated and no exceptions listed for
+	 * other constructors are thrown here. These are thrown by the first call that needs invalid type instead.
+	 */
+	injector(std::vector<std::unique_ptr<module>> modules, injector_options options);
+
+	/**
+	 * @brief Create new injector from provided modules with set of parent injectors and given @p options.
+	 * @param super_injectors list of injectors providing types for this one to use
+	 * @param modules list of modules
+	 * @param options options of new injector
+	 * @see injector(std::vector<injector *>, std::vector<std::unique_ptr<module>>)
+	 * @see injector(std::vector<std::unique_ptr<module>>, injector_options)
+	 */
+	injector(std::vector<injector *> super_injectors, std::vector<std::unique_ptr<module>> modules, injector_options options);
+
 	injector(injector &&x);
 	~injector();
 
@@ -153,6 +196,10 @@ public:
 	 * create itself all required factories with the same alghoritm). After U with all its dependencies
 	 * is created all dependency setters are called with proper arguments. Then U object is added to cache
 	 * and is itself returned.
+	 *
+	 * Current thread is blocked until all new objects are created and initialized, including objects of
+	 * types bound to other thread in module - these are created in their thread while current thread waits.
+	 * Use get_async<T>() to create objects without blocking current thread.
 	 */
 	template<typename T>
 	T * get()
@@ -160,6 +207,70 @@ public:
 		return qobject_cast<T *>(get(make_type<T>()));
 	}
 
+	/**
+	 * @brief Instantiates object of given type T without blocking current thread.
+	 * @tparam T type of object to instantiate
+	 * @param object_thread thread that new objects will live in, nullptr means current thread
+	 * @throw qobject_type if T is QObject
+	 * @return future that finishes when object and all its dependencies are created
+	 *
+	 * Works like instantiate<T>(), but objects are created in a thread of QThreadPool::globalInstance().
+	 * Their setters and INJEQT_INIT methods are also called there. Then all new objects are moved to
+	 * @p object_thread and future finishes. Objects of types bound to thread in module are created in
+	 * that thread, as usual. Objects that INJEQT_INIT methods get from injector are not moved.
+	 * INJEQT_DONE methods and destructors of moved objects are called in @p object_thread if it is still
+	 * running when injector is destroyed.
+	 *
+	 * Exceptions that instantiate<T>() would throw are thrown by QFuture::waitForFinished() and
+	 * QFuture::result() of returned future. Injector must not be destroyed before returned future finishes.
+	 */
+	template<typename T>
+	QFuture<void> instantiate_async(QThread *object_thread = nullptr)
+	{
+		return instantiate_async(make_type<T>(), object_thread);
+	}
+
+	/**
+	 * @brief Returns future of pointer to object of given type T without blocking current thread.
+	 * @tparam T type of object to return
+	 * @param object_thread thread that new objects will live in, nullptr means current thread
+	 * @throw qobject_type if T is QObject
+	 * @return future of object of type T
+	 *
+	 * Works like get<T>(), but objects are created in a thread of QThreadPool::globalInstance() and then
+	 * moved to @p object_thread - see instantiate_async<T>(). Future finishes when all INJEQT_INIT methods
+	 * of new objects were called. Other threads can not get these objects from injector before that.
+	 *
+	 * Example usage:
+	 *
+	 *     auto watcher = new QFutureWatcher<indexer *>{};
+	 *     connect(watcher, &QFutureWatcher<indexer *>::finished, [watcher](){
+	 *         watcher->result()->start();
+	 *         watcher->deleteLater();
+	 *     });
+	 *     watcher->setFuture(injector.get_async<indexer>());
+	 */
+	template<typename T>
+	QFuture<T *> get_async(QThread *object_thread = nullptr)
+	{
+		auto future = QFutureInterface<T *>{};
+		get_async(make_type<T>(), object_thread, future, [future](QObject *object) mutable {
+			future.reportResult(qobject_cast<T *>(object));
+		});
+		return future.future();
+	}
+
+	/**
+	 * @brief Instantiate object of type T in background from event loop of current thread.
+	 * @tparam T type of object to instantiate
+	 * @see warm_up(const std::vector<type> &)
+	 */
+	template<typename T>
+	void warm_up()
+	{
+		warm_up(std::vector<type>{make_type<T>()});
+	}
+
 	/**
 	 * @brief Returns all objects with given @p type_role.
 	 * @throw instantiation_failed if instantiation of one of found types failed
@@ -182,6 +293,182 @@ public:
 	 */
 	void instantiate_all_with_type_role(const std::string &type_role);
 
+	/**
+	 * @brief Instantiate objects of all configured types.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 * @throw injector_frozen if injector is frozen and some of types were not instantiated before freeze
+	 *
+	 * All objects that are not yet instantiated are created together, so setters and INJEQT_INIT methods
+	 * of each of them are called only once all of them are constructed. Objects of types required by
+	 * factories are instantiated first.
+	 */
+	void instantiate_all();
+
+	/**
+	 * @brief Instantiate objects of all configured types using all cores.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 * @throw injector_frozen if injector is frozen and some of types were not instantiated before freeze
+	 *
+	 * Works like instantiate_all(), but objects created by Q_INVOKABLE default constructors are constructed
+	 * at the same time by current thread and threads of QThreadPool::globalInstance(). Each group of objects
+	 * that have to be ready before next factory can be called is constructed in parallel, then its setters and
+	 * INJEQT_INIT methods are called in thread of each object, as in instantiate_all(). Objects constructed in
+	 * pool threads are moved to current thread, objects of types bound to thread are constructed in that thread.
+	 *
+	 * Default constructors of all configured types must be safe to call at the same time.
+	 */
+	void instantiate_all_in_parallel();
+
+	/**
+	 * @brief Instantiate objects of @p types in background from event loop of current thread.
+	 * @param types types of objects to instantiate
+	 * @throw empty_type if any of @p types is empty
+	 * @throw qobject_type if any of @p types represents QObject
+	 * @throw unknown_type if any of @p types was not configured in injector
+	 *
+	 * Types are queued and this method returns immediately. Event loop of current thread then instantiates
+	 * queued types with their dependencies, one object at a time, for at most 4 milliseconds per iteration
+	 * before it processes other events - so application stays responsive. Types with higher priority assigned
+	 * with INJEQT_WARM_UP_PRIORITY macro are instantiated first:
+	 *
+	 *     class settings_window : public QObject
+	 *     {
+	 *         Q_OBJECT
+	 *         INJEQT_WARM_UP_PRIORITY(10)
+	 *     };
+	 *
+	 * Calling get() for queued type instantiates it right away, as always, so it is not waited for. Errors are
+	 * not reported by warm up - next get() of failed type reports them.
+	 *
+	 * All calls to warm up methods must be done from the same thread, which must run event loop.
+	 */
+	void warm_up(const std::vector<type> &types);
+
+	/**
+	 * @brief Instantiate all objects with given @p type_role in background from event loop of current thread.
+	 * @see warm_up(const std::vector<type> &)
+	 */
+	void warm_up_with_type_role(const std::string &type_role);
+
+	/**
+	 * @brief Start recording order of first access to each type.
+	 *
+	 * After this call first get(), instantiate(), get_async() and instantiate_async() call for each type
+	 * is recorded with its time and duration. Objects created by injector on its own - dependencies,
+	 * factories, warm up - are not recorded. Calling this method again clears all records.
+	 *
+	 * Save recording with save_access_recording(const std::string &) and pass the file to
+	 * replay_access_recording(const std::string &) on next start of application, so objects are
+	 * created before application needs them.
+	 */
+	void start_access_recording();
+
+	/**
+	 * @brief Save accesses recorded since start_access_recording() to file @p file_name.
+	 * @param file_name name of file to write
+	 * @return false if file could not be written
+	 *
+	 * Each access is saved as one line of text with time since start of recording in microseconds,
+	 * duration of call in microseconds and name of type.
+	 */
+	bool save_access_recording(const std::string &file_name) const;
+
+	/**
+	 * @brief Instantiate types from file @p file_name in background, in recorded order.
+	 * @param file_name name of file saved by save_access_recording(const std::string &)
+	 * @return false if file could not be read or is not valid
+	 * @see warm_up(const std::vector<type> &)
+	 *
+	 * Types are queued for warm up before all other types. Types that are not configured in this
+	 * injector anymore are skipped.
+	 */
+	bool replay_access_recording(const std::string &file_name);
+
+	/**
+	 * @brief Save graph of configured types to file @p file_name in Graphviz DOT format.
+	 * @param file_name name of file to write
+	 * @return false if file could not be written
+	 * @throw not_supported if injector is lazy
+	 *
+	 * Graph has one node for each configured implementation type, labeled with way in which injector gets
+	 * its object, interfaces it is available under and its type roles. Objects already created by injector
+	 * are filled and labeled with time of construction and time of INJEQT_INIT methods in microseconds.
+	 * Edges go from type to its dependencies: solid ones for INJEQT_SET methods, dashed ones for objects
+	 * with factory methods and dotted ones for parent injectors.
+	 *
+	 * Call it after application started to see which types were created on startup and what they cost.
+	 */
+	bool save_dependency_graph_dot(const std::string &file_name) const;
+
+	/**
+	 * @brief Save graph of configured types to file @p file_name in JSON format.
+	 * @param file_name name of file to write
+	 * @return false if file could not be written
+	 * @throw not_supported if injector is lazy
+	 * @see save_dependency_graph_dot(const std::string &)
+	 *
+	 * Saved object has "nodes" array with "name", "kind", "interfaces", "type_roles", "instantiated",
+	 * "construction_time" and "init_time" members and "edges" array with "from", "to", "kind" (one of
+	 * "setter", "factory" and "parent_injector") and "label" members. Times that were not measured
+	 * are null.
+	 */
+	bool save_dependency_graph_json(const std::string &file_name) const;
+
+	/**
+	 * @brief Return longest chain of dependencies of type T weighted with measured times.
+	 * @tparam T type to find critical path of
+	 * @throw qobject_type if T represents QObject
+	 * @throw unknown_type if T was not configured in injector
+	 * @throw not_supported if injector is lazy
+	 * @see find_critical_path(const type &)
+	 */
+	template<typename T>
+	critical_path find_critical_path() const
+	{
+		return find_critical_path(make_type<T>());
+	}
+
+	/**
+	 * @brief Return longest chain of dependencies of @p interface_type weighted with measured times.
+	 * @param interface_type type to find critical path of
+	 * @throw empty_type if interface_type is empty
+	 * @throw qobject_type if interface_type represents QObject
+	 * @throw unknown_type if @p interface_type was not configured in injector
+	 * @throw not_supported if injector is lazy
+	 *
+	 * Each type is weighted with measured time of its construction and its INJEQT_INIT methods. Only objects
+	 * already created by injector have their times measured, so call it after object of @p interface_type was
+	 * created. Types with factories are followed by their factory types.
+	 *
+	 * Objects on critical path must be created one after another, so making one of them faster or not
+	 * creating it on startup is the only way to get object of @p interface_type faster. Time in critical_path::parallel_saving
+	 * is time of other dependencies, that could be created at the same time.
+	 */
+	critical_path find_critical_path(const type &interface_type) const;
+
+	/**
+	 * @brief Return critical paths of all root types.
+	 * @throw not_supported if injector is lazy
+	 * @see find_critical_path(const type &)
+	 *
+	 * Root types are types of created objects that are not dependencies of other created objects - usually these
+	 * are types that application got with get(). Paths are sorted by critical_path::path_time, the longest first.
+	 * Objects that only depend on each other in a cycle have no root type, so their paths are not returned.
+	 */
+	std::vector<critical_path> find_critical_paths() const;
+
+	/**
+	 * @brief Return text report of find_critical_paths().
+	 * @throw not_supported if injector is lazy
+	 *
+	 * Each path is reported with its root type, path time, total time, time that could be saved by creating
+	 * independent objects at the same time and the most expensive type on path. Then all types on path are
+	 * listed with their times, one in a line. All times are in microseconds. Report can be printed to console:
+	 *
+	 *     std::cout << injector.critical_path_report();
+	 */
+	std::string critical_path_report() const;
+
 	/**
 	 * @brief Returns pointer to object of given type interface_type.
 	 * @param interface_type type of object to return
@@ -194,6 +481,28 @@ public:
 	 */
 	QObject * get(const type &interface_type);
 
+	/**
+	 * @brief Instantiates object of given type interface_type without blocking current thread.
+	 * @param interface_type type of object to instantiate
+	 * @param object_thread thread that new objects will live in, nullptr means current thread
+	 * @throw empty_type if interface_type is empty
+	 * @throw qobject_type if interface_type represents QObject
+	 *
+	 * @see QFuture<void> instantiate_async<T>(QThread *)
+	 */
+	QFuture<void> instantiate_async(const type &interface_type, QThread *object_thread = nullptr);
+
+	/**
+	 * @brief Returns future of pointer to object of given type interface_type without blocking current thread.
+	 * @param interface_type type of object to return
+	 * @param object_thread thread that new objects will live in, nullptr means current thread
+	 * @throw empty_type if interface_type is empty
+	 * @throw qobject_type if interface_type represents QObject
+	 *
+	 * @see QFuture<T *> get_async<T>(QThread *)
+	 */
+	QFuture<QObject *> get_async(const type &interface_type, QThread *object_thread = nullptr);
+
 	/**
 	 * @brief Inject dependencies into @p object.
 	 * @param object object to inject dependencies into.
@@ -210,9 +519,82 @@ public:
 	 */
 	void inject_into(QObject *object);
 
+	/**
+	 * @brief Inject dependencies into all @p objects.
+	 * @param objects objects to inject dependencies into.
+	 * @throw invalid_setter if any tagged setter has parameter that is not a QObject-derived pointer
+	 * @throw invalid_setter if any tagged setter has parameter that is a QObject pointer
+	 * @throw invalid_setter if any tagged setter has parameter that is a QObject-derived pointer of not configured type
+	 * @throw invalid_setter if any tagged setter has other number of parameters than one
+	 * @pre all objects are not nullptr
+	 *
+	 * Works like calling inject_into(QObject *) for each object, but dependencies missing for all objects are
+	 * instantiated at once before any setter is called.
+	 */
+	void inject_into(const std::vector<QObject *> &objects);
+
+	/**
+	 * @brief Instantiate all configured types and make injector immutable.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 *
+	 * After this call injector does not create any new objects. get() and get_all_with_type_role()
+	 * only read immutable tables, so these can be called from any number of threads without any
+	 * synchronization. inject_into() only calls setters with already created objects.
+	 *
+	 * Any call that would have to create new object throws injector_frozen.
+	 */
+	void freeze();
+
+	/**
+	 * @brief Instantiate @p root_types with all their dependencies and make injector immutable.
+	 * @param root_types types to instantiate before freezing
+	 * @throw qobject_type if any of @p root_types represents QObject
+	 * @throw unknown_type if any of @p root_types was not configured in injector
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 *
+	 * Works like freeze(), but only objects required by @p root_types are created. Getting other
+	 * types from frozen injector throws injector_frozen.
+	 */
+	void freeze(const std::vector<type> &root_types);
+
+	/**
+	 * @return true if freeze() was called on this injector
+	 */
+	bool is_frozen() const;
+
+	/**
+	 * @brief Validate configuration of all types.
+	 * @throw ambiguous_types if one or more types in modules is ambiguous
+	 * @throw unresolvable_dependencies if a type with unresolvable dependency is found in modules
+	 * @throw dependency_on_self when type depends on self
+	 * @throw dependency_on_subtype when type depends on own supertype
+	 * @throw dependency_on_subtype when type depends on own subtype
+	 * @throw invalid_setter if any tagged setter has parameter that is not a QObject-derived pointer
+	 * @throw invalid_setter if any tagged setter has parameter that is a QObject pointer
+	 * @throw invalid_setter if any tagged setter has other number of parameters than one
+	 * @see injector_options::lazy
+	 * @see injector_options::validation
+	 *
+	 * Lazy injector and injector with other than strict validation level validate configuration of types only
+	 * when these are first needed, if ever. Call this method in tests to get the same exceptions that non-lazy
+	 * injector with strict validation level would throw from constructor. No object is created and state of
+	 * injector does not change. Does nothing for such injector, as its whole configuration is validated in
+	 * constructor.
+	 */
+	void validate_all() const;
+
 private:
 	std::unique_ptr<injeqt::internal::injector_impl> _pimpl;
 
+	/**
+	 * @brief Start creating object of type @p interface_type in other thread.
+	 * @param interface_type type of object to return
+	 * @param object_thread thread that new objects will live in, nullptr means current thread
+	 * @param future future to report start, exception and finish to
+	 * @param report_result function that reports created object to @p future
+	 */
+	void get_async(const type &interface_type, QThread *object_thread, QFutureInterfaceBase future, std::function<void(QObject *)> report_result);
+
 };
 
 }}
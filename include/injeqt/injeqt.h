@@ -39,6 +39,10 @@
 #define INJEQT_TYPE_ROLE_CLASSINFO_NAME "injeqt.type-role"
 #define INJEQT_TYPE_ROLE(N) Q_CLASSINFO(INJEQT_TYPE_ROLE_CLASSINFO_NAME, N)
 
+// types with higher priority are instantiated first by injector::warm_up, default priority is 0
+#define INJEQT_WARM_UP_PRIORITY_CLASSINFO_NAME "injeqt.warm-up-priority"
+#define INJEQT_WARM_UP_PRIORITY(N) Q_CLASSINFO(INJEQT_WARM_UP_PRIORITY_CLASSINFO_NAME, #N)
+
 namespace injeqt {
 	namespace v1 { }
 	using namespace v1;
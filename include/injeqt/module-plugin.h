@@ -0,0 +1,75 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/module.h>
+
+#include <memory>
+#include <QtCore/QtPlugin>
+
+/**
+ * @file
+ * @brief Contains interface of Qt plugins providing modules.
+ */
+
+namespace injeqt { namespace v1 {
+
+/**
+ * @brief Interface of Qt plugin that provides a module.
+ * @see module::add_plugin(std::string, std::vector<std::string>)
+ *
+ * Plugin is loaded with QPluginLoader when injector needs one of its types, so plugin class must be
+ * declared with Q_PLUGIN_METADATA using INJEQT_MODULE_PLUGIN_IID and with Q_INTERFACES:
+ *
+ *     class spellchecker_plugin : public QObject, public injeqt::module_plugin
+ *     {
+ *         Q_OBJECT
+ *         Q_PLUGIN_METADATA(IID INJEQT_MODULE_PLUGIN_IID)
+ *         Q_INTERFACES(injeqt::v1::module_plugin)
+ *
+ *     public:
+ *         virtual std::unique_ptr<injeqt::module> create_module() override
+ *         {
+ *             return std::unique_ptr<injeqt::module>{new spellchecker_module{}};
+ *         }
+ *     };
+ */
+class module_plugin
+{
+
+public:
+	virtual ~module_plugin() {}
+
+	/**
+	 * @return new module with types of plugin, must not be nullptr
+	 *
+	 * Called once for each injector that needs types of plugin.
+	 */
+	virtual std::unique_ptr<module> create_module() = 0;
+
+};
+
+}}
+
+#define INJEQT_MODULE_PLUGIN_IID "org.injeqt.module-plugin/1.0"
+
+Q_DECLARE_INTERFACE(injeqt::v1::module_plugin, INJEQT_MODULE_PLUGIN_IID)
@@ -23,20 +23,59 @@
 #include <injeqt/injeqt.h>
 #include <injeqt/type.h>
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
+#include <QtCore/QFuture>
 
 /**
  * @file
  * @brief Contains classes and functions for creating modules.
  */
 
+class QObject;
+class QThread;
+
 namespace injeqt { namespace internal {
 	class injector_impl;
+	class lazy_configuration;
 	class module_impl;
 }}
 
 namespace injeqt { namespace v1 {
 
+/**
+ * @brief Function that reads object created by asynchronous factory method.
+ *
+ * Factory method that returns QFuture<T *> returns it into memory that only code knowing T can allocate
+ * and read. Such function calls @p invoke with pointer to QFuture<T *> that factory method returns into
+ * and returns function that waits for that future and returns created object, or nullptr if future has no
+ * result.
+ *
+ * Function of this type is created by module::add_factory<T, F>() for type T, so users do not need to
+ * write one.
+ *
+ * @see read_factory_future<T>()
+ */
+using factory_future_reader = std::function<QObject *()> (*)(const std::function<void(void *)> &invoke);
+
+/**
+ * @brief Read QFuture<T *> returned by asynchronous factory method through its own type.
+ * @see factory_future_reader
+ */
+template<typename T>
+std::function<QObject *()> read_factory_future(const std::function<void(void *)> &invoke)
+{
+	auto future = std::make_shared<QFuture<T *>>();
+	invoke(future.get());
+	return [future]() -> QObject * {
+		// rethrows exception reported by factory
+		future->waitForFinished();
+		return future->resultCount() > 0 ? future->result() : nullptr;
+	};
+}
+
 /**
  * @brief Module represents set of types and objects that can be injected and that can use injections.
  *
@@ -52,7 +91,12 @@ namespace injeqt { namespace v1 {
  * is only required for a group of modules passed into injector.
  *
  * Module configuration is done by calling any of add_* method. Currently implemnted are:
- * add_ready_object, add_type, add_factory.
+ * add_ready_object, add_type, add_factory, add_plugin.
+ *
+ * Types added with add_type and add_factory can be bound to a QThread. Objects of these
+ * types will live in that thread and are initialized there. Thread that requested them with
+ * injector::get() still waits until they are initialized - use injector::get_async() to
+ * request them without blocking that thread.
  */
 class INJEQT_API module
 {
@@ -164,6 +208,57 @@ protected:
 		add_type(make_type<T>());
 	}
 
+	/**
+	 * @brief Add type that can be default-constructed in given thread to module.
+	 * @tparam T type added to module (must be inherited from QObject).
+	 * @param thread thread that object of type T will live in
+	 * @throw qobject_type when passed type @p T represents QObject
+	 * @throw default_constructor_not_found is @p T does not have default constructor tagged with Q_INVOKABLE
+	 *
+	 * Works like add_type<T>(), but default constructor, INJEQT_SET setters and INJEQT_INIT methods
+	 * of T are called in @p thread, so new object lives in that thread. INJEQT_DONE methods and
+	 * destructor of T are also called in @p thread if it is still running when injector is destroyed.
+	 *
+	 * Thread that requests object from injector waits until all these methods return. It does not
+	 * process its events while waiting. Thread @p thread must run its event loop (as QThread::run()
+	 * does by default) when object is requested and must outlive injector. Its INJEQT_INIT methods
+	 * must not request not yet created objects from injector, as thread that requested object of T
+	 * holds injector locks until they return.
+	 *
+	 * Use injector::get_async<T>() or injector::instantiate_async<T>() to request object of T without
+	 * blocking current thread. Then a thread of QThreadPool waits for @p thread instead.
+	 *
+	 * Example usage:
+	 *
+	 *     class indexer : public QObject
+	 *     {
+	 *         Q_OBJECT
+	 *     public:
+	 *         Q_INVOKABLE indexer() {}
+	 *     private slots:
+	 *         INJEQT_INIT void init() { build_index(); }
+	 *     };
+	 *
+	 *     class indexer_module : public module
+	 *     {
+	 *         indexer_module(QThread *indexer_thread)
+	 *         {
+	 *              add_type<indexer>(indexer_thread);
+	 *         }
+	 *     };
+	 *
+	 * When injector object is created with that module, build_index() is called in indexer_thread
+	 * and returned object lives in that thread:
+	 *
+	 *     auto o = injector.get<indexer>();
+	 *     assert(o->thread() == indexer_thread);
+	 */
+	template<typename T>
+	void add_type(QThread *thread)
+	{
+		add_type(make_type<T>(), thread);
+	}
+
 	/**
 	 * @brief Add type that can be created by factory to module.
 	 * @tparam T type added to module (must be inherited from QObject).
@@ -225,15 +320,88 @@ protected:
 	 *
 	 *     auto o1 = injector.get<injectable>();
 	 *     auto o2 = injector.get<injectable>();
+	 *
+	 * Factory method can also return QFuture<T *> (for example from QtConcurrent::run) instead
+	 * of T *. Future of pointer to type derived from T is not accepted. When many objects are created at once, injector calls all their factory methods
+	 * before waiting for any of returned futures, so slow factories run at the same time.
+	 * Object created in other thread lives in that thread, so factory should move it to thread
+	 * that requested it:
+	 *
+	 *     class injectable_factory : public QObject
+	 *     {
+	 *         Q_OBJECT
+	 *     public:
+	 *         Q_INVOKABLE injectable_factory() {}
+	 *         Q_INVOKABLE QFuture<injectable *> create()
+	 *         {
+	 *             auto thread = QThread::currentThread();
+	 *             return QtConcurrent::run([thread]{
+	 *                 auto result = new injectable{2};
+	 *                 result->moveToThread(thread);
+	 *                 return result;
+	 *             });
+	 *         }
+	 *     };
 	 */
 	template<typename T, typename F>
 	void add_factory()
 	{
-		add_factory(make_type<T>(), make_type<F>());
+		add_factory(make_type<T>(), make_type<F>(), &read_factory_future<T>);
 	}
 
+	/**
+	 * @brief Add type that can be created by factory and moved to given thread to module.
+	 * @tparam T type added to module (must be inherited from QObject).
+	 * @tparam F factory type (must be inherited from QObject).
+	 * @param thread thread that object of type T will live in
+	 * @throw qobject_type when passed type @p T represents QObject
+	 * @throw qobject_type when passed type @p F represents QObject
+	 * @throw unique_factory_method_not_found when type F does not have unique factory method for T
+	 *
+	 * Works like add_factory<T, F>(), but object returned by factory method is moved to @p thread
+	 * with QObject::moveToThread. Factory method is still called in thread that requested object,
+	 * so returned object must not have a parent. Destructor of T is called in @p thread if it is still
+	 * running when injector is destroyed. Thread @p thread must outlive injector.
+	 */
+	template<typename T, typename F>
+	void add_factory(QThread *thread)
+	{
+		add_factory(make_type<T>(), make_type<F>(), &read_factory_future<T>, thread);
+	}
+
+	/**
+	 * @brief Add types implemented in Qt plugin that is loaded only when needed.
+	 * @param file_name file name of plugin, as accepted by QPluginLoader
+	 * @param type_names names of types and interfaces provided by module of plugin
+	 * @see module_plugin
+	 * @see plugin_module
+	 *
+	 * Plugin must implement module_plugin. Its module is created with module_plugin::create_module()
+	 * and its types are added to injector as if module was passed to injector constructor directly.
+	 *
+	 * Lazy injector (see injector_options::lazy) loads plugin when any of @p type_names is first needed
+	 * and throws plugin_load_failed if plugin could not be loaded or does not provide all of @p type_names.
+	 * Types of plugins that were not loaded yet are not found by type role and are not available to injectors
+	 * created with lazy injector as parent. Other injectors load all plugins in constructor. Plugins are never
+	 * unloaded, as objects created by injector use their code.
+	 *
+	 * Example usage:
+	 *
+	 *     class app_module : public module
+	 *     {
+	 *     public:
+	 *         app_module()
+	 *         {
+	 *             add_type<main_window>();
+	 *             add_plugin("plugins/spellchecker", {"spellchecker"});
+	 *         }
+	 *     };
+	 */
+	void add_plugin(std::string file_name, std::vector<std::string> type_names);
+
 private:
 	friend class ::injeqt::internal::injector_impl;
+	friend class ::injeqt::internal::lazy_configuration;
 	std::unique_ptr<injeqt::internal::module_impl> _pimpl;
 
 	/**
@@ -249,12 +417,38 @@ private:
 	void add_type(type t);
 
 	/**
-	 * @see add_factory<T, F>();
+	 * @see add_type<T>(QThread *);
+	 * @pre !t.is_empty()
+	 */
+	void add_type(type t, QThread *thread);
+
+	/**
+	 * @brief Add factory that cannot return QFuture.
+	 *
+	 * Kept for binary compatibility with modules compiled against earlier versions of Injeqt,
+	 * add_factory<T, F>() now calls add_factory(type, type, factory_future_reader).
+	 *
 	 * @pre !t.is_empty()
 	 * @pre !f.is_empty()
 	 */
 	void add_factory(type t, type f);
 
+	/**
+	 * @see add_factory<T, F>();
+	 * @pre !t.is_empty()
+	 * @pre !f.is_empty()
+	 * @pre read_future != nullptr
+	 */
+	void add_factory(type t, type f, factory_future_reader read_future);
+
+	/**
+	 * @see add_factory<T, F>(QThread *);
+	 * @pre !t.is_empty()
+	 * @pre !f.is_empty()
+	 * @pre read_future != nullptr
+	 */
+	void add_factory(type t, type f, factory_future_reader read_future, QThread *thread);
+
 };
 
 }}
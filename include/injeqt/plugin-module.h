@@ -0,0 +1,60 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/module.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains module that only declares types of a plugin.
+ */
+
+namespace injeqt { namespace v1 {
+
+/**
+ * @brief Module with types implemented in one Qt plugin.
+ * @see module::add_plugin(std::string, std::vector<std::string>)
+ *
+ * Creating this module does not load plugin, so modules of many plugins can be passed to lazy
+ * injector and only plugins that provide needed types are loaded:
+ *
+ *     auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+ *     modules.emplace_back(new injeqt::plugin_module{"plugins/spellchecker", {"spellchecker"}});
+ */
+class INJEQT_API plugin_module final : public module
+{
+
+public:
+	/**
+	 * @brief Create module with types named @p type_names implemented in plugin @p file_name.
+	 * @param file_name file name of plugin, as accepted by QPluginLoader
+	 * @param type_names names of types and interfaces provided by module of plugin
+	 */
+	plugin_module(std::string file_name, std::vector<std::string> type_names);
+	virtual ~plugin_module();
+
+};
+
+}}
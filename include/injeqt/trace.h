@@ -0,0 +1,62 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include <string>
+
+/**
+ * @file
+ * @brief Contains functions for tracing work done by injectors.
+ */
+
+namespace injeqt { namespace v1 {
+
+/**
+ * @brief Start tracing work of all injectors in process.
+ *
+ * Previously traced events are discarded. After this call spans are recorded for:
+ * phases of creating injector (building known types, creating providers, building
+ * types model, validating required types, creating plans), creation of each object,
+ * each INJEQT_SET method call, each INJEQT_INIT and INJEQT_DONE method call.
+ * Each span keeps id of thread it was recorded on.
+ *
+ * When tracing is not started its cost is one atomic load per span.
+ */
+INJEQT_API void start_tracing();
+
+/**
+ * @brief Stop tracing. Traced events are kept until next start_tracing() call.
+ */
+INJEQT_API void stop_tracing();
+
+/**
+ * @brief Save traced events to @p file_name.
+ * @return false if file could not be written
+ *
+ * Events are saved in trace event JSON format, that can be loaded in chrome://tracing or
+ * Perfetto. Spans are nested by time on each thread. Can be called when tracing is
+ * started or stopped.
+ */
+INJEQT_API bool save_trace(const std::string &file_name);
+
+}}
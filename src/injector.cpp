@@ -29,6 +29,7 @@
 #include "module-impl.h"
 #include "provider.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace injeqt::internal;
@@ -51,6 +52,17 @@ injector::injector(std::vector<injector *> super_injectors, std::vector<std::uni
 	_pimpl.reset(new ::injeqt::internal::injector_impl{transform(super_injectors, extract_impl), std::move(modules)});
 }
 
+injector::injector(std::vector<std::unique_ptr<module>> modules, injector_options options) :
+	_pimpl{new ::injeqt::internal::injector_impl{std::move(modules), options}}
+{
+}
+
+injector::injector(std::vector<injector *> super_injectors, std::vector<std::unique_ptr<module>> modules, injector_options options)
+{
+	auto extract_impl = std::function<injector_impl*(injector *)>([](injector *i){ return i->_pimpl.get(); });
+	_pimpl.reset(new ::injeqt::internal::injector_impl{transform(super_injectors, extract_impl), std::move(modules), options});
+}
+
 injector::injector(injector &&x) :
 	_pimpl{std::move(x._pimpl)}
 {
@@ -81,6 +93,16 @@ void injector::instantiate_all_with_type_role(const std::string &type_role)
 	_pimpl->instantiate_all_with_type_role(type_role);
 }
 
+void injector::instantiate_all()
+{
+	_pimpl->instantiate_all();
+}
+
+void injector::instantiate_all_in_parallel()
+{
+	_pimpl->instantiate_all_in_parallel();
+}
+
 QObject * injector::get(const type &interface_type)
 {
 	assert(!interface_type.is_empty());
@@ -91,6 +113,35 @@ QObject * injector::get(const type &interface_type)
 	return _pimpl->get(interface_type);
 }
 
+QFuture<void> injector::instantiate_async(const type &interface_type, QThread *object_thread)
+{
+	assert(!interface_type.is_empty());
+
+	if (interface_type.is_qobject())
+		throw exception::qobject_type{};
+
+	return _pimpl->instantiate_async(interface_type, object_thread);
+}
+
+QFuture<QObject *> injector::get_async(const type &interface_type, QThread *object_thread)
+{
+	auto future = QFutureInterface<QObject *>{};
+	get_async(interface_type, object_thread, future, [future](QObject *object) mutable {
+		future.reportResult(object);
+	});
+	return future.future();
+}
+
+void injector::get_async(const type &interface_type, QThread *object_thread, QFutureInterfaceBase future, std::function<void(QObject *)> report_result)
+{
+	assert(!interface_type.is_empty());
+
+	if (interface_type.is_qobject())
+		throw exception::qobject_type{};
+
+	_pimpl->get_async(interface_type, object_thread, std::move(future), std::move(report_result));
+}
+
 std::vector<QObject *> injector::get_all_with_type_role(const std::string &type_role)
 {
 	return _pimpl->get_all_with_type_role(type_role);
@@ -103,4 +154,102 @@ void injector::inject_into(QObject *object)
 	_pimpl->inject_into(object);
 }
 
+void injector::inject_into(const std::vector<QObject *> &objects)
+{
+	assert(std::none_of(std::begin(objects), std::end(objects), [](QObject *object){ return object == nullptr; }));
+
+	_pimpl->inject_into(objects);
+}
+
+void injector::freeze()
+{
+	_pimpl->freeze();
+}
+
+void injector::freeze(const std::vector<type> &root_types)
+{
+	for (auto &&root_type : root_types)
+	{
+		assert(!root_type.is_empty());
+
+		if (root_type.is_qobject())
+			throw exception::qobject_type{};
+	}
+
+	_pimpl->freeze(root_types);
+}
+
+bool injector::is_frozen() const
+{
+	return _pimpl->is_frozen();
+}
+
+void injector::validate_all() const
+{
+	_pimpl->validate_all();
+}
+
+void injector::warm_up(const std::vector<type> &types)
+{
+	for (auto &&t : types)
+	{
+		assert(!t.is_empty());
+
+		if (t.is_qobject())
+			throw exception::qobject_type{};
+	}
+
+	_pimpl->warm_up(types);
+}
+
+void injector::warm_up_with_type_role(const std::string &type_role)
+{
+	_pimpl->warm_up_with_type_role(type_role);
+}
+
+void injector::start_access_recording()
+{
+	_pimpl->start_access_recording();
+}
+
+bool injector::save_access_recording(const std::string &file_name) const
+{
+	return _pimpl->save_access_recording(file_name);
+}
+
+bool injector::replay_access_recording(const std::string &file_name)
+{
+	return _pimpl->replay_access_recording(file_name);
+}
+
+bool injector::save_dependency_graph_dot(const std::string &file_name) const
+{
+	return _pimpl->save_dependency_graph_dot(file_name);
+}
+
+bool injector::save_dependency_graph_json(const std::string &file_name) const
+{
+	return _pimpl->save_dependency_graph_json(file_name);
+}
+
+critical_path injector::find_critical_path(const type &interface_type) const
+{
+	assert(!interface_type.is_empty());
+
+	if (interface_type.is_qobject())
+		throw exception::qobject_type{};
+
+	return _pimpl->find_critical_path(interface_type);
+}
+
+std::vector<critical_path> injector::find_critical_paths() const
+{
+	return _pimpl->find_critical_paths();
+}
+
+std::string injector::critical_path_report() const
+{
+	return _pimpl->critical_path_report();
+}
+
 }}
@@ -0,0 +1,111 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "access-recorder.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace injeqt { namespace internal {
+
+access_recorder::access_recorder() :
+		_recording{false}
+{
+}
+
+void access_recorder::start()
+{
+	std::lock_guard<std::mutex> lock{_mutex};
+	_start = clock::now();
+	_records.clear();
+	_recorded_types.clear();
+	_recording.store(true, std::memory_order_release);
+}
+
+bool access_recorder::is_recording() const
+{
+	return _recording.load(std::memory_order_acquire);
+}
+
+void access_recorder::record(const type &accessed, clock::time_point access_start)
+{
+	if (!is_recording() || access_start == clock::time_point{})
+		return;
+
+	auto access_end = clock::now();
+	auto type_name = accessed.name();
+
+	std::lock_guard<std::mutex> lock{_mutex};
+	if (!_recorded_types.insert(type_name).second)
+		return;
+
+	auto offset = std::chrono::duration_cast<std::chrono::microseconds>(access_start - _start).count();
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(access_end - access_start).count();
+	_records.push_back(access_record{std::move(type_name), offset, duration});
+}
+
+std::vector<access_record> access_recorder::records() const
+{
+	std::lock_guard<std::mutex> lock{_mutex};
+	return _records;
+}
+
+bool write_access_records(const std::string &file_name, const std::vector<access_record> &records)
+{
+	std::ofstream file{file_name, std::ios::out | std::ios::trunc};
+	if (!file)
+		return false;
+
+	for (auto &&record : records)
+		file << record.offset << ' ' << record.duration << ' ' << record.type_name << '\n';
+
+	file.close();
+	return static_cast<bool>(file);
+}
+
+bool read_access_records(const std::string &file_name, std::vector<access_record> &records)
+{
+	std::ifstream file{file_name};
+	if (!file)
+		return false;
+
+	auto result = std::vector<access_record>{};
+	auto line = std::string{};
+	while (std::getline(file, line))
+	{
+		if (line.empty())
+			continue;
+
+		// type name is the rest of line
+		std::istringstream line_stream{line};
+		auto record = access_record{};
+		if (!(line_stream >> record.offset >> record.duration >> std::ws) || !std::getline(line_stream, record.type_name))
+			return false;
+		result.push_back(std::move(record));
+	}
+
+	if (file.bad())
+		return false;
+
+	records = std::move(result);
+	return true;
+}
+
+}}
@@ -0,0 +1,124 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for recording order of accessing types in injector.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief First access to a type recorded by access_recorder.
+ *
+ * Times are in microseconds. @p offset is measured from start of recording, @p duration is time
+ * spent in call that accessed type - including creating the object and its dependencies.
+ */
+struct access_record
+{
+	std::string type_name;
+	std::int64_t offset;
+	std::int64_t duration;
+};
+
+/**
+ * @brief Records order and timing of first access to each type.
+ * @see injector::start_access_recording()
+ *
+ * Recorder is disabled after construction, so is_recording() is the only cost paid by injector_core
+ * until start() is called. Then each type is recorded once, when record(const type &, clock::time_point)
+ * is called for it for the first time. This class is thread safe.
+ */
+class INJEQT_INTERNAL_API access_recorder final
+{
+
+public:
+	using clock = std::chrono::steady_clock;
+
+	access_recorder();
+
+	access_recorder(const access_recorder &) = delete;
+	access_recorder & operator = (const access_recorder &) = delete;
+
+	/**
+	 * @brief Clear all records and start recording.
+	 */
+	void start();
+
+	/**
+	 * @return true if start() was called
+	 */
+	bool is_recording() const;
+
+	/**
+	 * @brief Record access to @p accessed type that started at @p access_start and ended now.
+	 *
+	 * Does nothing if recording was not started, if @p access_start is default constructed time point
+	 * or if @p accessed type was already recorded.
+	 */
+	void record(const type &accessed, clock::time_point access_start);
+
+	/**
+	 * @return all records in order of first access
+	 */
+	std::vector<access_record> records() const;
+
+private:
+	std::atomic<bool> _recording;
+	mutable std::mutex _mutex;
+	clock::time_point _start;
+	std::vector<access_record> _records;
+	std::unordered_set<std::string> _recorded_types;
+
+};
+
+/**
+ * @brief Write @p records to file @p file_name.
+ * @return false if file could not be written
+ *
+ * Each record is written in one line, as offset, duration and type name separated with spaces.
+ * Type name is the rest of line.
+ */
+INJEQT_INTERNAL_API bool write_access_records(const std::string &file_name, const std::vector<access_record> &records);
+
+/**
+ * @brief Read records written by write_access_records(const std::string &, const std::vector<access_record> &).
+ * @param file_name name of file to read
+ * @param records read records are stored here, in order of file
+ * @return false if file could not be read or is not valid
+ */
+INJEQT_INTERNAL_API bool read_access_records(const std::string &file_name, std::vector<access_record> &records);
+
+}}
@@ -24,7 +24,9 @@
 #include <injeqt/type.h>
 
 #include "internal/interfaces-utils.h"
+#include "internal/type-metadata.h"
 
+#include <QtCore/QThread>
 #include <cassert>
 
 namespace injeqt { namespace internal {
@@ -56,15 +58,18 @@ bool action_method::validate_action_method(const QMetaMethod &meta_method)
 	return true;
 }
 
-action_method::action_method()
+action_method::action_method() :
+	_async{false}
 {
 }
 
 action_method::action_method(QMetaMethod meta_method) :
 	_object_type{meta_method.enclosingMetaObject()},
-	_meta_method{std::move(meta_method)}
+	_meta_method{std::move(meta_method)},
+	_call{_meta_method},
+	_async{std::string{_meta_method.typeName()} == "QFuture<void>"}
 {
-	assert(validate_action_method(meta_method));
+	assert(validate_action_method(_meta_method));
 }
 
 bool action_method::is_empty() const
@@ -77,13 +82,48 @@ const type & action_method::object_type() const
 	return _object_type;
 }
 
+const QMetaMethod & action_method::meta_method() const
+{
+	return _meta_method;
+}
+
+bool action_method::is_async() const
+{
+	return _async;
+}
+
 bool action_method::invoke(QObject *on) const
 {
 	assert(!is_empty());
 	assert(on != nullptr);
 	assert(implements(type{on->metaObject()}, _object_type));
 
-	return _meta_method.invoke(on);
+	// QMetaMethod::invoke would queue call to object living in other thread
+	if (on->thread() != QThread::currentThread())
+		return _meta_method.invoke(on);
+
+	void *arguments[] = {nullptr};
+	_call.invoke(on, arguments);
+	return true;
+}
+
+QFuture<void> action_method::invoke_async(QObject *on) const
+{
+	assert(!is_empty());
+	assert(on != nullptr);
+	assert(implements(type{on->metaObject()}, _object_type));
+
+	// default constructed future is already finished
+	auto result = QFuture<void>{};
+	if (!_async || on->thread() != QThread::currentThread())
+	{
+		invoke(on);
+		return result;
+	}
+
+	void *arguments[] = {&result};
+	_call.invoke(on, arguments);
+	return result;
 }
 
 action_method make_action_method(const QMetaMethod &meta_method)
@@ -97,6 +137,11 @@ std::vector<action_method> extract_actions(const std::string &action_tag, const
 {
 	assert(!for_type.is_empty());
 
+	if (action_method::is_action_init_tag(action_tag))
+		return type_metadata_for(for_type).init_actions();
+	if (action_method::is_action_done_tag(action_tag))
+		return type_metadata_for(for_type).done_actions();
+
 	auto result = std::vector<action_method>{};
 
 	auto meta_object = for_type.meta_object();
@@ -20,12 +20,14 @@
 
 #pragma once
 
+#include "direct-call.h"
 #include "internal.h"
 
 #include <injeqt/exception/exception.h>
 #include <injeqt/injeqt.h>
 #include <injeqt/type.h>
 
+#include <QtCore/QFuture>
 #include <QtCore/QMetaMethod>
 #include <string>
 
@@ -61,6 +63,10 @@ namespace injeqt { namespace internal {
  *     };
  *
  * Object with setter method must not take ownership of passed object.
+ *
+ * Action method can return QFuture<void>. Such action is asynchronous - it should start its work
+ * (for example with QtConcurrent::run) and return immediately. Use invoke_async(QObject *) to get
+ * its future.
  */
 class INJEQT_INTERNAL_API action_method final
 {
@@ -101,6 +107,18 @@ public:
 	 */
 	const type & object_type() const;
 
+	/**
+	 * @return Qt representation of action method.
+	 *
+	 * May return empty value if QMetaMethod passed in constructor was invalid.
+	 */
+	const QMetaMethod & meta_method() const;
+
+	/**
+	 * @return true if action method returns QFuture<void>
+	 */
+	bool is_async() const;
+
 	/**
 	 * @param on object to call this method on
 	 * @param parameter parmeter to be passed in invocation
@@ -119,13 +137,27 @@ public:
 	 */
 	bool invoke(QObject *on) const;
 
+	/**
+	 * @param on object to call this method on
+	 * @return future returned by asynchronous action or finished future for synchronous one
+	 * @pre !is_empty()
+	 * @pre on != nullptr
+	 * @pre type{on->metaObject()} == object_type()
+	 *
+	 * For object living in other thread the call is queued as in invoke(QObject *) and
+	 * finished future is returned.
+	 */
+	QFuture<void> invoke_async(QObject *on) const;
+
 private:
 	type _object_type;
 	QMetaMethod _meta_method;
+	direct_call _call;
+	bool _async;
 
 };
 
 INJEQT_INTERNAL_API action_method make_action_method(const QMetaMethod &meta_method);
-std::vector<action_method> extract_actions(const std::string &action_tag, const type &for_type);
+INJEQT_INTERNAL_API std::vector<action_method> extract_actions(const std::string &action_tag, const type &for_type);
 
 }}
@@ -0,0 +1,52 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "async-exception.h"
+
+#include <cassert>
+
+namespace injeqt { namespace internal {
+
+async_exception::async_exception(std::exception_ptr error) :
+		_error{std::move(error)}
+{
+	assert(_error);
+}
+
+async_exception::~async_exception() noexcept
+{
+}
+
+void async_exception::raise() const
+{
+	std::rethrow_exception(_error);
+}
+
+async_exception * async_exception::clone() const
+{
+	return new async_exception{*this};
+}
+
+std::exception_ptr async_exception::error() const
+{
+	return _error;
+}
+
+}}
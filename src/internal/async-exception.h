@@ -0,0 +1,76 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <QtCore/QException>
+#include <exception>
+
+/**
+ * @file
+ * @brief Contains classes and functions for passing exceptions through QFuture.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief QException that carries any exception thrown in other thread.
+ *
+ * QFutureInterface can only store exceptions derived from QException, but Injeqt exceptions
+ * derive from std::exception. This class stores std::exception_ptr to original exception
+ * and raise() rethrows it, so code waiting for QFuture catches the same exception types
+ * that synchronous version of the call throws.
+ */
+class INJEQT_INTERNAL_API async_exception final : public QException
+{
+
+public:
+	/**
+	 * @brief Create async_exception carrying @p error.
+	 * @pre error != nullptr
+	 */
+	explicit async_exception(std::exception_ptr error);
+	virtual ~async_exception() noexcept;
+
+	/**
+	 * @brief Rethrow carried exception.
+	 */
+	virtual void raise() const override;
+
+	/**
+	 * @return copy of this object carrying the same exception
+	 */
+	virtual async_exception * clone() const override;
+
+	/**
+	 * @return carried exception
+	 */
+	std::exception_ptr error() const;
+
+private:
+	std::exception_ptr _error;
+
+};
+
+}}
@@ -0,0 +1,46 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "critical-path-report.h"
+
+#include <algorithm>
+
+namespace injeqt { namespace internal {
+
+void write_critical_path_report(std::ostream &stream, const std::vector<critical_path> &paths)
+{
+	for (auto &&path : paths)
+	{
+		if (path.types.empty())
+			continue;
+
+		stream << path.types.front() << ": " << path.path_time << " us on critical path, " << path.total_time << " us in total, "
+			<< path.parallel_saving << " us could be saved by parallel instantiation\n";
+
+		auto most_expensive = std::max_element(std::begin(path.times), std::end(path.times)) - std::begin(path.times);
+		if (path.times[most_expensive] > 0)
+			stream << "  most expensive on path: " << path.types[most_expensive] << " (" << path.times[most_expensive] << " us)\n";
+
+		for (decltype(path.types.size()) i = 0; i < path.types.size(); i++)
+			stream << "    " << path.types[i] << " " << path.times[i] << " us\n";
+	}
+}
+
+}}
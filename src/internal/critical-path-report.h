@@ -0,0 +1,47 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/critical-path.h>
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <ostream>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains functions for reporting critical paths in text form.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Write @p paths to @p stream as text report.
+ *
+ * Each path is written as header line with root type, path time, total time, possible saving
+ * and most expensive type on path, followed by indented line for each type on path.
+ * All times are in microseconds.
+ */
+INJEQT_INTERNAL_API void write_critical_path_report(std::ostream &stream, const std::vector<critical_path> &paths);
+
+}}
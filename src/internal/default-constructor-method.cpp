@@ -20,21 +20,27 @@
 
 #include "default-constructor-method.h"
 
+#include "direct-call.h"
+#include "type-metadata.h"
+
 #include <cassert>
 
 namespace injeqt { namespace internal {
 
-default_constructor_method::default_constructor_method()
+default_constructor_method::default_constructor_method() :
+	_constructor_index{-1}
 {
 }
 
 default_constructor_method::default_constructor_method(QMetaMethod meta_method) :
 	_object_type{meta_method.enclosingMetaObject()},
-	_meta_method{std::move(meta_method)}
+	_meta_method{std::move(meta_method)},
+	_constructor_index{type_metadata_for(_object_type).default_constructor_index()}
 {
-	assert(meta_method.methodType() == QMetaMethod::Constructor);
-	assert(meta_method.parameterCount() == 0);
-	assert(meta_method.enclosingMetaObject() != nullptr);
+	assert(_meta_method.methodType() == QMetaMethod::Constructor);
+	assert(_meta_method.parameterCount() == 0);
+	assert(_meta_method.enclosingMetaObject() != nullptr);
+	assert(_constructor_index >= 0);
 }
 
 bool default_constructor_method::is_empty() const
@@ -56,7 +62,7 @@ std::unique_ptr<QObject> default_constructor_method::invoke() const
 {
 	assert(!is_empty());
 
-	return std::unique_ptr<QObject>{_meta_method.enclosingMetaObject()->newInstance()};
+	return std::unique_ptr<QObject>{create_instance(_object_type.meta_object(), _constructor_index)};
 }
 
 bool operator == (const default_constructor_method &x, const default_constructor_method &y)
@@ -79,19 +85,10 @@ default_constructor_method make_default_constructor_method(const type &t)
 	assert(!t.is_empty());
 	assert(!t.is_qobject());
 
-	auto meta_object = t.meta_object();
-	auto constructor_count = meta_object->constructorCount();
-	for (decltype(constructor_count) i = 0; i < constructor_count; i++)
-	{
-		auto constructor = meta_object->constructor(i);
-		if (constructor.methodType() != QMetaMethod::Constructor)
-			continue;
-		if (constructor.parameterCount() != 0)
-			continue;
-		return default_constructor_method{constructor};
-	}
-
-	return default_constructor_method{};
+	auto index = type_metadata_for(t).default_constructor_index();
+	return index < 0
+		? default_constructor_method{}
+		: default_constructor_method{t.meta_object()->constructor(index)};
 }
 
 }}
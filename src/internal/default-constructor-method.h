@@ -102,6 +102,7 @@ public:
 private:
 	type _object_type;
 	QMetaMethod _meta_method;
+	int _constructor_index;
 
 };
 
@@ -31,6 +31,7 @@
 #include "dependency.h"
 #include "interfaces-utils.h"
 #include "setter-method.h"
+#include "type-metadata.h"
 #include "type-relations.h"
 
 #include <QtCore/QMetaMethod>
@@ -46,15 +47,17 @@ std::vector<setter_method> extract_setters(const types_by_name &known_types, con
 {
 	assert(!for_type.is_empty());
 
+	auto &&candidates = type_metadata_for(for_type).setter_candidates();
 	auto result = std::vector<setter_method>{};
+	result.reserve(candidates.size());
 
-	auto meta_object = for_type.meta_object();
-	auto method_count = meta_object->methodCount();
-	for (decltype(method_count) i = 0; i < method_count; i++)
+	for (auto &&candidate : candidates)
 	{
-		auto maybe_setter = meta_object->method(i);
-		if (setter_method::is_setter_tag(maybe_setter.tag()))
-			result.emplace_back(make_setter_method(known_types, maybe_setter));
+		auto parameter_type = candidate.parameter_pointer_name.empty()
+			? type{nullptr}
+			: type_by_pointer(known_types, candidate.parameter_pointer_name);
+		setter_method::validate_setter_method(parameter_type, candidate.meta_method);
+		result.emplace_back(parameter_type, candidate.meta_method);
 	}
 
 	return result;
@@ -66,21 +69,21 @@ dependencies extract_dependencies(const types_by_name &known_types, const type &
 {
 	assert(!for_type.is_empty());
 
-	auto interfaces = extract_interfaces(for_type);
+	auto &&interfaces = extract_interfaces(for_type);
 	auto setters = extract_setters(known_types, for_type);
 	for (auto &&setter : setters)
 	{
 		auto parameter_type = setter.parameter_type();
 		if (parameter_type == for_type)
 			throw exception::dependency_on_self{};
-		if (std::find(std::begin(interfaces), std::end(interfaces), parameter_type) != std::end(interfaces))
+		if (interfaces.contains(parameter_type))
 			throw exception::dependency_on_supertype{};
-		auto parameter_interfaces = extract_interfaces(parameter_type);
-		if (std::find(std::begin(parameter_interfaces), std::end(parameter_interfaces), for_type) != std::end(parameter_interfaces))
+		if (extract_interfaces(parameter_type).contains(for_type))
 			throw exception::dependency_on_subtype{};
 	}
 
 	auto result = std::vector<dependency>{};
+	result.reserve(setters.size());
 	std::transform(std::begin(setters), std::end(setters), std::back_inserter(result),
 		[](const setter_method &setter){ return dependency{setter}; }
 	);
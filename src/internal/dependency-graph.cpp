@@ -0,0 +1,180 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "dependency-graph.h"
+
+#include "json-string.h"
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+std::string dot_escaped(const std::string &value)
+{
+	auto result = std::string{};
+	for (auto c : value)
+	{
+		if (c == '"' || c == '\\')
+			result.push_back('\\');
+		result.push_back(c);
+	}
+	return result;
+}
+
+void write_dot_string(std::ostream &stream, const std::string &value)
+{
+	stream << '"' << dot_escaped(value) << '"';
+}
+
+std::string join(const std::vector<std::string> &values)
+{
+	auto result = std::string{};
+	for (auto &&value : values)
+	{
+		if (!result.empty())
+			result.append(", ");
+		result.append(value);
+	}
+	return result;
+}
+
+std::string dot_label(const dependency_graph_node &node)
+{
+	// \n is a line break in DOT labels, so it is appended after escaping
+	auto lines = std::vector<std::string>{node.name, node.kind};
+	if (!node.interfaces.empty())
+		lines.push_back("interfaces: " + join(node.interfaces));
+	if (!node.type_roles.empty())
+		lines.push_back("roles: " + join(node.type_roles));
+	if (node.construction_time >= 0)
+		lines.push_back("construction: " + std::to_string(node.construction_time) + " us");
+	if (node.init_time >= 0)
+		lines.push_back("init: " + std::to_string(node.init_time) + " us");
+
+	auto result = std::string{};
+	for (auto &&line : lines)
+		result.append(dot_escaped(line) + "\\n");
+	return result;
+}
+
+const char * dot_edge_style(const std::string &kind)
+{
+	if (kind == "factory")
+		return "dashed";
+	if (kind == "parent_injector")
+		return "dotted";
+	return "solid";
+}
+
+void write_json_strings(std::ostream &stream, const std::vector<std::string> &values)
+{
+	stream << '[';
+	auto first = true;
+	for (auto &&value : values)
+	{
+		if (!first)
+			stream << ',';
+		write_json_string(stream, value);
+		first = false;
+	}
+	stream << ']';
+}
+
+void write_json_time(std::ostream &stream, std::int64_t time)
+{
+	if (time >= 0)
+		stream << time;
+	else
+		stream << "null";
+}
+
+}
+
+void write_dependency_graph_dot(std::ostream &stream, const dependency_graph &graph)
+{
+	stream << "digraph injeqt {\n";
+	stream << "\tnode [shape=box];\n";
+	for (auto &&node : graph.nodes)
+	{
+		stream << '\t';
+		write_dot_string(stream, node.name);
+		stream << " [label=\"" << dot_label(node) << "\"";
+		if (node.instantiated)
+			stream << ", style=filled, fillcolor=lightgray";
+		stream << "];\n";
+	}
+	for (auto &&edge : graph.edges)
+	{
+		stream << '\t';
+		write_dot_string(stream, edge.from);
+		stream << " -> ";
+		write_dot_string(stream, edge.to);
+		stream << " [style=" << dot_edge_style(edge.kind);
+		if (!edge.label.empty())
+		{
+			stream << ", label=";
+			write_dot_string(stream, edge.label);
+		}
+		stream << "];\n";
+	}
+	stream << "}\n";
+}
+
+void write_dependency_graph_json(std::ostream &stream, const dependency_graph &graph)
+{
+	stream << "{\"nodes\":[";
+	auto first = true;
+	for (auto &&node : graph.nodes)
+	{
+		stream << (first ? "\n" : ",\n") << "{\"name\":";
+		write_json_string(stream, node.name);
+		stream << ",\"kind\":";
+		write_json_string(stream, node.kind);
+		stream << ",\"interfaces\":";
+		write_json_strings(stream, node.interfaces);
+		stream << ",\"type_roles\":";
+		write_json_strings(stream, node.type_roles);
+		stream << ",\"instantiated\":" << (node.instantiated ? "true" : "false");
+		stream << ",\"construction_time\":";
+		write_json_time(stream, node.construction_time);
+		stream << ",\"init_time\":";
+		write_json_time(stream, node.init_time);
+		stream << '}';
+		first = false;
+	}
+	stream << "\n],\"edges\":[";
+	first = true;
+	for (auto &&edge : graph.edges)
+	{
+		stream << (first ? "\n" : ",\n") << "{\"from\":";
+		write_json_string(stream, edge.from);
+		stream << ",\"to\":";
+		write_json_string(stream, edge.to);
+		stream << ",\"kind\":";
+		write_json_string(stream, edge.kind);
+		stream << ",\"label\":";
+		write_json_string(stream, edge.label);
+		stream << '}';
+		first = false;
+	}
+	stream << "\n]}\n";
+}
+
+}}
@@ -0,0 +1,99 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for exporting graph of types configured in injector.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Node of dependency_graph.
+ *
+ * Node is created for each implementation type configured in injector and for each parent injector.
+ * Times are in microseconds and are measured only for instantiated types, -1 means not measured.
+ * Construction time is time of provider::provide(injector_core &) call, init time is time of calling
+ * all INJEQT_INIT methods of object.
+ */
+struct dependency_graph_node
+{
+	std::string name;
+	std::string kind;
+	std::vector<std::string> interfaces;
+	std::vector<std::string> type_roles;
+	bool instantiated;
+	std::int64_t construction_time;
+	std::int64_t init_time;
+};
+
+/**
+ * @brief Edge of dependency_graph.
+ *
+ * Edge goes from node that needs object to node that gives it. @p kind is "setter" for dependencies
+ * resolved with INJEQT_SET methods (with setter signature in @p label), "factory" for types required
+ * by factory providers and "parent_injector" for types provided by parent injectors.
+ */
+struct dependency_graph_edge
+{
+	std::string from;
+	std::string to;
+	std::string kind;
+	std::string label;
+};
+
+/**
+ * @brief Graph of types configured in injector.
+ * @see injector::save_dependency_graph_dot(const std::string &)
+ */
+struct dependency_graph
+{
+	std::vector<dependency_graph_node> nodes;
+	std::vector<dependency_graph_edge> edges;
+};
+
+/**
+ * @brief Write @p graph to @p stream in Graphviz DOT format.
+ *
+ * Each node is labeled with its name, kind, interfaces, type roles and times. Instantiated nodes
+ * are filled. Edges of different kinds have different styles.
+ */
+INJEQT_INTERNAL_API void write_dependency_graph_dot(std::ostream &stream, const dependency_graph &graph);
+
+/**
+ * @brief Write @p graph to @p stream as JSON object with "nodes" and "edges" arrays.
+ *
+ * Fields of nodes and edges have the same names as members of dependency_graph_node and
+ * dependency_graph_edge. Times that were not measured are written as null.
+ */
+INJEQT_INTERNAL_API void write_dependency_graph_json(std::ostream &stream, const dependency_graph &graph);
+
+}}
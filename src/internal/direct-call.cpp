@@ -0,0 +1,67 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "direct-call.h"
+
+#include <QtCore/QObject>
+#include <cassert>
+
+namespace injeqt { namespace internal {
+
+direct_call::direct_call() :
+		_method_index{-1}
+{
+}
+
+direct_call::direct_call(const QMetaMethod &meta_method) :
+		_method_index{meta_method.methodIndex()}
+{
+	assert(meta_method.enclosingMetaObject() != nullptr);
+	assert(meta_method.methodType() != QMetaMethod::Constructor);
+}
+
+bool direct_call::is_empty() const
+{
+	return _method_index < 0;
+}
+
+void direct_call::invoke(QObject *on, void **arguments) const
+{
+	assert(!is_empty());
+	assert(on != nullptr);
+
+	// public entry point to moc code, works for dynamic meta objects too
+	QMetaObject::metacall(on, QMetaObject::InvokeMetaMethod, _method_index, arguments);
+}
+
+QObject * create_instance(const QMetaObject *meta_object, int constructor_index)
+{
+	assert(meta_object != nullptr);
+	assert(constructor_index >= 0);
+
+	QObject *result = nullptr;
+	void *arguments[] = {&result};
+	// returns -1 when constructor was called
+	if (meta_object->static_metacall(QMetaObject::CreateInstance, constructor_index, arguments) >= 0)
+		return nullptr;
+	return result;
+}
+
+}}
@@ -0,0 +1,96 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <QtCore/QMetaMethod>
+#include <QtCore/QMetaObject>
+
+class QObject;
+
+/**
+ * @file
+ * @brief Contains classes and functions for calling methods without QMetaMethod::invoke.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Precomputed direct call of a method.
+ *
+ * QMetaMethod::invoke checks number of arguments, compares return type name, checks thread
+ * of target object and computes index of method on each call. Only then it calls metacall
+ * function generated by moc. This class computes method index once, so invoke() only passes
+ * prepared array of arguments to public QMetaObject::metacall(), which dispatches it to moc code.
+ *
+ * Direct call behaves like QMetaMethod::invoke with Qt::DirectConnection. Callers must make
+ * sure that arguments have types expected by method and should use QMetaMethod::invoke when
+ * target object lives in other thread and Qt::AutoConnection semantics are required.
+ */
+class INJEQT_INTERNAL_API direct_call final
+{
+
+public:
+	/**
+	 * @brief Create empty direct_call.
+	 */
+	direct_call();
+
+	/**
+	 * @brief Create direct_call of @p meta_method.
+	 * @pre meta_method.enclosingMetaObject() != nullptr
+	 * @pre meta_method.methodType() != QMetaMethod::Constructor
+	 */
+	explicit direct_call(const QMetaMethod &meta_method);
+
+	/**
+	 * @return true if direct_call was created with default constructor
+	 */
+	bool is_empty() const;
+
+	/**
+	 * @brief Call method on @p on.
+	 * @param on object to call method on
+	 * @param arguments pointer to return value (or nullptr) followed by pointers to all arguments
+	 * @pre !is_empty()
+	 * @pre on != nullptr
+	 */
+	void invoke(QObject *on, void **arguments) const;
+
+private:
+	int _method_index;
+
+};
+
+/**
+ * @brief Create new instance of @p meta_object with constructor of index @p constructor_index.
+ * @param meta_object type of object to create
+ * @param constructor_index index of constructor without parameters, as in QMetaObject::constructor(int)
+ * @return new object or nullptr if it cannot be created
+ *
+ * Works like QMetaObject::newInstance() without parsing and looking up constructor signature.
+ */
+INJEQT_INTERNAL_API QObject * create_instance(const QMetaObject *meta_object, int constructor_index);
+
+}}
@@ -21,25 +21,54 @@
 #include "factory-method.h"
 
 #include "interfaces-utils.h"
+#include "type-metadata.h"
 
+#include <QtCore/QThread>
 #include <cassert>
 
 namespace injeqt { namespace internal {
 
-factory_method::factory_method()
+namespace {
+
+const std::string future_prefix = "QFuture<";
+const std::string future_suffix = ">";
+
+bool is_future_name(const std::string &type_name)
+{
+	return type_name.size() > future_prefix.size() + future_suffix.size() &&
+		type_name.compare(0, future_prefix.size(), future_prefix) == 0 &&
+		type_name.compare(type_name.size() - future_suffix.size(), future_suffix.size(), future_suffix) == 0;
+}
+
+std::string result_pointer_name(const std::string &type_name)
 {
+	return is_future_name(type_name)
+		? type_name.substr(future_prefix.size(), type_name.size() - future_prefix.size() - future_suffix.size())
+		: type_name;
+}
+
 }
 
-factory_method::factory_method(type result_type, QMetaMethod meta_method) :
+factory_method::factory_method() :
+	_async{false},
+	_read_future{nullptr}
+{
+}
+
+factory_method::factory_method(type result_type, QMetaMethod meta_method, factory_future_reader read_future) :
 	_object_type{meta_method.enclosingMetaObject()},
 	_result_type{std::move(result_type)},
-	_meta_method{std::move(meta_method)}
+	_meta_method{std::move(meta_method)},
+	_call{_meta_method},
+	_async{is_future_name(_meta_method.typeName())},
+	_read_future{read_future}
 {
-	assert(meta_method.methodType() == QMetaMethod::Method || meta_method.methodType() == QMetaMethod::Slot);
-	assert(meta_method.parameterCount() == 0);
-	assert(meta_method.enclosingMetaObject() != nullptr);
+	assert(_meta_method.methodType() == QMetaMethod::Method || _meta_method.methodType() == QMetaMethod::Slot);
+	assert(_meta_method.parameterCount() == 0);
+	assert(_meta_method.enclosingMetaObject() != nullptr);
 	assert(!_result_type.is_empty());
-	assert(_result_type.name() + "*" == std::string{meta_method.typeName()});
+	assert(type_metadata_for(_result_type).pointer_name() == result_pointer_name(_meta_method.typeName()));
+	assert(!_async || _read_future != nullptr);
 }
 
 bool factory_method::is_empty() const
@@ -62,17 +91,58 @@ const QMetaMethod & factory_method::meta_method() const
 	return _meta_method;
 }
 
+bool factory_method::is_async() const
+{
+	return _async;
+}
+
 std::unique_ptr<QObject> factory_method::invoke(QObject *on) const
 {
 	assert(!is_empty());
 	assert(on != nullptr);
 	assert(meta_method().enclosingMetaObject() == on->metaObject());
 
+	if (_async)
+		return std::unique_ptr<QObject>{invoke_async(on)()};
+
 	QObject *result = nullptr;
-	_meta_method.invoke(on, QReturnArgument<QObject *>((_result_type.name() + "*").c_str(), result)); // TODO: check for false result
+	// keep QMetaMethod::invoke semantics for object living in other thread
+	if (on->thread() != QThread::currentThread())
+	{
+		_meta_method.invoke(on, QReturnArgument<QObject *>(type_metadata_for(_result_type).pointer_name().c_str(), result)); // TODO: check for false result
+		return std::unique_ptr<QObject>{result};
+	}
+
+	void *arguments[] = {&result};
+	_call.invoke(on, arguments);
 	return std::unique_ptr<QObject>{result};
 }
 
+std::function<QObject *()> factory_method::invoke_async(QObject *on) const
+{
+	assert(!is_empty());
+	assert(on != nullptr);
+	assert(meta_method().enclosingMetaObject() == on->metaObject());
+
+	if (!_async)
+	{
+		auto object = invoke(on).release();
+		return [object](){ return object; };
+	}
+
+	// reader provides storage of QFuture<T *> that factory method really returns
+	return _read_future([&](void *result){
+		if (on->thread() != QThread::currentThread())
+		{
+			_meta_method.invoke(on, QGenericReturnArgument(_meta_method.typeName(), result));
+			return;
+		}
+
+		void *arguments[] = {result};
+		_call.invoke(on, arguments);
+	});
+}
+
 bool operator == (const factory_method &x, const factory_method &y)
 {
 	if (x.object_type() != y.object_type())
@@ -89,28 +159,26 @@ bool operator != (const factory_method &x, const factory_method &y)
 	return !(x == y);
 }
 
-factory_method make_factory_method(const types_by_name &known_types, const type &t, const type &f)
+factory_method make_factory_method(const types_by_name &known_types, const type &t, const type &f, factory_future_reader read_future)
 {
 	assert(!t.is_empty());
 	assert(!t.is_qobject());
 	assert(!f.is_empty());
 	assert(!f.is_qobject());
 
-	auto meta_object = f.meta_object();
-	auto method_count = meta_object->methodCount();
 	auto factory_methods = std::vector<factory_method>{};
 
-	for (decltype(method_count) i = 0; i < method_count; i++)
+	for (auto &&candidate : type_metadata_for(f).factory_candidates())
 	{
-		auto method = meta_object->method(i);
-		if (method.parameterCount() != 0)
-			continue;
-		auto return_type = type_by_pointer(known_types, method.typeName());
+		auto return_type = type_by_pointer(known_types, result_pointer_name(candidate.return_pointer_name));
 		if (return_type.is_empty())
 			continue;
-		auto interfaces = extract_interfaces(return_type);
-		if (interfaces.contains(t))
-			factory_methods.emplace_back(return_type, method);
+		if (!extract_interfaces(return_type).contains(t))
+			continue;
+		// only QFuture<T *> can be read by read_future
+		if (is_future_name(candidate.meta_method.typeName()) && (return_type != t || !read_future))
+			continue;
+		factory_methods.emplace_back(return_type, candidate.meta_method, read_future);
 	}
 
 	if (factory_methods.size() == 1)
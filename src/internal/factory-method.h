@@ -22,11 +22,14 @@
 
 #include <injeqt/exception/exception.h>
 #include <injeqt/injeqt.h>
+#include <injeqt/module.h>
 #include <injeqt/type.h>
 
+#include "direct-call.h"
 #include "internal.h"
 #include "types-by-name.h"
 
+#include <functional>
 #include <memory>
 #include <QtCore/QMetaMethod>
 
@@ -71,6 +74,12 @@ namespace injeqt { namespace internal {
  * injector own lifetime of it. Method invoke(QObject *) call factory method
  * and immediately wraps returned QObject * in a std::unique_ptr that it later
  * returns.
+ *
+ * Factory method can also return QFuture of pointer to created object, for example
+ * QFuture<created_object *>. Such method is asynchronous and should start creating object
+ * (for example with QtConcurrent::run) and return immediately. Use invoke_async(QObject *)
+ * to call it. Its future is read through its own type by factory_future_reader, as QFuture of
+ * different pointer types can not be used in place of each other.
  */
 class INJEQT_INTERNAL_API factory_method final
 {
@@ -85,14 +94,16 @@ public:
 	 * @brief Create object from QMetaMethod definition.
 	 * @param parameter_type Type of retrun value of @p meta_method
 	 * @param meta_method Qt meta method that should be a factory method
+	 * @param read_future reader of QFuture returned by @p meta_method, if it is asynchronous
 	 * @note Qt QMetaType system limitations with plugins disallow use of QMetaType to retreive return type from QMetaMethod
 	 * @pre meta_method.methodType() == QMetaMethod::Method || meta_method.methodType() == QMetaMethod::Slot
 	 * @pre meta_method.parameterCount() == 0
 	 * @pre meta_method.enclosingMetaObject() != nullptr
 	 * @pre !result_type.is_empty()
-	 * @pre result_type.name() + "*" == std::string{result_type.typeName()}
+	 * @pre result_type.name() + "*" == std::string{meta_method.typeName()} or "QFuture<" + result_type.name() + "*>" == std::string{meta_method.typeName()}
+	 * @pre meta_method does not return QFuture or read_future != nullptr
 	 */
-	explicit factory_method(type result_type, QMetaMethod meta_method);
+	explicit factory_method(type result_type, QMetaMethod meta_method, factory_future_reader read_future = nullptr);
 
 	/**
 	 * @return true if factory_method is empty and does not represent method
@@ -116,6 +127,11 @@ public:
 	 */
 	const QMetaMethod & meta_method() const;
 
+	/**
+	 * @return true if factory method returns QFuture of pointer to created object
+	 */
+	bool is_async() const;
+
 	/**
 	 * @param on object to call this method on
 	 * @return Result on factory method called on given object.
@@ -129,10 +145,27 @@ public:
 	 */
 	std::unique_ptr<QObject> invoke(QObject *on) const;
 
+	/**
+	 * @param on object to call this method on
+	 * @return function that waits for result of factory method called on given object and returns it
+	 * @pre !is_empty()
+	 * @pre on != nullptr
+	 * @pre meta_method().enclosingMetaObject() is equal to @p on type
+	 *
+	 * Asynchronous factory method is called and returned function waits for its future. It rethrows
+	 * exception reported by that future and returns nullptr if future has no result. Synchronous
+	 * factory method is called immediately and returned function only returns its result. Caller
+	 * takes ownership of returned object.
+	 */
+	std::function<QObject *()> invoke_async(QObject *on) const;
+
 private:
 	type _object_type;
 	type _result_type;
 	QMetaMethod _meta_method;
+	direct_call _call;
+	bool _async;
+	factory_future_reader _read_future;
 
 };
 
@@ -147,10 +180,10 @@ INJEQT_INTERNAL_API bool operator != (const factory_method &x, const factory_met
  * @pre !f.is_empty() && !f.is_qobject()
  *
  * This function looks for all methods of type F that are tagged with Q_INVOKABLE, does not
- * accepts argumetns and returns T* or pointer to type derived from T. If only one such method
- * is found it is wrapped in factory_method type and returned. In other cases an empty
- * factory_method is returned.
+ * accepts argumetns and returns T* or pointer to type derived from T. Methods returning QFuture<T *> are
+ * accepted too, but only when @p read_future is not nullptr. If only one such method is found it is wrapped
+ * in factory_method type and returned. In other cases an empty factory_method is returned.
  */
-INJEQT_INTERNAL_API factory_method make_factory_method(const types_by_name &known_types, const type &t, const type &f);
+INJEQT_INTERNAL_API factory_method make_factory_method(const types_by_name &known_types, const type &t, const type &f, factory_future_reader read_future = nullptr);
 
 }}
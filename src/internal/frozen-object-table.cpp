@@ -0,0 +1,90 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "frozen-object-table.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace injeqt { namespace internal {
+
+frozen_object_table::frozen_object_table() :
+		_mask{0},
+		_size{0}
+{
+}
+
+frozen_object_table::frozen_object_table(const std::vector<std::pair<type, QObject *>> &objects) :
+		_mask{0},
+		_size{objects.size()}
+{
+	// at most half of slots are used, so probe sequences are short
+	auto capacity = std::size_t{1};
+	while (capacity < 2 * objects.size())
+		capacity *= 2;
+
+	_entries = std::vector<entry>(capacity, entry{nullptr, nullptr});
+	_mask = capacity - 1;
+
+	for (auto &&object : objects)
+	{
+		assert(!object.first.is_empty());
+		assert(object.second != nullptr);
+
+		auto slot = slot_of(object.first.meta_object());
+		while (_entries[slot].key)
+		{
+			assert(_entries[slot].key != object.first.meta_object());
+			slot = (slot + 1) & _mask;
+		}
+
+		_entries[slot] = entry{object.first.meta_object(), object.second};
+	}
+}
+
+std::size_t frozen_object_table::size() const
+{
+	return _size;
+}
+
+QObject * frozen_object_table::get(const type &for_type) const
+{
+	if (_entries.empty())
+		return nullptr;
+
+	auto key = for_type.meta_object();
+	for (auto slot = slot_of(key); _entries[slot].key; slot = (slot + 1) & _mask)
+		if (_entries[slot].key == key)
+			return _entries[slot].object;
+
+	return nullptr;
+}
+
+std::size_t frozen_object_table::slot_of(const QMetaObject *key) const
+{
+	// meta objects are aligned static data, so low bits carry no information
+	auto hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key));
+	hash ^= hash >> 33;
+	hash *= UINT64_C(0xff51afd7ed558ccd);
+	hash ^= hash >> 33;
+	return static_cast<std::size_t>(hash) & _mask;
+}
+
+}}
@@ -0,0 +1,90 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class QObject;
+
+/**
+ * @file
+ * @brief Contains classes and functions for immutable lookup of objects by type.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Immutable map of types to objects.
+ *
+ * Open addressing hash table with linear probing stored in one flat array. Lookup of
+ * an object usually touches only one cache line, compared to bucket and node of
+ * std::unordered_map. As it is never modified after construction, it can be read
+ * from many threads without any synchronization.
+ */
+class INJEQT_INTERNAL_API frozen_object_table final
+{
+
+public:
+	/**
+	 * @brief Create empty frozen_object_table.
+	 */
+	frozen_object_table();
+
+	/**
+	 * @brief Create frozen_object_table of @p objects.
+	 * @pre all types in @p objects are unique and not empty
+	 * @pre all objects in @p objects are not nullptr
+	 */
+	explicit frozen_object_table(const std::vector<std::pair<type, QObject *>> &objects);
+
+	/**
+	 * @return number of objects in table
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @return object stored for @p for_type or nullptr if table does not contain it
+	 */
+	QObject * get(const type &for_type) const;
+
+private:
+	struct entry
+	{
+		const QMetaObject *key;
+		QObject *object;
+	};
+
+	std::vector<entry> _entries;
+	std::size_t _mask;
+	std::size_t _size;
+
+	std::size_t slot_of(const QMetaObject *key) const;
+
+};
+
+}}
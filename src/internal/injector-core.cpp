@@ -21,34 +21,98 @@
 #include "injector-core.h"
 
 #include <injeqt/exception/ambiguous-types.h>
+#include <injeqt/exception/injector-frozen.h>
+#include <injeqt/exception/instantiation-failed.h>
 #include <injeqt/exception/unavailable-required-types.h>
 #include <injeqt/exception/unknown-type.h>
+#include <injeqt/exception/unresolvable-dependencies.h>
 #include <injeqt/module.h>
 
 #include "action-method.h"
 #include "containers.h"
 #include "interfaces-utils.h"
-#include "provided-object.h"
+#include "model-cache.h"
 #include "provider-by-default-constructor.h"
+#include "provider-by-parent-injector.h"
 #include "provider-ready.h"
 #include "provider.h"
 #include "module-impl.h"
-#include "required-to-satisfy.h"
-#include "resolve-dependencies.h"
-#include "resolved-dependency.h"
+#include "thread-call.h"
+#include "trace-recorder.h"
+#include "trusted-scope.h"
+#include "type-metadata.h"
 #include "type-role.h"
 
+#include <QtCore/QThread>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 
 namespace injeqt { namespace internal {
 
-injector_core::injector_core()
+namespace {
+
+// batches that current thread is instantiating, innermost first, objects of these are not published yet
+struct batch_frame
+{
+	const injector_core *core;
+	const std::vector<type_id> *implementation_ids;
+	const batch_frame *outer;
+};
+
+thread_local const batch_frame *current_batch = nullptr;
+
+class batch_scope
+{
+
+public:
+	batch_scope(const injector_core *core, const std::vector<type_id> *implementation_ids) :
+			_frame{core, implementation_ids, current_batch}
+	{
+		current_batch = &_frame;
+	}
+
+	~batch_scope()
+	{
+		current_batch = _frame.outer;
+	}
+
+	batch_scope(const batch_scope &) = delete;
+	batch_scope & operator = (const batch_scope &) = delete;
+
+private:
+	batch_frame _frame;
+
+};
+
+bool is_instantiated_by_current_thread(const injector_core *core, type_id implementation_id)
+{
+	for (auto frame = current_batch; frame; frame = frame->outer)
+		if (frame->core == core && std::binary_search(std::begin(*frame->implementation_ids), std::end(*frame->implementation_ids), implementation_id))
+			return true;
+	return false;
+}
+
+}
+
+injector_core::injector_core() :
+	_validation{validation_level::strict},
+	_visit_generation{0},
+	_state_mutex{new std::mutex{}},
+	_frozen{new std::atomic<bool>{false}}
 {
 }
 
-injector_core::injector_core(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&all_providers) :
-	_known_types{std::move(known_types)}
+injector_core::injector_core(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&all_providers,
+	validation_level validation, const std::string &model_cache_file) :
+	_known_types{std::move(known_types)},
+	_validation{validation},
+	_visit_generation{0},
+	_state_mutex{new std::mutex{}},
+	_frozen{new std::atomic<bool>{false}}
 {
+	trusted_scope trusted{_validation == validation_level::trusted};
+
 	auto all_providers_size = all_providers.size();
 	_available_providers = providers{std::move(all_providers)};
 
@@ -56,34 +120,55 @@ injector_core::injector_core(types_by_name known_types, std::vector<std::unique_
 	if (_available_providers.size() != all_providers_size)
 		throw exception::ambiguous_types{}; // TODO: find a way to extract type names
 
-	_types_model = create_types_model();
+	auto fingerprint = std::uint64_t{0};
+	auto cached = false;
+	if (!model_cache_file.empty())
+	{
+		trace_span span{"read_model_cache"};
+		fingerprint = model_fingerprint(_known_types, _available_providers);
+		cached = read_model_cache(model_cache_file, fingerprint, _known_types, _types_model);
+	}
 
-	auto required_types = std::vector<type>{};
-	for (auto &&p : _available_providers)
-		for (auto &&r : p->required_types())
-			required_types.push_back(r);
+	// cached model was validated before it was written
+	if (!cached)
+		_types_model = create_types_model();
+	index_types();
 
-	auto unavailable_required_types = match(types{required_types}, _types_model.available_types()).unmatched_1;
-	if (!unavailable_required_types.empty())
+	// only fully validated model can be written, as injectors with any validation level read it
+	if (!cached && _validation == validation_level::strict)
 	{
-		auto message = std::string{};
-		for (auto &&t : unavailable_required_types)
+		validate_required_types();
+		if (!model_cache_file.empty())
 		{
-			message.append(t.name());
-			message.append("\n");
+			trace_span span{"write_model_cache"};
+			write_model_cache(model_cache_file, fingerprint, _types_model);
 		}
-		throw exception::unavailable_required_types{message};
 	}
+
+	create_plans();
 }
 
 injector_core::~injector_core()
 {
-	for (auto &&resolved_object : _resolved_objects)
-		call_done_methods(resolved_object.object());
+	// sorted by type, so INJEQT_DONE methods are called in the same order as before objects were indexed
+	for (auto &&resolved_object : implementations{_resolved_objects})
+	{
+		// objects living in other thread are finished in that thread, unless it does not run anymore
+		auto object = resolved_object.object();
+		auto thread = running_object_thread(_type_index.id_of(resolved_object.interface_type()));
+		call_in_thread(thread, [&](){ call_done_methods(object); });
+	}
+
+	// providers delete objects of types bound to thread by themselves, moved objects are deleted here
+	for (auto id = type_id{0}; id < _moved_to_threads.size(); id++)
+		if (_moved_to_threads[id])
+			call_in_thread(running_object_thread(id), [&](){ _providers[id]->destroy_object(); });
 }
 
 types_model injector_core::create_types_model() const
 {
+	trace_span span{"make_types_model"};
+
 	auto all_types = std::vector<type>{};
 	auto need_dependencies = std::vector<type>{};
 	for (auto &&p : _available_providers)
@@ -91,11 +176,202 @@ types_model injector_core::create_types_model() const
 		all_types.push_back(p->provided_type());
 		if (p->require_resolving())
 		{
-			auto interfaces = extract_interfaces(p->provided_type());
+			auto &&interfaces = extract_interfaces(p->provided_type());
 			std::copy(std::begin(interfaces), std::end(interfaces), std::back_inserter(need_dependencies));
 		}
 	}
-	return make_types_model(_known_types, all_types, need_dependencies);
+	return make_types_model(_known_types, all_types, need_dependencies, _validation == validation_level::strict);
+}
+
+void injector_core::validate_required_types() const
+{
+	trace_span span{"validate_required_types"};
+
+	auto required_types = std::vector<type>{};
+	for (auto &&p : _available_providers)
+		for (auto &&r : p->required_types())
+			required_types.push_back(r);
+
+	auto message = std::string{};
+	match(types{required_types}, _types_model.available_types(), type_from_type, type_from_implemented_by,
+		match_ignore{},
+		[&message](const type &t){
+			message.append(t.name());
+			message.append("\n");
+		},
+		match_ignore{});
+	if (!message.empty())
+		throw exception::unavailable_required_types{message};
+}
+
+void injector_core::validate_type(type_id implementation_id) const
+{
+	auto message = std::string{};
+	for (auto &&r : _providers[implementation_id]->required_types())
+		if (!is_configured(r))
+		{
+			message.append(r.name());
+			message.append("\n");
+		}
+	if (!message.empty())
+		throw exception::unavailable_required_types{message};
+
+	auto mapped_dependencies = _types_model.mapped_dependencies().get(_type_index.type_of(implementation_id));
+	if (mapped_dependencies == std::end(_types_model.mapped_dependencies()))
+		return;
+
+	for (auto &&dependency : mapped_dependencies->dependency_list())
+		if (!is_configured(dependency.required_type()))
+		{
+			message.append(dependency.required_type().name());
+			message.append(": ");
+			message.append(dependency.setter().signature());
+			message.append("\n");
+		}
+	if (!message.empty())
+		throw exception::unresolvable_dependencies{message};
+}
+
+void injector_core::throw_not_configured(const type &interface_type) const
+{
+	if (_ambiguous_types.contains(interface_type))
+		throw exception::ambiguous_types{interface_type.name()};
+	throw exception::unknown_type{interface_type.name()};
+}
+
+void injector_core::index_types()
+{
+	trace_span span{"index_types"};
+
+	auto &&available_types = _types_model.available_types();
+	auto interface_types = std::vector<type>{};
+	interface_types.reserve(available_types.size());
+	for (auto &&available_type : available_types)
+		interface_types.push_back(available_type.interface_type());
+	_type_index = type_index{std::move(interface_types)};
+
+	_implementation_ids.reserve(available_types.size());
+	for (auto &&available_type : available_types)
+		_implementation_ids.push_back(_type_index.id_of(available_type.implementation_type()));
+
+	_providers = std::vector<provider *>(_type_index.size(), nullptr);
+	auto ambiguous_types = std::vector<type>{};
+	for (auto &&p : _available_providers)
+	{
+		auto id = _type_index.id_of(p->provided_type());
+		if (id != type_index::invalid_id)
+			_providers[id] = p.get();
+		else
+			ambiguous_types.push_back(p->provided_type());
+	}
+	_ambiguous_types = types{std::move(ambiguous_types)};
+
+	// value-initialized, so all atomics are nullptr
+	_objects = std::vector<std::atomic<QObject *>>(_type_index.size());
+	_ready_objects = std::vector<std::atomic<QObject *>>(_type_index.size());
+	_construction_times = std::vector<std::atomic<std::int64_t>>(_type_index.size());
+	_init_times = std::vector<std::atomic<std::int64_t>>(_type_index.size());
+	_moved_to_threads = std::vector<QThread *>(_type_index.size(), nullptr);
+	_type_mutexes.reset(new std::recursive_mutex[_type_index.size()]);
+	_visit_marks = std::vector<std::size_t>(_type_index.size(), 0);
+}
+
+void injector_core::create_plans()
+{
+	trace_span span{"create_plans"};
+
+	_plans = std::vector<instantiation_plan>(_type_index.size());
+	for (auto &&p : _available_providers)
+	{
+		auto id = _type_index.id_of(p->provided_type());
+		if (id == type_index::invalid_id)
+			continue;
+
+		auto &plan = _plans[id];
+		for (auto &&required_type : p->required_types())
+		{
+			// not validated configuration can have unavailable required types, these are skipped
+			auto required_id = _type_index.id_of(required_type);
+			if (required_id != type_index::invalid_id)
+				plan.required_ids.push_back(_implementation_ids[required_id]);
+		}
+
+		for (auto &&interface_type : extract_interfaces(p->provided_type()))
+		{
+			auto interface_id = _type_index.id_of(interface_type);
+			if (interface_id != type_index::invalid_id)
+				plan.interface_ids.push_back(interface_id);
+		}
+	}
+
+	for (auto &&mapped_dependencies : _types_model.mapped_dependencies())
+	{
+		// dependencies are also mapped for supertypes of implementation types, these are not needed
+		auto id = _type_index.id_of(mapped_dependencies.dependent_type());
+		if (id == type_index::invalid_id || _implementation_ids[id] != id)
+			continue;
+
+		auto dependencies_plan = make_plan(mapped_dependencies.dependency_list());
+		_plans[id].dependency_ids = std::move(dependencies_plan.dependency_ids);
+		_plans[id].setters = std::move(dependencies_plan.setters);
+	}
+}
+
+injector_core::instantiation_plan injector_core::make_plan(const dependencies &object_dependencies) const
+{
+	auto &&available_types = _types_model.available_types();
+	auto result = instantiation_plan{};
+	result.dependency_ids.reserve(object_dependencies.size());
+	result.setters.reserve(object_dependencies.size());
+
+	// both are sorted by type and ids are assigned in order of available types, so id of matched type
+	// is its position in available types - one merge pass resolves all dependencies without lookups
+	match(object_dependencies, available_types, type_from_dependency, type_from_implemented_by,
+		[&](const dependency &object_dependency, const implemented_by &available_type){
+			auto resolved_with = static_cast<type_id>(&available_type - &*std::begin(available_types));
+			assert(_type_index.type_of(resolved_with) == available_type.interface_type());
+
+			result.dependency_ids.push_back(_implementation_ids[resolved_with]);
+			result.setters.push_back(planned_setter{object_dependency.setter(), resolved_with});
+		},
+		match_ignore{},
+		match_ignore{},
+		match_increment_mode::left);
+
+	return result;
+}
+
+injector_core::instantiation_plan injector_core::make_injection_plan(const QMetaObject *meta_object) const
+{
+	auto result = make_plan(extract_dependencies(_known_types, type{meta_object}));
+	result.metadata = &type_metadata_for(type{meta_object});
+	return result;
+}
+
+const injector_core::instantiation_plan & injector_core::injection_plan_for(const QMetaObject *meta_object)
+{
+	// frozen plans are never modified, types that were not known at freeze() still use lock
+	if (_frozen->load(std::memory_order_acquire))
+	{
+		auto it = _frozen_injection_plans.find(meta_object);
+		if (it != std::end(_frozen_injection_plans))
+			return it->second;
+	}
+
+	// references to elements of unordered_map stay valid after insertions
+	std::lock_guard<std::mutex> lock{*_state_mutex};
+	auto it = _injection_plans.find(meta_object);
+	if (it != std::end(_injection_plans))
+		return it->second;
+
+	auto plan = make_injection_plan(meta_object);
+	return _injection_plans.emplace(meta_object, std::move(plan)).first->second;
+}
+
+bool injector_core::is_instantiated(const type &interface_type) const
+{
+	auto id = _type_index.id_of(interface_type);
+	return id != type_index::invalid_id && _ready_objects[id].load(std::memory_order_acquire) != nullptr;
 }
 
 std::vector<type> injector_core::provided_types() const
@@ -105,37 +381,92 @@ std::vector<type> injector_core::provided_types() const
 	return result;
 }
 
-void injector_core::instantiate(const type &interface_type)
+void injector_core::instantiate(const type &interface_type, QThread *object_thread)
 {
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	auto object_it = _objects.get(interface_type);
-	if (object_it == end(_objects))
-		instantiate_interface(interface_type);
+	if (!is_instantiated(interface_type))
+		instantiate_interface(interface_type, object_thread);
 }
 
 void injector_core::instantiate_all_with_type_role(const std::string &type_role)
 {
+	auto implementation_ids = std::vector<type_id>{};
 	for (auto &&provider : _available_providers)
 	{
 		auto type = provider->provided_type();
 		if (has_type_role(type, type_role))
-			instantiate_interface(type);
+			implementation_ids.push_back(implementation_id_for(type));
 	}
+
+	instantiate_all(non_instantiated(implementation_ids));
+}
+
+void injector_core::instantiate_all()
+{
+	instantiate_all(non_instantiated(provided_implementation_ids()));
+}
+
+void injector_core::instantiate_all_in_parallel()
+{
+	instantiate_all(non_instantiated(provided_implementation_ids()), nullptr, construction_mode::parallel);
 }
 
-QObject * injector_core::get(const type &interface_type)
+QObject * injector_core::get(const type &interface_type, QThread *object_thread)
 {
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	instantiate(interface_type);
-	return _objects.get(interface_type)->object();
+	if (_frozen->load(std::memory_order_acquire))
+	{
+		if (auto result = _frozen_objects.get(interface_type))
+			return result;
+		if (_type_index.id_of(interface_type) == type_index::invalid_id)
+			throw_not_configured(interface_type);
+		throw exception::injector_frozen{interface_type.name()};
+	}
+
+	auto id = _type_index.id_of(interface_type);
+	if (id == type_index::invalid_id)
+		throw_not_configured(interface_type);
+
+	if (auto result = _ready_objects[id].load(std::memory_order_acquire))
+		return result;
+
+	auto implementation_id = _implementation_ids[id];
+	instantiate_implementation(implementation_id, object_thread);
+	if (auto result = _ready_objects[id].load(std::memory_order_acquire))
+		return result;
+
+	// INJEQT_INIT methods can get other objects of their batch, which is published only when it is finished,
+	// other threads only get published objects
+	if (is_instantiated_by_current_thread(this, implementation_id))
+		return _objects[id].load(std::memory_order_acquire);
+	// objects of batch that failed after these were stored are never published
+	throw exception::instantiation_failed{interface_type.name()};
 }
 
 std::vector<QObject *> injector_core::get_all_with_type_role(const std::string &type_role)
 {
+	if (_frozen->load(std::memory_order_acquire))
+	{
+		auto ids = _frozen_type_roles.find(type_role);
+		if (ids == std::end(_frozen_type_roles))
+			return {};
+
+		auto result = std::vector<QObject *>{};
+		result.reserve(ids->second.size());
+		for (auto &&id : ids->second)
+		{
+			auto object = _ready_objects[id].load(std::memory_order_acquire);
+			if (!object)
+				throw exception::injector_frozen{_type_index.type_of(id).name()};
+			result.push_back(object);
+		}
+		return result;
+	}
+
 	auto result = std::vector<QObject *>{};
 	for (auto &&provider : _available_providers)
 	{
@@ -147,167 +478,703 @@ std::vector<QObject *> injector_core::get_all_with_type_role(const std::string &
 	return result;
 }
 
-void injector_core::instantiate_interface(const type &interface_type)
+void injector_core::instantiate_interface(const type &interface_type, QThread *object_thread)
 {
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	instantiate_implementation(implementation_for(interface_type));
+	instantiate_implementation(implementation_id_for(interface_type), object_thread);
 }
 
-type injector_core::implementation_for(const type &interface_type) const
+type_id injector_core::implementation_id_for(const type &interface_type) const
 {
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	auto implementation_type_it = _types_model.available_types().get(interface_type);
-	if (implementation_type_it == end(_types_model.available_types()))
-		throw exception::unknown_type{interface_type.name()};
-	return implementation_type_it->implementation_type();
+	auto id = _type_index.id_of(interface_type);
+	if (id == type_index::invalid_id)
+		throw_not_configured(interface_type);
+
+	assert(_implementation_ids[id] != type_index::invalid_id);
+	return _implementation_ids[id];
+}
+
+void injector_core::instantiate_implementation(type_id implementation_id, QThread *object_thread)
+{
+	assert(implementation_id < _plans.size());
+
+	instantiate_all(non_instantiated(std::vector<type_id>{implementation_id}), object_thread);
 }
 
-void injector_core::instantiate_implementation(const type &implementation_type)
+std::vector<type_id> injector_core::non_instantiated(const std::vector<type_id> &implementation_ids)
 {
-	assert(!implementation_type.is_empty());
-	assert(!implementation_type.is_qobject());
+	auto result = std::vector<type_id>{};
+	if (_frozen->load(std::memory_order_acquire))
+	{
+		for (auto &&id : implementation_ids)
+			if (!_ready_objects[id].load(std::memory_order_acquire))
+				result.push_back(id);
+		return result;
+	}
 
-	auto types_to_instantiate = required_to_satisfy(implementation_type_dependencies(implementation_type), _types_model, _objects);
-	types_to_instantiate.add(implementation_type);
-	instantiate_all(types_to_instantiate);
+	std::lock_guard<std::mutex> lock{*_state_mutex};
+	reset_visit_marks();
+	for (auto &&id : implementation_ids)
+		add_non_instantiated(id, result);
+	return result;
 }
 
-dependencies injector_core::implementation_type_dependencies(const type &implementation_type) const
+void injector_core::add_non_instantiated(type_id implementation_id, std::vector<type_id> &result)
 {
-	assert(!implementation_type.is_empty());
-	assert(!implementation_type.is_qobject());
+	auto to_check = std::vector<type_id>{implementation_id};
+	while (!to_check.empty())
+	{
+		auto current_id = to_check.back();
+		to_check.pop_back();
+
+		// objects stored, but not ready yet are added too - these may be still being created by other thread
+		if (_ready_objects[current_id].load(std::memory_order_acquire) || _visit_marks[current_id] == _visit_generation)
+			continue;
 
-	return _types_model.mapped_dependencies().contains_key(implementation_type)
-			? _types_model.mapped_dependencies().get(implementation_type)->dependency_list()
-			: dependencies{};
+		_visit_marks[current_id] = _visit_generation;
+		result.push_back(current_id);
+
+		auto &&dependency_ids = _plans[current_id].dependency_ids;
+		to_check.insert(std::end(to_check), std::begin(dependency_ids), std::end(dependency_ids));
+	}
 }
 
-void injector_core::instantiate_all(const types &interface_types)
+void injector_core::reset_visit_marks()
 {
-	instantiate_required_types_for(interface_types);
+	if (++_visit_generation != 0)
+		return;
 
-	auto provided_objects = provide_objects(providers_for(non_instantiated(interface_types)));
-	_objects.merge(implementations{objects_to_store(extract_implementations(provided_objects))});
-	resolve_objects(objects_to_resolve(provided_objects));
+	// generation counter wrapped, old marks could match new generation
+	std::fill(std::begin(_visit_marks), std::end(_visit_marks), 0);
+	_visit_generation = 1;
+}
+
+bool injector_core::is_configured(const type &interface_type) const
+{
+	return _type_index.id_of(interface_type) != type_index::invalid_id;
 }
 
-void injector_core::instantiate_required_types_for(const types &types_to_instantiate)
+type injector_core::configured_type(const std::string &type_name) const
 {
-	for (auto &&provider : providers_for(types_to_instantiate))
-		for (auto &&required_type : provider->required_types())
-			instantiate_interface(required_type);
+	auto it = _known_types.get(type_name);
+	if (it == std::end(_known_types) || !is_configured(*it))
+		return type{};
+	return *it;
 }
 
-std::vector<type> injector_core::non_instantiated(const types &to_filter) const
+std::vector<type> injector_core::instantiation_order(const type &interface_type) const
 {
+	assert(!interface_type.is_empty());
+	assert(!interface_type.is_qobject());
+
 	auto result = std::vector<type>{};
-	result.reserve(to_filter.size());
-	for (auto &&type : to_filter)
-		if (_objects.get(type) == end(_objects))
-			result.push_back(type);
+	auto visited = std::vector<bool>(_plans.size(), false);
+	// depth first walk, each id is stored with index of next of its required types and dependencies to visit
+	auto to_visit = std::vector<std::pair<type_id, std::size_t>>{};
+	auto visit = [&](type_id id){
+		if (visited[id] || _ready_objects[id].load(std::memory_order_acquire))
+			return;
+		visited[id] = true;
+		to_visit.emplace_back(id, 0);
+	};
+
+	visit(implementation_id_for(interface_type));
+	while (!to_visit.empty())
+	{
+		auto &current = to_visit.back();
+		auto &&plan = _plans[current.first];
+		auto index = current.second++;
+		if (index < plan.required_ids.size())
+			visit(plan.required_ids[index]);
+		else if (index < plan.required_ids.size() + plan.dependency_ids.size())
+			visit(plan.dependency_ids[index - plan.required_ids.size()]);
+		else
+		{
+			result.push_back(_type_index.type_of(current.first));
+			to_visit.pop_back();
+		}
+	}
+
 	return result;
 }
 
-std::vector<provided_object> injector_core::provide_objects(const std::vector<provider *> &providers)
+std::vector<type_id> injector_core::provided_implementation_ids() const
 {
-	auto result = std::vector<provided_object>{};
-	result.reserve(providers.size());
-	for (auto &&provider : providers)
+	auto result = std::vector<type_id>{};
+	result.reserve(_available_providers.size());
+	for (auto &&provider : _available_providers)
 	{
-		auto instance = provider->provide(*this);
-		auto i = make_implementation(provider->provided_type(), instance);
-		result.push_back(provided_object{provider, i});
+		auto id = _type_index.id_of(provider->provided_type());
+		if (id != type_index::invalid_id)
+			result.push_back(_implementation_ids[id]);
 	}
 	return result;
 }
 
-std::vector<implementation> injector_core::objects_to_resolve(const std::vector<provided_object> &provided_objects) const
+void injector_core::instantiate_all(std::vector<type_id> implementation_ids, QThread *object_thread, construction_mode mode)
 {
-	auto result = std::vector<implementation>{};
-	result.reserve(provided_objects.size());
-	for (auto &&provided_object : provided_objects)
-		if (provided_object.provided_by()->require_resolving())
-			result.push_back(provided_object.object());
+	if (implementation_ids.empty())
+		return;
+
+	if (_frozen->load(std::memory_order_acquire))
+		throw exception::injector_frozen{frozen_message(implementation_ids)};
+
+	std::sort(std::begin(implementation_ids), std::end(implementation_ids));
+
+	// invalid type is reported before any object of batch is created, as it would be by constructor
+	if (_validation == validation_level::deferred)
+		for (auto &&id : implementation_ids)
+			if (!_objects[id].load(std::memory_order_acquire))
+				validate_type(id);
+
+	trusted_scope trusted{_validation == validation_level::trusted};
+
+	// required types are instantiated before any lock of this batch is taken, all of them in one batch
+	auto required_ids = std::vector<type_id>{};
+	for (auto &&id : implementation_ids)
+		for (auto &&required_id : _plans[id].required_ids)
+			if (!_ready_objects[required_id].load(std::memory_order_acquire))
+				required_ids.push_back(required_id);
+	if (!required_ids.empty())
+		instantiate_all(non_instantiated(required_ids), object_thread, mode);
+
+	// locks are always taken in order of ids, recursive locks allow INJEQT_INIT methods to use injector
+	auto locks = std::vector<std::unique_lock<std::recursive_mutex>>{};
+	locks.reserve(implementation_ids.size());
+	for (auto &&id : implementation_ids)
+		locks.emplace_back(_type_mutexes[id]);
+
+	// required types could be dependencies too and other threads could create some objects before locks
+	// were taken, so some objects could be already created
+	auto new_ids = std::vector<type_id>{};
+	new_ids.reserve(implementation_ids.size());
+	for (auto &&id : implementation_ids)
+		if (!_objects[id].load(std::memory_order_relaxed))
+		{
+			assert(_providers[id] != nullptr);
+			new_ids.push_back(id);
+		}
+
+	// freeze() takes all locks, so batch that waited for it does not create objects after it
+	if (!new_ids.empty() && _frozen->load(std::memory_order_acquire))
+		throw exception::injector_frozen{frozen_message(new_ids)};
+
+	batch_scope batch{this, &new_ids};
+
+	// all providers are prepared first, so independent asynchronous factories run at the same time
+	for (auto &&id : new_ids)
+		_providers[id]->prepare(*this);
+
+	auto provided_objects = provide_all(new_ids, mode);
+	auto new_objects = std::vector<implementation>{};
+	new_objects.reserve(new_ids.size());
+	for (decltype(new_ids.size()) i = 0; i < new_ids.size(); i++)
+		new_objects.push_back(make_implementation(_type_index.type_of(new_ids[i]), provided_objects[i]));
+
+	for (decltype(new_ids.size()) i = 0; i < new_ids.size(); i++)
+		store_object(new_ids[i], new_objects[i].object());
+
+	// setters and INJEQT_INIT methods of objects bound to other thread are called in that thread
+	auto ids_to_resolve = std::vector<type_id>{};
+	auto objects_to_resolve = std::vector<implementation>{};
+	auto threads_to_resolve = std::vector<QThread *>{};
+	ids_to_resolve.reserve(new_ids.size());
+	objects_to_resolve.reserve(new_objects.size());
+	threads_to_resolve.reserve(new_objects.size());
+	for (decltype(new_ids.size()) i = 0; i < new_ids.size(); i++)
+		if (_providers[new_ids[i]]->require_resolving())
+		{
+			auto &&plan = _plans[new_ids[i]];
+			auto object = new_objects[i].object();
+			auto thread = _providers[new_ids[i]]->object_thread();
+			call_in_thread(thread, [&](){ resolve_object(plan, object); });
+			ids_to_resolve.push_back(new_ids[i]);
+			objects_to_resolve.push_back(new_objects[i]);
+			threads_to_resolve.push_back(thread);
+		}
+
+	// asynchronous INJEQT_INIT methods run at the same time, they are started after inits of dependencies and
+	// object only waits for inits of its own dependencies
+	auto inits = std::vector<QFuture<void>>(objects_to_resolve.size());
+	for (auto &&i : init_order(ids_to_resolve))
+	{
+		for (auto &&dependency_id : _plans[ids_to_resolve[i]].dependency_ids)
+		{
+			auto dependency = std::lower_bound(std::begin(ids_to_resolve), std::end(ids_to_resolve), dependency_id);
+			if (dependency != std::end(ids_to_resolve) && *dependency == dependency_id)
+				inits[dependency - std::begin(ids_to_resolve)].waitForFinished();
+		}
+
+		auto object = objects_to_resolve[i].object();
+		auto start = std::chrono::steady_clock::now();
+		call_in_thread(threads_to_resolve[i], [&](){ inits[i] = call_init_methods(object); });
+		auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		_init_times[ids_to_resolve[i]].store(duration, std::memory_order_relaxed);
+	}
+
+	for (auto &&init : inits)
+		init.waitForFinished();
+
+	{
+		std::lock_guard<std::mutex> lock{*_state_mutex};
+		_resolved_objects.insert(std::end(_resolved_objects), std::begin(objects_to_resolve), std::end(objects_to_resolve));
+	}
+
+	// only objects created by this thread can be moved, so objects of types bound to thread are left alone, and
+	// ready objects and objects of parent injector are owned by someone else, so these are left alone too
+	if (object_thread && object_thread != QThread::currentThread())
+		for (decltype(new_ids.size()) i = 0; i < new_ids.size(); i++)
+		{
+			auto kind = _providers[new_ids[i]]->kind();
+			if (kind != provider_kind::default_constructor && kind != provider_kind::factory)
+				continue;
+
+			auto object = new_objects[i].object();
+			if (object->thread() == QThread::currentThread() && !object->parent())
+			{
+				object->moveToThread(object_thread);
+				_moved_to_threads[new_ids[i]] = object_thread;
+			}
+		}
+
+	for (decltype(new_ids.size()) i = 0; i < new_ids.size(); i++)
+		publish_object(new_ids[i], new_objects[i].object());
+}
+
+std::vector<QObject *> injector_core::provide_all(const std::vector<type_id> &implementation_ids, construction_mode mode)
+{
+	auto result = std::vector<QObject *>(implementation_ids.size(), nullptr);
+	if (mode == construction_mode::parallel)
+	{
+		// objects of types bound to thread are constructed in that thread by current thread, as it could
+		// be current thread itself, which does not process events while it waits for pool
+		auto parallel_indexes = std::vector<std::size_t>{};
+		for (decltype(implementation_ids.size()) i = 0; i < implementation_ids.size(); i++)
+		{
+			auto provider = _providers[implementation_ids[i]];
+			if (provider->can_provide_in_any_thread() && !provider->object_thread())
+				parallel_indexes.push_back(i);
+		}
+
+		auto current_thread = QThread::currentThread();
+		call_in_thread_pool(parallel_indexes.size(), [&](std::size_t index){
+			auto i = parallel_indexes[index];
+			auto object = provide(implementation_ids[i]);
+			// only thread that object lives in can move it
+			if (object->thread() != current_thread)
+				object->moveToThread(current_thread);
+			result[i] = object;
+		});
+	}
+
+	for (decltype(implementation_ids.size()) i = 0; i < implementation_ids.size(); i++)
+		if (!result[i])
+			result[i] = provide(implementation_ids[i]);
+
 	return result;
 }
 
-std::vector<implementation> injector_core::extract_implementations(const std::vector<provided_object> &provided_objects) const
+QObject * injector_core::provide(type_id implementation_id)
 {
-	auto result = std::vector<implementation>{};
-	result.reserve(provided_objects.size());
-	for (auto &&provided_object : provided_objects)
-		result.push_back(provided_object.object());
+	auto provider = _providers[implementation_id];
+	trace_span span{"provide", provider->provided_type()};
+
+	auto start = std::chrono::steady_clock::now();
+	auto result = provider->provide(*this);
+	auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	_construction_times[implementation_id].store(duration, std::memory_order_relaxed);
 	return result;
 }
 
-std::vector<implementation> injector_core::objects_to_store(const std::vector<implementation> &objects) const
+void injector_core::store_object(type_id implementation_id, QObject *object)
 {
-	auto result = std::vector<implementation>{};
-	for (auto &&object : objects)
+	// each interface has only one implementation, so only thread holding its lock writes here
+	for (auto &&id : _plans[implementation_id].interface_ids)
+		if (!_objects[id].load(std::memory_order_relaxed))
+			_objects[id].store(object, std::memory_order_release);
+}
+
+void injector_core::publish_object(type_id implementation_id, QObject *object)
+{
+	for (auto &&id : _plans[implementation_id].interface_ids)
+		if (_objects[id].load(std::memory_order_relaxed) == object)
+			_ready_objects[id].store(object, std::memory_order_release);
+}
+
+std::vector<std::size_t> injector_core::init_order(const std::vector<type_id> &implementation_ids) const
+{
+	auto result = std::vector<std::size_t>{};
+	result.reserve(implementation_ids.size());
+	auto visited = std::vector<bool>(implementation_ids.size(), false);
+	// the same depth first walk as in instantiation_order(const type &), but only over dependencies in batch
+	auto to_visit = std::vector<std::pair<std::size_t, std::size_t>>{};
+	auto visit = [&](type_id id){
+		auto found = std::lower_bound(std::begin(implementation_ids), std::end(implementation_ids), id);
+		if (found == std::end(implementation_ids) || *found != id)
+			return;
+		auto index = static_cast<std::size_t>(found - std::begin(implementation_ids));
+		if (visited[index])
+			return;
+		visited[index] = true;
+		to_visit.emplace_back(index, 0);
+	};
+
+	for (auto &&id : implementation_ids)
 	{
-		auto interfaces = extract_interfaces(object.interface_type());
-		auto matched = match(interfaces, _types_model.available_types()).matched;
-		for (auto &&m : matched)
+		visit(id);
+		while (!to_visit.empty())
 		{
-			auto i = implementation{m.first, object.object()}; // no need to check preconditions again with make_implementation
-			result.emplace_back(i);
+			auto &current = to_visit.back();
+			auto &&dependency_ids = _plans[implementation_ids[current.first]].dependency_ids;
+			auto index = current.second++;
+			if (index < dependency_ids.size())
+				visit(dependency_ids[index]);
+			else
+			{
+				result.push_back(current.first);
+				to_visit.pop_back();
+			}
 		}
 	}
+
 	return result;
 }
 
-void injector_core::resolve_objects(const std::vector<implementation> &objects)
+QThread * injector_core::running_object_thread(type_id implementation_id) const
 {
+	auto thread = _moved_to_threads[implementation_id] ? _moved_to_threads[implementation_id] : _providers[implementation_id]->object_thread();
+	return thread && thread->isRunning() ? thread : nullptr;
+}
+
+void injector_core::resolve_object(const instantiation_plan &plan, QObject *object) const
+{
+	trusted_scope trusted{_validation == validation_level::trusted};
+	for (auto &&planned : plan.setters)
+	{
+		auto resolved_with = _objects[planned.resolved_with].load(std::memory_order_acquire);
+		assert(resolved_with != nullptr);
+		if (!resolved_with)
+			continue;
+
+		trace_span span{"INJEQT_SET", planned.setter.meta_method()};
+		planned.setter.invoke(object, resolved_with);
+	}
+}
+
+void injector_core::inject_into(QObject *object)
+{
+	auto &&plan = injection_plan_for(object->metaObject());
+
+	instantiate_all(non_instantiated(plan.dependency_ids));
+	resolve_object(plan, object);
+	call_init_methods(object, *plan.metadata).waitForFinished();
+}
+
+void injector_core::inject_into(const std::vector<QObject *> &objects)
+{
+	// plans are computed first, so invalid setter of any object is reported before anything is instantiated
+	auto plans = std::vector<const instantiation_plan *>{};
+	plans.reserve(objects.size());
 	for (auto &&object : objects)
-		resolve_object(object);
-	for (auto &&object : objects)
-		call_init_methods(object.object());
-	_resolved_objects.merge(implementations{objects});
+	{
+		assert(object != nullptr);
+		plans.push_back(&injection_plan_for(object->metaObject()));
+	}
+
+	auto dependency_ids = std::vector<type_id>{};
+	for (auto &&plan : plans)
+		dependency_ids.insert(std::end(dependency_ids), std::begin(plan->dependency_ids), std::end(plan->dependency_ids));
+
+	instantiate_all(non_instantiated(dependency_ids));
+	auto inits = std::vector<QFuture<void>>{};
+	inits.reserve(objects.size());
+	for (decltype(objects.size()) i = 0; i < objects.size(); i++)
+	{
+		resolve_object(*plans[i], objects[i]);
+		inits.push_back(call_init_methods(objects[i], *plans[i]->metadata));
+	}
+
+	for (auto &&init : inits)
+		init.waitForFinished();
 }
 
-void injector_core::resolve_object(const implementation &object) const
+void injector_core::freeze()
 {
-	auto object_dependencies = implementation_type_dependencies(object.interface_type());
-	resolve_object(object_dependencies, object);
+	auto root_types = std::vector<type>{};
+	root_types.reserve(_available_providers.size());
+	std::transform(std::begin(_available_providers), std::end(_available_providers), std::back_inserter(root_types), type_from_provider);
+	freeze(root_types);
 }
 
-void injector_core::resolve_object(const dependencies &object_dependencies, const implementation &object) const
+void injector_core::freeze(const std::vector<type> &root_types)
 {
-	auto resolved_dependencies = resolve_dependencies(object_dependencies, _objects);
-	assert(resolved_dependencies.unresolved.empty());
+	for (auto &&root_type : root_types)
+		instantiate(root_type);
 
-	for (auto &&resolved : resolved_dependencies.resolved)
+	// plans of known types that can not be injected are computed again by injection_plan_for(), which
+	// reports their errors
+	auto injection_plans = std::unordered_map<const QMetaObject *, instantiation_plan>{};
+	for (auto &&known_type : _known_types)
+		try
+		{
+			injection_plans.emplace(known_type.meta_object(), make_injection_plan(known_type.meta_object()));
+		}
+		catch (exception::exception &)
+		{
+		}
+
+	// batches hold locks of their types until their objects are published, so these are waited for and
+	// batches that take locks later see that injector is frozen
+	auto locks = std::vector<std::unique_lock<std::recursive_mutex>>{};
+	locks.reserve(_type_index.size());
+	for (auto id = type_id{0}; id < _type_index.size(); id++)
+		locks.emplace_back(_type_mutexes[id]);
+
+	auto objects = std::vector<std::pair<type, QObject *>>{};
+	for (auto id = type_id{0}; id < _type_index.size(); id++)
+		if (auto object = _ready_objects[id].load(std::memory_order_acquire))
+			objects.emplace_back(_type_index.type_of(id), object);
+
+	auto type_roles = std::unordered_map<std::string, std::vector<type_id>>{};
+	for (auto &&provider : _available_providers)
 	{
-		assert(implements(object.interface_type(), resolved.setter().object_type()));
-		resolved.apply_on(object.object());
+		auto id = _type_index.id_of(provider->provided_type());
+		if (id == type_index::invalid_id)
+			continue;
+		// the same role can be assigned by many classes in hierarchy
+		for (auto &&type_role : type_metadata_for(provider->provided_type()).type_roles())
+		{
+			auto &&ids = type_roles[type_role];
+			if (ids.empty() || ids.back() != id)
+				ids.push_back(id);
+		}
 	}
+
+	std::lock_guard<std::mutex> lock{*_state_mutex};
+	if (_frozen->load(std::memory_order_relaxed))
+		return;
+
+	// plans already used by unregistered types are copied, as references to them can be still used
+	for (auto &&injection_plan : _injection_plans)
+		injection_plans.insert(injection_plan);
+
+	_frozen_objects = frozen_object_table{objects};
+	_frozen_type_roles = std::move(type_roles);
+	_frozen_injection_plans = std::move(injection_plans);
+	_frozen->store(true, std::memory_order_release);
 }
 
-void injector_core::inject_into(QObject *object)
+std::string injector_core::frozen_message(const std::vector<type_id> &implementation_ids) const
+{
+	auto result = std::string{};
+	for (auto &&id : implementation_ids)
+	{
+		result.append(_type_index.type_of(id).name());
+		result.append("\n");
+	}
+	return result;
+}
+
+bool injector_core::is_frozen() const
+{
+	return _frozen->load(std::memory_order_acquire);
+}
+
+dependency_graph injector_core::make_dependency_graph() const
+{
+	auto to_microseconds = [](const std::atomic<std::int64_t> &nanoseconds){ return nanoseconds.load(std::memory_order_relaxed) / 1000; };
+	auto name_of = [this](type_id id){ return _type_index.type_of(id).name(); };
+
+	auto result = dependency_graph{};
+	auto parent_injectors = std::vector<injector_impl *>{};
+	for (auto id = type_id{0}; id < _type_index.size(); id++)
+	{
+		auto provider = _providers[id];
+		if (!provider || _implementation_ids[id] != id)
+			continue;
+
+		auto node = dependency_graph_node{name_of(id), std::string{}, {}, type_metadata_for(_type_index.type_of(id)).type_roles(), false, -1, -1};
+		for (auto interface_id = type_id{0}; interface_id < _type_index.size(); interface_id++)
+			if (interface_id != id && _implementation_ids[interface_id] == id)
+				node.interfaces.push_back(name_of(interface_id));
+
+		// times are written before object is published
+		if (_ready_objects[id].load(std::memory_order_acquire))
+		{
+			node.instantiated = true;
+			node.construction_time = to_microseconds(_construction_times[id]);
+			if (provider->require_resolving())
+				node.init_time = to_microseconds(_init_times[id]);
+		}
+
+		switch (provider->kind())
+		{
+			case provider_kind::default_constructor:
+				node.kind = "default_constructor";
+				break;
+			case provider_kind::factory:
+				node.kind = "factory";
+				break;
+			case provider_kind::ready:
+				node.kind = "ready";
+				break;
+			case provider_kind::parent_injector:
+			{
+				node.kind = "parent_injector";
+				auto parent_injector = static_cast<provider_by_parent_injector *>(provider)->parent_injector();
+				auto parent = std::find(std::begin(parent_injectors), std::end(parent_injectors), parent_injector);
+				if (parent == std::end(parent_injectors))
+				{
+					parent_injectors.push_back(parent_injector);
+					parent = std::end(parent_injectors) - 1;
+				}
+				auto parent_name = "parent injector " + std::to_string(parent - std::begin(parent_injectors) + 1);
+				result.edges.push_back(dependency_graph_edge{node.name, parent_name, "parent_injector", std::string{}});
+				break;
+			}
+		}
+
+		for (auto &&planned : _plans[id].setters)
+			result.edges.push_back(dependency_graph_edge{node.name, name_of(_implementation_ids[planned.resolved_with]), "setter", planned.setter.signature()});
+		for (auto &&required_id : _plans[id].required_ids)
+			result.edges.push_back(dependency_graph_edge{node.name, name_of(required_id), "factory", std::string{}});
+
+		result.nodes.push_back(std::move(node));
+	}
+
+	for (decltype(parent_injectors.size()) i = 0; i < parent_injectors.size(); i++)
+		result.nodes.push_back(dependency_graph_node{"parent injector " + std::to_string(i + 1), "injector", {}, {}, false, -1, -1});
+
+	return result;
+}
+
+std::int64_t injector_core::measured_time(type_id implementation_id) const
+{
+	// times are written before object is published
+	if (!_ready_objects[implementation_id].load(std::memory_order_acquire))
+		return 0;
+
+	auto nanoseconds = _construction_times[implementation_id].load(std::memory_order_relaxed) + _init_times[implementation_id].load(std::memory_order_relaxed);
+	return nanoseconds / 1000;
+}
+
+critical_path injector_core::find_critical_path(const type &interface_type) const
+{
+	assert(!interface_type.is_empty());
+	assert(!interface_type.is_qobject());
+
+	return find_critical_path(implementation_id_for(interface_type));
+}
+
+critical_path injector_core::find_critical_path(type_id implementation_id) const
+{
+	auto visited = std::vector<bool>(_plans.size(), false);
+	auto finished = std::vector<bool>(_plans.size(), false);
+	auto longest = std::vector<std::int64_t>(_plans.size(), 0);
+	auto next = std::vector<type_id>(_plans.size(), type_index::invalid_id);
+	auto total_time = std::int64_t{0};
+
+	// depth first walk as in instantiation_order(), longest chain of each id is known when it is finished
+	auto to_visit = std::vector<std::pair<type_id, std::size_t>>{};
+	auto visit = [&](type_id id){
+		if (visited[id])
+			return;
+		visited[id] = true;
+		total_time += measured_time(id);
+		to_visit.emplace_back(id, 0);
+	};
+
+	visit(implementation_id);
+	while (!to_visit.empty())
+	{
+		auto &current = to_visit.back();
+		auto &&plan = _plans[current.first];
+		auto index = current.second++;
+		if (index < plan.required_ids.size())
+			visit(plan.required_ids[index]);
+		else if (index < plan.required_ids.size() + plan.dependency_ids.size())
+			visit(plan.dependency_ids[index - plan.required_ids.size()]);
+		else
+		{
+			auto id = current.first;
+			// not finished ids are still on stack, so edges to them close a cycle
+			auto follow_longest = [&](type_id child_id){
+				if (finished[child_id] && (next[id] == type_index::invalid_id || longest[child_id] > longest[next[id]]))
+					next[id] = child_id;
+			};
+			std::for_each(std::begin(plan.required_ids), std::end(plan.required_ids), follow_longest);
+			std::for_each(std::begin(plan.dependency_ids), std::end(plan.dependency_ids), follow_longest);
+
+			longest[id] = measured_time(id) + (next[id] == type_index::invalid_id ? 0 : longest[next[id]]);
+			finished[id] = true;
+			to_visit.pop_back();
+		}
+	}
+
+	auto result = critical_path{{}, {}, longest[implementation_id], total_time, total_time - longest[implementation_id]};
+	for (auto id = implementation_id; id != type_index::invalid_id; id = next[id])
+	{
+		result.types.push_back(_type_index.type_of(id).name());
+		result.times.push_back(measured_time(id));
+	}
+	return result;
+}
+
+std::vector<critical_path> injector_core::find_critical_paths() const
 {
-	auto object_implementation = implementation{type{object->metaObject()}, object};
-	auto dependencies = extract_dependencies(_known_types, object_implementation.interface_type());
-	auto types_to_instantiate = required_to_satisfy(dependencies, _types_model, _objects);
-	instantiate_all(types_to_instantiate);
-	resolve_object(dependencies, object_implementation);
-	call_init_methods(object);
+	auto is_dependency = std::vector<bool>(_plans.size(), false);
+	for (auto id = type_id{0}; id < _plans.size(); id++)
+		if (_ready_objects[id].load(std::memory_order_acquire))
+		{
+			for (auto &&required_id : _plans[id].required_ids)
+				is_dependency[required_id] = true;
+			for (auto &&dependency_id : _plans[id].dependency_ids)
+				is_dependency[dependency_id] = true;
+		}
+
+	auto result = std::vector<critical_path>{};
+	for (auto id = type_id{0}; id < _plans.size(); id++)
+		if (_providers[id] && _implementation_ids[id] == id && !is_dependency[id] && _ready_objects[id].load(std::memory_order_acquire))
+			result.push_back(find_critical_path(id));
+
+	std::stable_sort(std::begin(result), std::end(result), [](const critical_path &x, const critical_path &y){
+		return x.path_time > y.path_time;
+	});
+	return result;
 }
 
-void injector_core::call_init_methods(QObject *object) const
+QFuture<void> injector_core::call_init_methods(QObject *object) const
 {
-	for (auto action : extract_actions("INJEQT_INIT", type{object->metaObject()}))
-		action.invoke(object);
+	return call_init_methods(object, type_metadata_for(type{object->metaObject()}));
+}
+
+QFuture<void> injector_core::call_init_methods(QObject *object, const type_metadata &metadata) const
+{
+	// each INJEQT_INIT method can depend on work of methods of its supertypes
+	auto result = QFuture<void>{};
+	for (auto &&action : metadata.init_actions())
+	{
+		result.waitForFinished();
+		trace_span span{"INJEQT_INIT", action.meta_method()};
+		result = action.invoke_async(object);
+	}
+	return result;
 }
 
 void injector_core::call_done_methods(QObject *object) const
 {
-	auto done_actions = extract_actions("INJEQT_DONE", type{object->metaObject()});
+	// object is destroyed right after INJEQT_DONE methods, so these can not run in background
+	auto &&done_actions = type_metadata_for(type{object->metaObject()}).done_actions();
 	for (auto i = done_actions.rbegin(), e = done_actions.rend(); i != e; ++i)
-		i->invoke(object);
+	{
+		trace_span span{"INJEQT_DONE", i->meta_method()};
+		i->invoke_async(object).waitForFinished();
+	}
 }
 
 }}
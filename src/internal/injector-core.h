@@ -20,15 +20,29 @@
 
 #pragma once
 
+#include <injeqt/critical-path.h>
+#include <injeqt/injector-options.h>
 #include <injeqt/injeqt.h>
 #include <injeqt/type.h>
 
+#include "dependency-graph.h"
+#include "frozen-object-table.h"
 #include "implementations.h"
 #include "providers.h"
+#include "setter-method.h"
+#include "type-index.h"
+#include "types.h"
 #include "types-by-name.h"
 #include "types-model.h"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
+#include <QtCore/QFuture>
 #include <QtCore/QObject>
 
 /**
@@ -36,9 +50,11 @@
  * @brief Contains classes and functions for implementation of injector core.
  */
 
+class QThread;
+
 namespace injeqt { namespace internal {
 
-class provided_object;
+class type_metadata;
 
 /**
  * @brief Implementation of injector class.
@@ -51,8 +67,35 @@ class provided_object;
  * resolved dependencies.
  *
  * Injector keeps list of all configured providers and of all already created objects.
- * Two methods objects_with(implementations, const type &) and objects_with(implementations, const types &)
- * are used to update list of already created objects with new ones.
+ *
+ * Each type available in injector gets dense id from type_index on construction. Implementation
+ * type, provider and created object of each type are stored in flat arrays indexed by these ids,
+ * so checking for and storing an object are O(1) operations.
+ *
+ * Dependencies, setters and interfaces of each implementation type are also computed once and stored
+ * as instantiation_plan. Instantiating an object walks these plans over types that are not yet
+ * instantiated and then executes them, without looking into types_model.
+ *
+ * get(), instantiate() and inject_into() can be called from many threads at once. Objects are
+ * published only after all their setters and INJEQT_INIT methods were called, and getting already
+ * published object is a lock-free read. Each type has its own lock taken when its object is created.
+ * Locks of all types created together are taken in order of ids, so threads can create independent
+ * parts of graph at the same time. Locks are recursive, so INJEQT_INIT methods and factories can use
+ * the injector, but if these methods in two threads need objects that other thread is creating,
+ * a deadlock is possible - just as with function-local statics initialized from each other.
+ *
+ * Setters and INJEQT_INIT methods of objects which provider has provider::object_thread() are called
+ * in that thread with call_in_thread(), while the requesting thread holds locks and waits.
+ * INJEQT_DONE methods of these objects are called in the same way on destruction.
+ *
+ * instantiate_all_in_parallel() works in waves. Types required by providers of a batch are instantiated as
+ * separate batch before it, so each batch only needs objects that are already published. Providers that
+ * return true from provider::can_provide_in_any_thread() are then called from threads of QThreadPool while
+ * current thread holds locks of the batch. Setters and INJEQT_INIT methods are not called in pool threads.
+ *
+ * After freeze() no new objects are created. Objects are then looked up in frozen_object_table
+ * and objects with type roles in a precomputed map, so get() and get_all_with_type_role() do not
+ * use any lock or shared mutable state.
  */
 class INJEQT_API injector_core final
 {
@@ -69,6 +112,8 @@ public:
 	/**
 	 * @brief Create injector configured with set of providers.
 	 * @param all_providers set of all providers available to injector
+	 * @param validation how much of configuration is validated by constructor
+	 * @param model_cache_file file with validated types_model, empty to disable cache
 	 * @see injector::injector(std::vector<std::unique_ptr<module>>)
 	 * @throw ambiguous_types if one or more types in @p providers is ambiguous
 	 * @throw unresolvable_dependencies if a type with unresolvable dependency is found in @p providers
@@ -82,8 +127,18 @@ public:
 	 *
 	 * This constructor creates types_model object to get all required information from providers. This object
 	 * takes ownership of passed providers.
+	 *
+	 * If @p model_cache_file is not empty and contains model written for the same known types and providers,
+	 * model is read from it and is not validated again. Otherwise model is created, validated and written to
+	 * @p model_cache_file for next injectors. Errors of reading and writing the file are ignored. Model is only
+	 * written by injector_core with validation_level::strict.
+	 *
+	 * With validation_level::deferred ambiguous types, unavailable required types and unresolvable dependencies
+	 * are reported by methods that create object of invalid type. With validation_level::trusted these are not
+	 * reported at all and expensive debug assertions are skipped.
 	 */
-	explicit injector_core(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&all_providers);
+	explicit injector_core(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&all_providers,
+		validation_level validation = validation_level::strict, const std::string &model_cache_file = std::string{});
 
 	injector_core(const injector_core &) = delete;
 	injector_core(injector_core &&) = default;
@@ -109,13 +164,17 @@ public:
 	/**
 	 * @brief Instantiates object of given type @p interface_type
 	 * @param interface_type type of object to instantiate.
+	 * @param object_thread thread to move newly created objects to, nullptr means they stay in current thread
 	 * @throw unknown_type if @p interface_type was not configured in injector
 	 * @throw instantiation_failed if instantiation of one of required types failed
 	 * @pre !interface_type.is_empty()
 	 * @pre !interface_type.is_qobject()
 	 * @see injector::get<T>()
+	 *
+	 * Objects are moved to @p object_thread after their INJEQT_INIT methods are called and before
+	 * other threads can get them. Objects of types bound to a thread and objects with parent are not moved.
 	 */
-	void instantiate(const type &interface_type);
+	void instantiate(const type &interface_type, QThread *object_thread = nullptr);
 
 	/**
 	 * @brief Instantiate all objects with given @p type_role.
@@ -123,16 +182,59 @@ public:
 	 */
 	void instantiate_all_with_type_role(const std::string &type_role);
 
+	/**
+	 * @brief Instantiate objects of all configured types.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 * @throw injector_frozen if injector is frozen and some of types were not instantiated before freeze
+	 * @see injector::instantiate_all()
+	 */
+	void instantiate_all();
+
+	/**
+	 * @return true if @p interface_type is available in injector
+	 */
+	bool is_configured(const type &interface_type) const;
+
+	/**
+	 * @return type available in injector with name @p type_name or empty type if there is no such type
+	 */
+	type configured_type(const std::string &type_name) const;
+
+	/**
+	 * @brief Return implementation types of @p interface_type and of all its not instantiated dependencies.
+	 * @throw unknown_type if @p interface_type was not configured in injector
+	 * @pre !interface_type.is_empty()
+	 * @pre !interface_type.is_qobject()
+	 *
+	 * Each type is placed after its dependencies and types required by its provider, unless they depend
+	 * on each other. Calling instantiate(const type &, QThread *) for each of them in order creates one
+	 * new object in most of calls.
+	 */
+	std::vector<type> instantiation_order(const type &interface_type) const;
+
+	/**
+	 * @brief Instantiate objects of all configured types, constructing them in QThreadPool.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 * @throw injector_frozen if injector is frozen and some of types were not instantiated before freeze
+	 * @see injector::instantiate_all_in_parallel()
+	 */
+	void instantiate_all_in_parallel();
+
 	/**
 	 * @brief Returns pointer to object of given type @p interface_type
 	 * @param interface_type type of object to return.
+	 * @param object_thread thread to move newly created objects to, nullptr means they stay in current thread
 	 * @throw unknown_type if @p interface_type was not configured in injector
 	 * @throw instantiation_failed if instantiation of one of required types failed
 	 * @pre !interface_type.is_empty()
 	 * @pre !interface_type.is_qobject()
 	 * @see injector::get<T>()
+	 * @see instantiate(const type &, QThread *)
+	 *
+	 * Only objects with finished INJEQT_INIT methods are returned, except to INJEQT_INIT methods called
+	 * for objects created together with returned one.
 	 */
-	QObject * get(const type &interface_type);
+	QObject * get(const type &interface_type, QThread *object_thread = nullptr);
 
 	/**
 	 * @brief Returns all objects with given @p type_role.
@@ -156,12 +258,167 @@ public:
 	 */
 	void inject_into(QObject *object);
 
+	/**
+	 * @brief Inject dependencies into all @p objects.
+	 * @param objects objects to inject dependencies into.
+	 * @throw invalid_setter if any tagged setter has parameter that is not a QObject-derived pointer
+	 * @throw invalid_setter if any tagged setter has parameter that is a QObject pointer
+	 * @throw invalid_setter if any tagged setter has parameter that is a QObject-derived pointer of not configured type
+	 * @throw invalid_setter if any tagged setter has other number of parameters than one
+	 * @pre all objects are not nullptr
+	 *
+	 * Works like calling inject_into(QObject *) for each object, but dependencies missing for all objects are
+	 * instantiated at once before any setter is called.
+	 */
+	void inject_into(const std::vector<QObject *> &objects);
+
+	/**
+	 * @brief Instantiate all configured types and make injector immutable.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 * @see injector::freeze()
+	 */
+	void freeze();
+
+	/**
+	 * @brief Instantiate @p root_types with all dependencies and make injector immutable.
+	 * @param root_types types to instantiate before freezing
+	 * @throw unknown_type if any of @p root_types was not configured in injector
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 * @see injector::freeze(const std::vector<type> &)
+	 *
+	 * Waits for objects that other threads are instantiating, so these are frozen too. Objects that other
+	 * threads start to instantiate later are not created and injector_frozen is thrown for them.
+	 */
+	void freeze(const std::vector<type> &root_types);
+
+	/**
+	 * @return true if freeze() was called
+	 */
+	bool is_frozen() const;
+
+	/**
+	 * @brief Return graph of all configured types with their dependencies and measured times.
+	 * @see injector::save_dependency_graph_dot(const std::string &)
+	 *
+	 * Times of construction and of INJEQT_INIT methods are measured for each object created by injector_core
+	 * and are reported for published objects.
+	 */
+	dependency_graph make_dependency_graph() const;
+
+	/**
+	 * @brief Return longest chain of dependencies of @p interface_type weighted with measured times.
+	 * @throw unknown_type if @p interface_type was not configured in injector
+	 * @pre !interface_type.is_empty()
+	 * @pre !interface_type.is_qobject()
+	 * @see injector::find_critical_path(const type &)
+	 *
+	 * Path starts with implementation type of @p interface_type. Each type is followed by the most expensive
+	 * chain of its dependencies and types required by its provider. Edges that close a cycle of dependencies
+	 * are skipped.
+	 */
+	critical_path find_critical_path(const type &interface_type) const;
+
+	/**
+	 * @brief Return critical paths of all instantiated types that are not dependencies of other instantiated types.
+	 * @see injector::find_critical_paths()
+	 *
+	 * Paths are sorted by path_time, the longest first. Types that are only depended on in a cycle are not roots.
+	 */
+	std::vector<critical_path> find_critical_paths() const;
+
 private:
+	/**
+	 * @brief How objects of one batch are constructed.
+	 */
+	enum class construction_mode
+	{
+		/**
+		 * @brief All providers are called from current thread.
+		 */
+		sequential,
+
+		/**
+		 * @brief Providers that can provide in any thread are called from QThreadPool.
+		 */
+		parallel
+	};
+
+	/**
+	 * @brief Setter to call on new object with id of object to pass to it.
+	 */
+	struct planned_setter
+	{
+		setter_method setter;
+		type_id resolved_with;
+	};
+
+	/**
+	 * @brief Steps required to instantiate one implementation type.
+	 *
+	 * Plans are computed from _types_model once, on construction of injector_core. All types are
+	 * replaced with ids, so instantiating an object does not need to look into _types_model.
+	 */
+	struct instantiation_plan
+	{
+		/**
+		 * @brief Ids of implementations of types returned by provider::required_types().
+		 */
+		std::vector<type_id> required_ids;
+
+		/**
+		 * @brief Ids of implementations of all dependencies.
+		 */
+		std::vector<type_id> dependency_ids;
+
+		/**
+		 * @brief Ids of all interfaces new object is stored under.
+		 */
+		std::vector<type_id> interface_ids;
+
+		/**
+		 * @brief All setters to call on new object, in order of dependencies.
+		 */
+		std::vector<planned_setter> setters;
+
+		/**
+		 * @brief Metadata of injected type, only set by make_injection_plan(const QMetaObject *).
+		 *
+		 * INJEQT_INIT methods of injected objects are found with it, without lookup in shared metadata cache.
+		 */
+		const type_metadata *metadata;
+	};
+
 	types_by_name _known_types;
+	validation_level _validation;
 	providers _available_providers;
-	implementations _objects;
-	implementations _resolved_objects;
 	types_model _types_model;
+	type_index _type_index;
+	std::vector<type_id> _implementation_ids;
+	std::vector<provider *> _providers;
+	// provided types that are not indexed, possible only if configuration was not validated
+	types _ambiguous_types;
+	std::vector<instantiation_plan> _plans;
+	std::vector<std::atomic<QObject *>> _objects;
+	std::vector<std::atomic<QObject *>> _ready_objects;
+	// in nanoseconds, written before object is published
+	std::vector<std::atomic<std::int64_t>> _construction_times;
+	std::vector<std::atomic<std::int64_t>> _init_times;
+	// thread that object was moved to after it was created, written before object is published
+	std::vector<QThread *> _moved_to_threads;
+	std::unique_ptr<std::recursive_mutex[]> _type_mutexes;
+	std::vector<std::size_t> _visit_marks;
+	std::size_t _visit_generation;
+	std::vector<implementation> _resolved_objects;
+	std::unordered_map<const QMetaObject *, instantiation_plan> _injection_plans;
+
+	// guards _visit_marks, _visit_generation, _resolved_objects and _injection_plans
+	std::unique_ptr<std::mutex> _state_mutex;
+
+	// _frozen_objects, _frozen_type_roles and _frozen_injection_plans are written once, before _frozen is set
+	std::unique_ptr<std::atomic<bool>> _frozen;
+	frozen_object_table _frozen_objects;
+	std::unordered_map<std::string, std::vector<type_id>> _frozen_type_roles;
+	std::unordered_map<const QMetaObject *, instantiation_plan> _frozen_injection_plans;
 
 	/**
 	 * @brief Extract all provided types and makes a types_model from them.
@@ -173,135 +430,238 @@ private:
 	 * @throw invalid_setter if any tagged setter has parameter that is not a QObject-derived pointer
 	 * @throw invalid_setter if any tagged setter has parameter that is a QObject pointer
 	 * @throw invalid_setter if any tagged setter has other number of parameters than one
+	 *
+	 * Ambiguous types and unresolvable dependencies are only reported with validation_level::strict.
 	 */
 	types_model create_types_model() const;
 
 	/**
-	 * @brief Return type that implements @p interface_type.
+	 * @brief Check that all types required by providers are available in _types_model.
+	 * @throw unavailable_required_types if any type required by any provider is not available
+	 */
+	void validate_required_types() const;
+
+	/**
+	 * @brief Check that all types required by provider and all dependencies of @p implementation_id are available.
+	 * @throw unavailable_required_types if any type required by provider of @p implementation_id is not available
+	 * @throw unresolvable_dependencies if any dependency of @p implementation_id is not available
+	 *
+	 * Used with validation_level::deferred, when these were not checked by constructor.
+	 */
+	void validate_type(type_id implementation_id) const;
+
+	/**
+	 * @brief Throw exception for @p interface_type that is not configured.
+	 * @throw ambiguous_types if @p interface_type is provided, but ambiguous
+	 * @throw unknown_type otherwise
+	 */
+	void throw_not_configured(const type &interface_type) const;
+
+	/**
+	 * @brief Assign ids to all types from _types_model and fill flat arrays indexed by them.
+	 *
+	 * Ids are assigned in order of types, so sorting ids gives the same order as sorting types.
+	 */
+	void index_types();
+
+	/**
+	 * @brief Compute instantiation_plan for each implementation type from _types_model.
+	 */
+	void create_plans();
+
+	/**
+	 * @brief Return plan with dependency ids and setters for @p object_dependencies.
+	 */
+	instantiation_plan make_plan(const dependencies &object_dependencies) const;
+
+	/**
+	 * @brief Compute plan of injecting into object of type @p meta_object.
+	 * @throw invalid_setter if any tagged setter of @p meta_object is invalid
+	 */
+	instantiation_plan make_injection_plan(const QMetaObject *meta_object) const;
+
+	/**
+	 * @brief Return plan of injecting into object of type @p meta_object.
+	 * @throw invalid_setter if any tagged setter of @p meta_object is invalid
+	 *
+	 * Plans are computed on first use and kept for lifetime of injector_core, so injecting into many objects
+	 * of the same type only calls setters and INJEQT_INIT methods. Plans of all known types are computed by
+	 * freeze(), so frozen injector_core returns these without taking any lock.
+	 */
+	const instantiation_plan & injection_plan_for(const QMetaObject *meta_object);
+
+	/**
+	 * @return message of injector_frozen listing types of @p implementation_ids
+	 */
+	std::string frozen_message(const std::vector<type_id> &implementation_ids) const;
+
+	/**
+	 * @return true if object of @p interface_type is already available
+	 */
+	bool is_instantiated(const type &interface_type) const;
+
+	/**
+	 * @brief Return id of type that implements @p interface_type.
+	 * @throw ambiguous_types if @p interface_type is ambiguous and was not validated by constructor
 	 * @throw unknown_type if @p interface_type does not have corresponding implementation
 	 */
-	type implementation_for(const type &interface_type) const;
+	type_id implementation_id_for(const type &interface_type) const;
 
 	/**
 	 * @brief Instantiate class of interface type @p interface_type and makes it available for use.
 	 * @param interface_type type of interface of object to create
+	 * @param object_thread thread to move newly created objects to, nullptr means they stay in current thread
 	 * @throw instantiation_failed if instantiation of one of required types failed
 	 * @throw unknown_type if @p interface_type does not have corresponding implementation
 	 *
 	 * Instantiate class of interface type @p interface_type with all of its dependencies, then resolves them and
 	 * calls INJEQT_INIT slots.
 	 */
-	void instantiate_interface(const type &interface_type);
+	void instantiate_interface(const type &interface_type, QThread *object_thread = nullptr);
 
 	/**
-	 * @brief Instantiate class of type @p implementation_type and makes it available for use.
-	 * @param interface_type type of interface of object to create
+	 * @brief Instantiate class of type with @p implementation_id and makes it available for use.
+	 * @param implementation_id id of type of object to create
+	 * @param object_thread thread to move newly created objects to, nullptr means they stay in current thread
 	 * @throw instantiation_failed if instantiation of one of required types failed
 	 *
-	 * Instantiate class of exact type @p implementation_type with all of its dependencies, then resolves them and
+	 * Instantiate class of exact type with @p implementation_id with all of its dependencies, then resolves them and
 	 * calls INJEQT_INIT slots.
 	 */
-	void instantiate_implementation(const type &implementation_type);
+	void instantiate_implementation(type_id implementation_id, QThread *object_thread = nullptr);
 
 	/**
-	 * @brief Return all dependencies for @p implementation_type.
+	 * @brief Return @p implementation_ids and all their not instantiated dependencies.
+	 *
+	 * When injector is frozen returns only not instantiated ids from @p implementation_ids without
+	 * walking dependencies and without taking any lock.
 	 */
-	dependencies implementation_type_dependencies(const type &implementation_type) const;
+	std::vector<type_id> non_instantiated(const std::vector<type_id> &implementation_ids);
 
 	/**
-	 * @brief Instantiate classes of interface types from @p interface_types and makes them available for use.
-	 * @param interface_types types of interfaces of objects to create
-	 * @throw instantiation_failed if instantiation of one of required types failed
-	 * @pre No class from @p interface_types contains dependency that is not already resolved or not in @p interface_types
+	 * @brief Add @p implementation_id and all its not instantiated dependencies to @p result.
 	 *
-	 * Instantiate all classes of interface type @p interface_types without looking for dependencies.
+	 * Walks plans of dependencies and stops at already instantiated types - all dependencies of these
+	 * are already instantiated too. Each id is added only once. Requires _state_mutex to be locked.
 	 */
-	void instantiate_all(const types &interface_types);
+	void add_non_instantiated(type_id implementation_id, std::vector<type_id> &result);
 
 	/**
-	 * @brief Instantiate classes that are required before instantiating any of @p types_to_instantiate.
-	 * @param types_to_instantiate types that are checked for list of required types
-	 * @throw instantiation_failed if instantiation of one of required types failed
+	 * @brief Start new walk for add_non_instantiated(type_id, std::vector<type_id> &).
 	 *
-	 * Instantiate all classes that are returned from @see provider::required_type() methods of any provider
-	 * for these types.
+	 * Requires _state_mutex to be locked.
 	 */
-	void instantiate_required_types_for(const types &types_to_instantiate);
+	void reset_visit_marks();
 
 	/**
-	 * @brief Return list of providers required to instantiate types from @p for_types.
+	 * @return ids of implementations of all types provided by _available_providers
 	 */
-	template<typename T>
-	std::vector<provider *> providers_for(const T &for_types) const
-	{
-		auto result = std::vector<provider *>{};
-		result.reserve(for_types.size());
-		for (auto &&for_type : for_types)
-		{
-			auto provider_it = _available_providers.get(for_type);
-			assert(provider_it != end(_available_providers));
+	std::vector<type_id> provided_implementation_ids() const;
 
-			result.push_back(provider_it->get());
-		}
+	/**
+	 * @brief Instantiate classes with @p implementation_ids and makes them available for use.
+	 * @param implementation_ids ids of types of objects to create
+	 * @param object_thread thread to move newly created objects to, nullptr means they stay in current thread
+	 * @param mode how objects are constructed
+	 * @throw instantiation_failed if instantiation of one of required types failed
+	 * @throw injector_frozen if @p implementation_ids is not empty and injector is frozen
+	 * @pre No class from @p implementation_ids contains dependency that is not already resolved or not in @p implementation_ids
+	 *
+	 * Types required by providers are instantiated first, as one batch with the same @p mode. Then classes are
+	 * instantiated in order of types, then all setters are called, then all INJEQT_INIT slots. Then objects are
+	 * moved to @p object_thread and published.
+	 */
+	void instantiate_all(std::vector<type_id> implementation_ids, QThread *object_thread = nullptr, construction_mode mode = construction_mode::sequential);
 
-		return result;
-	}
+	/**
+	 * @brief Call provider::provide(injector_core &) of types with @p implementation_ids.
+	 * @return provided objects, in order of @p implementation_ids
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 *
+	 * In construction_mode::parallel providers that can provide in any thread are called from QThreadPool
+	 * and their objects are moved to current thread, unless these were created in thread bound to type.
+	 * Other providers are called from current thread after that.
+	 */
+	std::vector<QObject *> provide_all(const std::vector<type_id> &implementation_ids, construction_mode mode);
 
 	/**
-	 * @brief Filter list of types from @p to_filter to include only non already instantiated types.
+	 * @brief Call provider::provide(injector_core &) of type with @p implementation_id and store its duration.
+	 * @return provided object
+	 * @throw instantiation_failed if instantiation of type failed
 	 */
-	std::vector<type> non_instantiated(const types &to_filter) const;
+	QObject * provide(type_id implementation_id);
 
 	/**
-	 * @brief Instantiate types with @p providers.
+	 * @return measured time of construction and INJEQT_INIT methods of type with @p implementation_id in microseconds
+	 *
+	 * Returns 0 for types without published object.
 	 */
-	std::vector<provided_object> provide_objects(const std::vector<provider *> &providers);
+	std::int64_t measured_time(type_id implementation_id) const;
 
 	/**
-	 * @brief Return objects that needs resolving from @p provided_objects.
-	 * @see provider::require_resolving()
+	 * @return critical path of type with @p implementation_id
 	 */
-	std::vector<implementation> objects_to_resolve(const std::vector<provided_object> &provided_objects) const;
+	critical_path find_critical_path(type_id implementation_id) const;
 
 	/**
-	 * @brief Extract implementations from vector of @p provided_object.
+	 * @brief Store @p object in list of instantiated objects.
+	 *
+	 * Implementation object is stored under all unique inferfaces it implements, so it is later avaialble
+	 * under all these types.
 	 */
-	std::vector<implementation> extract_implementations(const std::vector<provided_object> &provided_objects) const;
+	void store_object(type_id implementation_id, QObject *object);
 
 	/**
-	 * @brief Return objects to store in list of instantiated objects.
+	 * @brief Make stored @p object available to lock-free lookups under all its inferfaces.
 	 *
-	 * Each implementation object is returned with set of @see implementation instances that contains all unique inferfaces
-	 * for that object, so it is later avaialble under all types it implements.
+	 * Called after all setters and INJEQT_INIT methods of @p object were called.
 	 */
-	std::vector<implementation> objects_to_store(const std::vector<implementation> &objects) const;
+	void publish_object(type_id implementation_id, QObject *object);
 
 	/**
-	 * @brief Resolve all @p objects dependencies, call all INJEQT_INIT slots and add types to list of resolved objects.
+	 * @return thread that object of @p implementation_id lives in, if it is still running, nullptr otherwise
 	 *
-	 * This method assumes that all object dependencies are already instantiated.
+	 * Only threads known to injector are returned: thread that type is bound to or thread that object was
+	 * moved to by instantiate_all(std::vector<type_id>, QThread *, construction_mode). Objects created in
+	 * threads of QThreadPool are not moved anywhere and are finished by thread that destroys injector.
 	 */
-	void resolve_objects(const std::vector<implementation> &objects);
+	QThread * running_object_thread(type_id implementation_id) const;
 
 	/**
-	 * @brief Resolve all @p object dependencies.
+	 * @brief Call all setters from @p plan on @p object.
 	 *
 	 * This method assumes that all object dependencies are already instantiated.
 	 */
-	void resolve_object(const implementation &object) const;
+	void resolve_object(const instantiation_plan &plan, QObject *object) const;
 
 	/**
-	 * @brief Resolve all @p object dependencies with @p object_dependencies.
+	 * @return indexes of @p implementation_ids in order that INJEQT_INIT methods of their objects are started in
+	 * @pre @p implementation_ids is sorted
+	 *
+	 * Each index is placed after indexes of its dependencies from @p implementation_ids, unless they depend
+	 * on each other, so object can wait for asynchronous INJEQT_INIT methods of its dependencies.
 	 */
-	void resolve_object(const dependencies &object_dependencies, const implementation &object) const;
+	std::vector<std::size_t> init_order(const std::vector<type_id> &implementation_ids) const;
 
 	/**
 	 * @brief Call all INJEQT_INIT methods on given object in proper order.
+	 * @return future of last INJEQT_INIT method
+	 *
+	 * INJEQT_INIT method can return QFuture<void>. Each method is called after future of previous
+	 * one finishes. Future of last one is not waited for.
 	 */
-	void call_init_methods(QObject *object) const;
+	QFuture<void> call_init_methods(QObject *object) const;
+
+	/**
+	 * @brief Call all INJEQT_INIT methods from @p metadata on given object in proper order.
+	 * @see call_init_methods(QObject *)
+	 */
+	QFuture<void> call_init_methods(QObject *object, const type_metadata &metadata) const;
 
 	/**
 	 * @brief Call all INJEQT_DONE methods on given object in proper order.
+	 *
+	 * Futures returned by INJEQT_DONE methods are waited for.
 	 */
 	void call_done_methods(QObject *object) const;
 
@@ -20,74 +20,300 @@
 
 #include "injector-impl.h"
 
+#include <injeqt/exception/injector-frozen.h>
+#include <injeqt/exception/not-supported.h>
 #include <injeqt/exception/unknown-type.h>
 #include <injeqt/module.h>
 
+#include "async-exception.h"
 #include "containers.h"
+#include "critical-path-report.h"
 #include "interfaces-utils.h"
 #include "provider-by-default-constructor.h"
 #include "provider-by-parent-injector-configuration.h"
+#include "provider-configurations.h"
 #include "provider-ready.h"
 #include "provider.h"
 #include "module-impl.h"
-#include "required-to-satisfy.h"
-#include "resolve-dependencies.h"
-#include "resolved-dependency.h"
+#include "module-plugin-loader.h"
+#include "thread-call.h"
+#include "trace-recorder.h"
+#include "type-metadata.h"
+#include "type-role.h"
 
+#include <QtCore/QThread>
+#include <algorithm>
 #include <cassert>
+#include <fstream>
+#include <limits>
+#include <sstream>
 
 namespace injeqt { namespace internal {
 
-injector_impl::injector_impl()
+namespace {
+
+void add_parent_injector_configurations(std::vector<std::shared_ptr<provider_configuration>> &configurations, const std::vector<injector_impl *> &super_injectors)
+{
+	for (auto &&super_injector : super_injectors)
+		for (auto &&provided_type : super_injector->provided_types())
+			configurations.push_back(std::make_shared<provider_by_parent_injector_configuration>(super_injector, provided_type));
+}
+
+void add_setter_type_names(const type &t, std::vector<std::string> &result)
+{
+	for (auto &&setter : type_metadata_for(t).setter_candidates())
+		if (!setter.parameter_pointer_name.empty())
+			// remove trailing '*'
+			result.push_back(setter.parameter_pointer_name.substr(0, setter.parameter_pointer_name.size() - 1));
+}
+
+std::vector<std::string> setter_type_names(const std::vector<QObject *> &objects)
+{
+	auto result = std::vector<std::string>{};
+	for (auto &&object : objects)
+		add_setter_type_names(type{object->metaObject()}, result);
+	return result;
+}
+
+/**
+ * @return names of types that objects configured by @p configurations can depend on or be ambiguous with
+ */
+std::vector<std::string> related_type_names(const std::vector<std::shared_ptr<provider_configuration>> &configurations)
+{
+	auto result = std::vector<std::string>{};
+	for (auto &&configuration : configurations)
+		for (auto &&t : configuration->types())
+		{
+			for (auto &&interface_type : extract_interfaces(t))
+				result.push_back(interface_type.name());
+			add_setter_type_names(t, result);
+		}
+	return result;
+}
+
+injector_core make_core(const std::vector<std::shared_ptr<provider_configuration>> &provider_configurations,
+	validation_level validation = validation_level::strict, const std::string &model_cache_file = std::string{})
+{
+	auto known_types = make_known_types(provider_configurations);
+	auto providers = make_providers(provider_configurations, known_types);
+
+	return injector_core{known_types, std::move(providers), validation, model_cache_file};
+}
+
+// for cores that live as long as injector_impl, so these do not have to be kept alive by callers
+template<typename T>
+std::shared_ptr<T> unowned(T &core)
 {
+	return std::shared_ptr<T>{std::shared_ptr<T>{}, &core};
 }
 
-injector_impl::injector_impl(std::vector<std::unique_ptr<module>> modules) :
+}
+
+injector_impl::injector_impl() :
+	_validation{validation_level::strict},
+	_async_calls{0}
+{
+}
+
+injector_impl::injector_impl(std::vector<std::unique_ptr<module>> modules, injector_options options) :
 	// modules are only stored because these can own objects used by injector
-	_modules{std::move(modules)}
+	_modules{std::move(modules)},
+	_validation{options.validation},
+	_async_calls{0}
 {
-	init(std::vector<injector_impl *>{});
+	init(std::vector<injector_impl *>{}, options);
 }
 
-injector_impl::injector_impl(std::vector<injector_impl *> super_injectors, std::vector<std::unique_ptr<module>> modules) :
+injector_impl::injector_impl(std::vector<injector_impl *> super_injectors, std::vector<std::unique_ptr<module>> modules, injector_options options) :
 	// modules are only stored because these can own objects used by injector
-	_modules{std::move(modules)}
+	_modules{std::move(modules)},
+	_validation{options.validation},
+	_async_calls{0}
 {
-	init(super_injectors);
+	init(super_injectors, options);
 }
 
-void injector_impl::init(std::vector<injector_impl *> super_injectors)
+injector_impl::injector_impl(std::vector<std::shared_ptr<provider_configuration>> configurations, validation_level validation) :
+	_validation{validation},
+	_async_calls{0}
 {
+	trace_span span{"injector_impl::activate"};
+
+	_core = make_core(configurations, _validation);
+}
+
+injector_impl::~injector_impl()
+{
+	{
+		std::unique_lock<std::mutex> lock{_async_mutex};
+		_async_finished.wait(lock, [this](){ return _async_calls == 0; });
+	}
+
+	_warm_up_scheduler.reset();
+	// aggregate segment only uses objects of other segments, objects of newer segments can use objects of older ones
+	_aggregate.reset();
+	while (!_segments.empty())
+		_segments.pop_back();
+}
+
+void injector_impl::init(std::vector<injector_impl *> super_injectors, const injector_options &options)
+{
+	trace_span span{"injector_impl::init"};
+
+	auto plugins = std::vector<plugin_declaration>{};
+	// loaded modules are appended to _modules, so plugins of these are loaded too
+	for (decltype(_modules.size()) i = 0; i < _modules.size(); i++)
+		for (auto &&plugin : _modules[i]->_pimpl->plugins())
+			if (options.lazy)
+				plugins.push_back(plugin);
+			else
+				_modules.push_back(load_module_plugin(plugin.file_name));
+
 	auto extract_provider_configurations_lambda = [](const std::unique_ptr<module> &m){ return m->_pimpl->provider_configurations(); };
 	auto extract_provider_configurations = std::function<std::vector<std::shared_ptr<provider_configuration>>(const std::unique_ptr<module> &)>{extract_provider_configurations_lambda};
 	auto provider_configurations = extract(_modules, extract_provider_configurations);
+	add_parent_injector_configurations(provider_configurations, super_injectors);
 
-	for (auto &&super_injector : super_injectors)
-		for (auto &&provided_type : super_injector->provided_types())
-			provider_configurations.push_back(std::make_shared<provider_by_parent_injector_configuration>(super_injector, provided_type));
+	if (!options.lazy)
+	{
+		_core = make_core(provider_configurations, _validation, options.model_cache_file);
+		// kept for validate_all()
+		if (_validation != validation_level::strict)
+			_configurations = std::move(provider_configurations);
+		return;
+	}
 
-	auto extract_types_lamdba = [](const std::shared_ptr<provider_configuration> &pc){
-		auto result = std::vector<type>{};
-		for (auto &&t : pc->types())
-		{
-			auto interfaces = extract_interfaces(t);
-			std::copy(std::begin(interfaces), std::end(interfaces), std::back_inserter(result));
-		}
+	_lazy.reset(new lazy_configuration{std::move(provider_configurations), std::move(plugins)});
+}
+
+std::shared_ptr<injector_core> injector_impl::core()
+{
+	if (!_lazy)
+		return unowned(_core);
+
+	auto result = aggregate();
+	return std::shared_ptr<injector_core>{result, &result->_core};
+}
+
+std::shared_ptr<const injector_core> injector_impl::core() const
+{
+	if (!_lazy)
+		return unowned(_core);
+
+	auto result = aggregate();
+	return std::shared_ptr<const injector_core>{result, &result->_core};
+}
+
+std::shared_ptr<injector_core> injector_impl::core_for(const type &interface_type)
+{
+	if (!_lazy)
+		return unowned(_core);
+
+	if (auto owner = owner_of(interface_type.name()))
+		return unowned(owner->_core);
+	activate(std::vector<std::string>{interface_type.name()});
+	if (auto owner = owner_of(interface_type.name()))
+		return unowned(owner->_core);
+	return core();
+}
+
+injector_impl * injector_impl::owner_of(const std::string &type_name) const
+{
+	std::lock_guard<std::mutex> lock{_owners_mutex};
+	auto owners = _owners.find(type_name);
+	return owners != std::end(_owners) && owners->second.size() == 1 ? owners->second.front().first : nullptr;
+}
+
+std::shared_ptr<injector_impl> injector_impl::aggregate() const
+{
+	if (auto result = std::atomic_load(&_aggregate))
 		return result;
-	};
-	auto extract_types = std::function<std::vector<type>(const std::shared_ptr<provider_configuration> &)>{extract_types_lamdba};
-	auto known_types = types_by_name{extract(provider_configurations, extract_types)};
 
-	auto create_provider_lambda = [&known_types](const std::shared_ptr<provider_configuration> &pc){ return pc->create_provider(known_types); };
-	auto create_provider = std::function<std::unique_ptr<provider>(std::shared_ptr<provider_configuration>)>{create_provider_lambda};
-	auto providers = transform(provider_configurations, create_provider);
+	std::lock_guard<std::mutex> lock{_lazy_mutex};
+	if (auto result = std::atomic_load(&_aggregate))
+		return result;
+
+	auto configurations = std::vector<std::shared_ptr<provider_configuration>>{};
+	configurations.reserve(_activated.size());
+	for (auto &&activated : _activated)
+		configurations.push_back(std::make_shared<provider_by_parent_injector_configuration>(activated.first, activated.second));
+
+	auto result = std::shared_ptr<injector_impl>{new injector_impl{std::move(configurations), _validation}};
+	std::atomic_store(&_aggregate, result);
+	return result;
+}
+
+void injector_impl::ensure_not_lazy(const std::string &method) const
+{
+	if (_lazy)
+		throw exception::not_supported{method + " is not supported by lazy injector"};
+}
 
-	_core = injector_core{known_types, std::move(providers)};
+void injector_impl::activate(const std::vector<std::string> &type_names)
+{
+	activate([&type_names](lazy_configuration &lazy){ return lazy.select(type_names); });
+}
+
+void injector_impl::activate(const std::function<std::vector<std::size_t>(lazy_configuration &)> &select)
+{
+	if (!_lazy)
+		return;
+
+	std::lock_guard<std::mutex> lock{_lazy_mutex};
+	auto indexes = select(*_lazy);
+	if (indexes.empty())
+		return;
+
+	// aggregate segment can not be created again after it was frozen
+	auto aggregate = std::atomic_load(&_aggregate);
+	if (aggregate && aggregate->is_frozen())
+		throw exception::injector_frozen{_lazy->all()[indexes.front()]->types().front().name()};
+
+	auto configurations = _lazy->configurations(indexes);
+	auto activated_types = std::vector<type>{};
+	activated_types.reserve(configurations.size());
+	for (auto &&configuration : configurations)
+		activated_types.push_back(configuration->types().front());
+
+	// only types that new ones can use or be ambiguous with are added, each provided directly by its owner, so
+	// new segment does not grow with number of previous activations and objects are not passed through chains
+	auto parents = std::vector<std::pair<injector_impl *, type>>{};
+	for (auto &&type_name : related_type_names(configurations))
+	{
+		auto owners = _owners.find(type_name);
+		if (owners != std::end(_owners))
+			parents.insert(std::end(parents), std::begin(owners->second), std::end(owners->second));
+	}
+	auto by_type = [](const std::pair<injector_impl *, type> &x, const std::pair<injector_impl *, type> &y){ return x.second < y.second; };
+	auto same_type = [](const std::pair<injector_impl *, type> &x, const std::pair<injector_impl *, type> &y){ return x.second == y.second; };
+	std::sort(std::begin(parents), std::end(parents), by_type);
+	parents.erase(std::unique(std::begin(parents), std::end(parents), same_type), std::end(parents));
+	for (auto &&parent : parents)
+		configurations.push_back(std::make_shared<provider_by_parent_injector_configuration>(parent.first, parent.second));
+
+	auto segment = std::unique_ptr<injector_impl>{new injector_impl{std::move(configurations), _validation}};
+	_lazy->take(indexes);
+	{
+		std::lock_guard<std::mutex> owners_lock{_owners_mutex};
+		for (auto &&activated_type : activated_types)
+		{
+			for (auto &&interface_type : extract_interfaces(activated_type))
+				_owners[interface_type.name()].emplace_back(segment.get(), activated_type);
+			_activated.emplace_back(segment.get(), activated_type);
+		}
+	}
+	_segments.push_back(std::move(segment));
+	// calls that still use old aggregate segment keep it until they return
+	std::atomic_store(&_aggregate, std::shared_ptr<injector_impl>{});
 }
 
 std::vector<type> injector_impl::provided_types() const
 {
-	return _core.provided_types();
+	if (!_lazy)
+		return _core.provided_types();
+
+	std::lock_guard<std::mutex> lock{_lazy_mutex};
+	return _lazy->provided_types();
 }
 
 void injector_impl::instantiate(const type &interface_type)
@@ -95,12 +321,27 @@ void injector_impl::instantiate(const type &interface_type)
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	_core.instantiate(interface_type);
+	auto start = access_start();
+	core_for(interface_type)->instantiate(interface_type);
+	_access_recorder.record(interface_type, start);
 }
 
 void injector_impl::instantiate_all_with_type_role(const std::string &type_role)
 {
-	_core.instantiate_all_with_type_role(type_role);
+	activate([&type_role](lazy_configuration &lazy){ return lazy.select_with_type_role(type_role); });
+	core()->instantiate_all_with_type_role(type_role);
+}
+
+void injector_impl::instantiate_all()
+{
+	activate([](lazy_configuration &lazy){ return lazy.select_all(); });
+	core()->instantiate_all();
+}
+
+void injector_impl::instantiate_all_in_parallel()
+{
+	activate([](lazy_configuration &lazy){ return lazy.select_all(); });
+	core()->instantiate_all_in_parallel();
 }
 
 QObject * injector_impl::get(const type &interface_type)
@@ -108,19 +349,255 @@ QObject * injector_impl::get(const type &interface_type)
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	return _core.get(interface_type);
+	auto start = access_start();
+	auto result = core_for(interface_type)->get(interface_type);
+	_access_recorder.record(interface_type, start);
+	return result;
+}
+
+QFuture<void> injector_impl::instantiate_async(const type &interface_type, QThread *object_thread)
+{
+	assert(!interface_type.is_empty());
+	assert(!interface_type.is_qobject());
+
+	// objects are moved to thread that asked for them, unless other thread was chosen
+	auto thread = object_thread ? object_thread : QThread::currentThread();
+	auto future = QFutureInterface<void>{};
+	auto start = access_start();
+	call_async(future, [this, interface_type, thread, start](){
+		core_for(interface_type)->instantiate(interface_type, thread);
+		_access_recorder.record(interface_type, start);
+	});
+	return future.future();
+}
+
+void injector_impl::get_async(const type &interface_type, QThread *object_thread, QFutureInterfaceBase future, std::function<void(QObject *)> report_result)
+{
+	assert(!interface_type.is_empty());
+	assert(!interface_type.is_qobject());
+
+	auto thread = object_thread ? object_thread : QThread::currentThread();
+	auto start = access_start();
+	call_async(std::move(future), [this, interface_type, thread, report_result, start](){
+		auto result = core_for(interface_type)->get(interface_type, thread);
+		_access_recorder.record(interface_type, start);
+		report_result(result);
+	});
+}
+
+void injector_impl::call_async(QFutureInterfaceBase future, std::function<void()> call)
+{
+	{
+		std::lock_guard<std::mutex> lock{_async_mutex};
+		_async_calls++;
+	}
+
+	future.reportStarted();
+	call_in_thread_pool([this, future, call]() mutable {
+		try
+		{
+			call();
+		}
+		catch (...)
+		{
+			future.reportException(async_exception{std::current_exception()});
+		}
+		future.reportFinished();
+
+		// injector can be destroyed right after the lock is released
+		std::lock_guard<std::mutex> lock{_async_mutex};
+		_async_calls--;
+		_async_finished.notify_all();
+	});
 }
 
 std::vector<QObject *> injector_impl::get_all_with_type_role(const std::string &type_role)
 {
-	return _core.get_all_with_type_role(type_role);
+	activate([&type_role](lazy_configuration &lazy){ return lazy.select_with_type_role(type_role); });
+	return core()->get_all_with_type_role(type_role);
 }
 
 void injector_impl::inject_into(QObject *object)
 {
 	assert(object);
 
-	_core.inject_into(object);
+	if (_lazy)
+		activate(setter_type_names(std::vector<QObject *>{object}));
+
+	core()->inject_into(object);
+}
+
+void injector_impl::inject_into(const std::vector<QObject *> &objects)
+{
+	if (_lazy)
+		activate(setter_type_names(objects));
+
+	core()->inject_into(objects);
+}
+
+void injector_impl::freeze()
+{
+	activate([](lazy_configuration &lazy){ return lazy.select_all(); });
+	core()->freeze();
+	freeze_segments();
+}
+
+void injector_impl::freeze(const std::vector<type> &root_types)
+{
+	auto type_names = std::vector<std::string>{};
+	for (auto &&t : root_types)
+		type_names.push_back(t.name());
+	activate(type_names);
+
+	core()->freeze(root_types);
+	freeze_segments();
+}
+
+void injector_impl::freeze_segments()
+{
+	// objects are got from owning segments, which must not create new ones either
+	std::lock_guard<std::mutex> lock{_lazy_mutex};
+	for (auto &&segment : _segments)
+		segment->_core.freeze(std::vector<type>{});
+}
+
+bool injector_impl::is_frozen() const
+{
+	return core()->is_frozen();
+}
+
+void injector_impl::validate_all() const
+{
+	if (!_lazy)
+	{
+		if (_validation != validation_level::strict)
+			make_core(_configurations);
+		return;
+	}
+
+	auto configurations = std::vector<std::shared_ptr<provider_configuration>>{};
+	{
+		std::lock_guard<std::mutex> lock{_lazy_mutex};
+		_lazy->load_all_plugins();
+		configurations = _lazy->all();
+	}
+
+	make_core(configurations);
+}
+
+void injector_impl::warm_up(const std::vector<type> &types)
+{
+	auto type_names = std::vector<std::string>{};
+	for (auto &&t : types)
+		type_names.push_back(t.name());
+	activate(type_names);
+
+	for (auto &&t : types)
+	{
+		assert(!t.is_empty());
+		assert(!t.is_qobject());
+
+		if (!core_for(t)->is_configured(t))
+			throw exception::unknown_type{t.name()};
+	}
+
+	if (!_warm_up_scheduler)
+		_warm_up_scheduler.reset(new warm_up_scheduler{[this](const type &t){ return core_for(t); }});
+	_warm_up_scheduler->enqueue(types);
+}
+
+void injector_impl::warm_up_with_type_role(const std::string &type_role)
+{
+	auto types = std::vector<type>{};
+	for (auto &&t : provided_types())
+		if (has_type_role(t, type_role))
+			types.push_back(t);
+
+	warm_up(types);
+}
+
+void injector_impl::start_access_recording()
+{
+	_access_recorder.start();
+}
+
+bool injector_impl::save_access_recording(const std::string &file_name) const
+{
+	return write_access_records(file_name, _access_recorder.records());
+}
+
+bool injector_impl::replay_access_recording(const std::string &file_name)
+{
+	auto records = std::vector<access_record>{};
+	if (!read_access_records(file_name, records))
+		return false;
+
+	auto type_names = std::vector<std::string>{};
+	for (auto &&record : records)
+		type_names.push_back(record.type_name);
+	activate(type_names);
+
+	auto types = std::vector<type>{};
+	for (auto &&record : records)
+	{
+		auto recorded_type = core()->configured_type(record.type_name);
+		if (!recorded_type.is_empty())
+			types.push_back(recorded_type);
+	}
+
+	if (!_warm_up_scheduler)
+		_warm_up_scheduler.reset(new warm_up_scheduler{[this](const type &t){ return core_for(t); }});
+	_warm_up_scheduler->enqueue(types, std::numeric_limits<int>::max());
+	return true;
+}
+
+access_recorder::clock::time_point injector_impl::access_start() const
+{
+	return _access_recorder.is_recording() ? access_recorder::clock::now() : access_recorder::clock::time_point{};
+}
+
+bool injector_impl::save_dependency_graph_dot(const std::string &file_name) const
+{
+	ensure_not_lazy("save_dependency_graph_dot");
+	std::ofstream file{file_name, std::ios::out | std::ios::trunc};
+	if (!file)
+		return false;
+
+	write_dependency_graph_dot(file, core()->make_dependency_graph());
+	file.close();
+	return static_cast<bool>(file);
+}
+
+bool injector_impl::save_dependency_graph_json(const std::string &file_name) const
+{
+	ensure_not_lazy("save_dependency_graph_json");
+	std::ofstream file{file_name, std::ios::out | std::ios::trunc};
+	if (!file)
+		return false;
+
+	write_dependency_graph_json(file, core()->make_dependency_graph());
+	file.close();
+	return static_cast<bool>(file);
+}
+
+critical_path injector_impl::find_critical_path(const type &interface_type) const
+{
+	ensure_not_lazy("find_critical_path");
+	return core()->find_critical_path(interface_type);
+}
+
+std::vector<critical_path> injector_impl::find_critical_paths() const
+{
+	ensure_not_lazy("find_critical_paths");
+	return core()->find_critical_paths();
+}
+
+std::string injector_impl::critical_path_report() const
+{
+	ensure_not_lazy("critical_path_report");
+	std::ostringstream report;
+	write_critical_path_report(report, core()->find_critical_paths());
+	return report.str();
 }
 
 }}
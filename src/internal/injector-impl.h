@@ -21,14 +21,26 @@
 #pragma once
 
 #include <injeqt/injeqt.h>
+#include <injeqt/injector-options.h>
 #include <injeqt/type.h>
 
+#include "access-recorder.h"
 #include "implementations.h"
 #include "injector-core.h"
+#include "lazy-configuration.h"
 #include "providers.h"
 #include "types-by-name.h"
+#include "warm-up-scheduler.h"
 
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
+#include <QtCore/QFuture>
+#include <QtCore/QFutureInterface>
 #include <QtCore/QObject>
 
 /**
@@ -49,6 +61,20 @@ namespace injeqt { namespace internal {
  *
  * Its main purpose is to own all modules passed to injector constructor and to pass everthing else
  * to injector_core class.
+ *
+ * It also runs asynchronous calls in QThreadPool and waits for all of them to finish on destruction.
+ *
+ * Lazy injector_impl (see injector_options::lazy) keeps all provider configurations in lazy_configuration
+ * and does not create injector_core from them. Instead it keeps segments - non-lazy injector_impl objects.
+ * When a type that is not yet activated is needed, its configuration and configurations of its dependencies
+ * are moved to new segment. Previously activated types are only added to new segment when it can use them
+ * or be ambiguous with them, and each of them is provided directly by segment that owns it. One flat map
+ * from names of activated types and their interfaces to owning segments is used to pass calls for given type
+ * to injector_core of its owner. Calls that need all types use aggregate segment that provides all activated
+ * types from their owners. It is created when needed after activation and released by next activation, once
+ * calls that use it return. Segments are never removed before destruction of injector_impl, so objects
+ * returned earlier stay valid. Dependency graph and critical paths are not supported by lazy injector_impl,
+ * as no single injector_core knows dependencies between types of different segments.
  */
 class INJEQT_API injector_impl final
 {
@@ -77,9 +103,10 @@ public:
 	 * @throw invalid_setter if any tagged setter has other number of parameters than one
 	 *
 	 * This constructor extract all providers from all modules and creates injector_core object
-	 * with these providers.
+	 * with these providers. If @p options request lazy injector, only provider configurations are
+	 * extracted and nothing is thrown.
 	 */
-	explicit injector_impl(std::vector<std::unique_ptr<::injeqt::v1::module>> modules);
+	explicit injector_impl(std::vector<std::unique_ptr<::injeqt::v1::module>> modules, injector_options options = injector_options{});
 
 	/**
 	 * @brief Create injector configured with set of modules.
@@ -97,9 +124,15 @@ public:
 	 * @throw invalid_setter if any tagged setter has other number of parameters than one
 	 *
 	 * This constructor extract all providers from all modules and creates injector_core object
-	 * with these providers.
+	 * with these providers. If @p options request lazy injector, only provider configurations are
+	 * extracted and nothing is thrown.
+	 */
+	explicit injector_impl(std::vector<injector_impl *> super_injectors, std::vector<std::unique_ptr<::injeqt::v1::module>> modules, injector_options options = injector_options{});
+
+	/**
+	 * @brief Wait for all asynchronous calls to finish and destroy injector.
 	 */
-	explicit injector_impl(std::vector<injector_impl *> super_injectors, std::vector<std::unique_ptr<::injeqt::v1::module>> modules);
+	~injector_impl();
 
 	/**
 	 * @brief Returns list of all configured types.
@@ -126,6 +159,22 @@ public:
 	 */
 	void instantiate_all_with_type_role(const std::string &type_role);
 
+	/**
+	 * @brief Instantiate objects of all configured types.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 * @throw injector_frozen if injector is frozen and some of types were not instantiated before freeze
+	 * @see injector::instantiate_all()
+	 */
+	void instantiate_all();
+
+	/**
+	 * @brief Instantiate objects of all configured types, constructing them in QThreadPool.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 * @throw injector_frozen if injector is frozen and some of types were not instantiated before freeze
+	 * @see injector::instantiate_all_in_parallel()
+	 */
+	void instantiate_all_in_parallel();
+
 	/**
 	 * @brief Returns pointer to object of given type @p interface_type
 	 * @param interface_type type of object to return.
@@ -137,6 +186,28 @@ public:
 	 */
 	QObject * get(const type &interface_type);
 
+	/**
+	 * @brief Instantiates object of given type @p interface_type in QThreadPool.
+	 * @param interface_type type of object to instantiate.
+	 * @param object_thread thread to move new objects to, nullptr means current thread
+	 * @pre !interface_type.is_empty()
+	 * @pre !interface_type.is_qobject()
+	 * @see injector::instantiate_async<T>()
+	 */
+	QFuture<void> instantiate_async(const type &interface_type, QThread *object_thread);
+
+	/**
+	 * @brief Gets object of given type @p interface_type in QThreadPool.
+	 * @param interface_type type of object to return.
+	 * @param object_thread thread to move new objects to, nullptr means current thread
+	 * @param future future to report start, exception and finish to
+	 * @param report_result function that reports created object to @p future
+	 * @pre !interface_type.is_empty()
+	 * @pre !interface_type.is_qobject()
+	 * @see injector::get_async<T>()
+	 */
+	void get_async(const type &interface_type, QThread *object_thread, QFutureInterfaceBase future, std::function<void(QObject *)> report_result);
+
 	/**
 	 * @brief Returns all objects with given @p type_role.
 	 * @throw instantiation_failed if instantiation of one of found types failed
@@ -159,11 +230,239 @@ public:
 	 */
 	void inject_into(QObject *object);
 
+	/**
+	 * @brief Inject dependencies into all @p objects.
+	 * @param objects objects to inject dependencies into.
+	 * @throw invalid_setter if any tagged setter has parameter that is not a QObject-derived pointer
+	 * @throw invalid_setter if any tagged setter has parameter that is a QObject pointer
+	 * @throw invalid_setter if any tagged setter has parameter that is a QObject-derived pointer of not configured type
+	 * @throw invalid_setter if any tagged setter has other number of parameters than one
+	 * @pre all objects are not nullptr
+	 *
+	 * Works like calling inject_into(QObject *) for each object, but dependencies missing for all objects are
+	 * instantiated at once before any setter is called.
+	 */
+	void inject_into(const std::vector<QObject *> &objects);
+
+	/**
+	 * @brief Instantiate all configured types and make injector immutable.
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 *
+	 * After this call injector does not create any new objects. get() and get_all_with_type_role()
+	 * only read immutable tables, so these can be called from any number of threads without any
+	 * synchronization. inject_into() only calls setters with already created objects.
+	 *
+	 * Any call that would have to create new object throws injector_frozen.
+	 */
+	void freeze();
+
+	/**
+	 * @brief Instantiate @p root_types with all their dependencies and make injector immutable.
+	 * @param root_types types to instantiate before freezing
+	 * @throw unknown_type if any of @p root_types was not configured in injector
+	 * @throw instantiation_failed if instantiation of one of types failed
+	 *
+	 * Works like freeze(), but only objects required by @p root_types are created. Getting other
+	 * types from frozen injector throws injector_frozen.
+	 */
+	void freeze(const std::vector<type> &root_types);
+
+	/**
+	 * @return true if freeze() was called on this injector
+	 */
+	bool is_frozen() const;
+
+	/**
+	 * @brief Validate configuration of all types without creating any object.
+	 * @see injector::validate_all()
+	 *
+	 * Does nothing if injector is not lazy and has validation_level::strict.
+	 */
+	void validate_all() const;
+
+	/**
+	 * @brief Queue @p types for instantiation from event loop of current thread.
+	 * @param types types to instantiate
+	 * @throw unknown_type if any of @p types was not configured in injector
+	 * @see injector::warm_up(const std::vector<type> &)
+	 *
+	 * warm_up_scheduler is created on first call, in current thread. All later calls must be done
+	 * from the same thread.
+	 */
+	void warm_up(const std::vector<type> &types);
+
+	/**
+	 * @brief Queue all types with given @p type_role for instantiation from event loop of current thread.
+	 * @see warm_up(const std::vector<type> &)
+	 */
+	void warm_up_with_type_role(const std::string &type_role);
+
+	/**
+	 * @brief Start recording order of first get() and instantiate() calls for each type.
+	 * @see injector::start_access_recording()
+	 *
+	 * Calls made by injector itself - for dependencies, factories or warm up - are not recorded.
+	 */
+	void start_access_recording();
+
+	/**
+	 * @brief Save recorded accesses to file @p file_name.
+	 * @return false if file could not be written
+	 * @see injector::save_access_recording(const std::string &)
+	 */
+	bool save_access_recording(const std::string &file_name) const;
+
+	/**
+	 * @brief Warm up types from file @p file_name in recorded order.
+	 * @return false if file could not be read
+	 * @see injector::replay_access_recording(const std::string &)
+	 *
+	 * Recorded types are queued with highest priority, types that are no longer configured are skipped.
+	 */
+	bool replay_access_recording(const std::string &file_name);
+
+	/**
+	 * @brief Save graph of configured types to file @p file_name in Graphviz DOT format.
+	 * @return false if file could not be written
+	 * @throw not_supported if injector is lazy
+	 * @see injector::save_dependency_graph_dot(const std::string &)
+	 */
+	bool save_dependency_graph_dot(const std::string &file_name) const;
+
+	/**
+	 * @brief Save graph of configured types to file @p file_name in JSON format.
+	 * @return false if file could not be written
+	 * @throw not_supported if injector is lazy
+	 * @see injector::save_dependency_graph_json(const std::string &)
+	 */
+	bool save_dependency_graph_json(const std::string &file_name) const;
+
+	/**
+	 * @brief Return longest chain of dependencies of @p interface_type weighted with measured times.
+	 * @throw unknown_type if @p interface_type was not configured in injector
+	 * @throw not_supported if injector is lazy
+	 * @see injector::find_critical_path(const type &)
+	 */
+	critical_path find_critical_path(const type &interface_type) const;
+
+	/**
+	 * @return critical paths of all root types
+	 * @throw not_supported if injector is lazy
+	 * @see injector::find_critical_paths()
+	 */
+	std::vector<critical_path> find_critical_paths() const;
+
+	/**
+	 * @return text report of critical paths of all root types
+	 * @throw not_supported if injector is lazy
+	 * @see injector::critical_path_report()
+	 */
+	std::string critical_path_report() const;
+
 private:
 	std::vector<std::unique_ptr<module>> _modules;
+	validation_level _validation;
+	// only stored by non-lazy injectors that did not validate whole configuration
+	std::vector<std::shared_ptr<provider_configuration>> _configurations;
 	injector_core _core;
+	std::unique_ptr<lazy_configuration> _lazy;
+	// guards _lazy, _segments, _activated and creation of _aggregate and is held while segment is created
+	mutable std::mutex _lazy_mutex;
+	std::vector<std::unique_ptr<injector_impl>> _segments;
+	// activated types in order of activation with segments that own them
+	std::vector<std::pair<injector_impl *, type>> _activated;
+	// names of activated types and their interfaces with segments that own these types
+	std::unordered_map<std::string, std::vector<std::pair<injector_impl *, type>>> _owners;
+	mutable std::mutex _owners_mutex;
+	// read and written with std::atomic_load and std::atomic_store, null when aggregate segment has to be created again
+	mutable std::shared_ptr<injector_impl> _aggregate;
+	std::mutex _async_mutex;
+	std::condition_variable _async_finished;
+	int _async_calls;
+	access_recorder _access_recorder;
+	// destroyed before _core, which it uses
+	std::unique_ptr<warm_up_scheduler> _warm_up_scheduler;
+
+	/**
+	 * @brief Create segment of lazy injector configured with @p configurations.
+	 * @param configurations configurations of types, including ones provided by other segments
+	 * @param validation validation level of lazy injector
+	 */
+	explicit injector_impl(std::vector<std::shared_ptr<provider_configuration>> configurations, validation_level validation);
+
+	void init(std::vector<injector_impl *> super_injectors, const injector_options &options);
+
+	/**
+	 * @return injector_core of aggregate segment for lazy injector, own injector_core otherwise
+	 *
+	 * Returned pointer keeps aggregate segment alive, so it must not be stored longer than for one call.
+	 */
+	std::shared_ptr<injector_core> core();
+
+	/**
+	 * @return injector_core of aggregate segment for lazy injector, own injector_core otherwise
+	 *
+	 * Returned pointer keeps aggregate segment alive, so it must not be stored longer than for one call.
+	 */
+	std::shared_ptr<const injector_core> core() const;
 
-	void init(std::vector<injector_impl *> super_injectors);
+	/**
+	 * @return injector_core of segment owning @p interface_type after activating its configuration if needed
+	 *
+	 * Returns core() for lazy injector if @p interface_type is not configured or is ambiguous, so the same
+	 * error is reported as by not lazy injector.
+	 */
+	std::shared_ptr<injector_core> core_for(const type &interface_type);
+
+	/**
+	 * @return segment that owns only activated type named @p type_name or implementing interface named
+	 * @p type_name, nullptr if there is no such segment or there are many of them
+	 */
+	injector_impl * owner_of(const std::string &type_name) const;
+
+	/**
+	 * @return segment providing all activated types from segments owning them
+	 *
+	 * Segment is shared with each caller, so it stays alive when next activation releases it.
+	 */
+	std::shared_ptr<injector_impl> aggregate() const;
+
+	/**
+	 * @throw not_supported if injector is lazy
+	 */
+	void ensure_not_lazy(const std::string &method) const;
+
+	/**
+	 * @brief Activate configurations providing types named @p type_names and their dependencies.
+	 * @throw injector_frozen if injector is frozen and any configuration would be activated
+	 */
+	void activate(const std::vector<std::string> &type_names);
+
+	/**
+	 * @brief Activate configurations selected by @p select in new segment.
+	 * @throw injector_frozen if injector is frozen and any configuration would be activated
+	 *
+	 * Does nothing if injector is not lazy or if @p select returns no configurations. Exceptions
+	 * thrown by creating new segment are passed to caller and configurations remain not activated.
+	 */
+	void activate(const std::function<std::vector<std::size_t>(lazy_configuration &)> &select);
+
+	/**
+	 * @brief Freeze all segments of lazy injector with objects they already have.
+	 */
+	void freeze_segments();
+
+	/**
+	 * @return current time if accesses are recorded, default time point otherwise
+	 */
+	access_recorder::clock::time_point access_start() const;
+
+	/**
+	 * @brief Call @p call in QThreadPool and report its result to @p future.
+	 *
+	 * Exception thrown by @p call is reported to @p future as async_exception.
+	 */
+	void call_async(QFutureInterfaceBase future, std::function<void()> call);
 
 };
 
@@ -22,34 +22,17 @@
 
 #include <injeqt/type.h>
 
-#include <QtCore/QMetaObject>
+#include "type-metadata.h"
+
 #include <cassert>
 
 namespace injeqt { namespace internal {
 
-namespace
-{
-
-bool is_qobject(const QMetaObject * const meta_object)
-{
-	return !meta_object->superClass();
-}
-
-}
-
-types extract_interfaces(const type &for_type)
+const types & extract_interfaces(const type &for_type)
 {
 	assert(!for_type.is_empty());
 
-	auto result = std::vector<type>{};
-	auto meta_object = for_type.meta_object();
-	while (meta_object && !is_qobject(meta_object))
-	{
-		result.emplace_back(meta_object);
-		meta_object = meta_object->superClass();
-	}
-
-	return types{result};
+	return type_metadata_for(for_type).interfaces();
 }
 
 bool implements(const type &implementation, const type &interface)
@@ -57,8 +40,7 @@ bool implements(const type &implementation, const type &interface)
 	assert(!implementation.is_empty());
 	assert(!interface.is_empty());
 
-	auto interfaces = extract_interfaces(implementation);
-	return std::find(std::begin(interfaces), std::end(interfaces), interface) != std::end(interfaces);
+	return type_metadata_for(implementation).interfaces().contains(interface);
 }
 
 }}
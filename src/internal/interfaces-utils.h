@@ -40,8 +40,11 @@ namespace injeqt { namespace internal {
  * gets all QObject-based ancestors of for_type (including for_type itself,
  * excluding QObject) and returns it as a types collection. If for_type
  * object is not valid an empty collection is returned.
+ *
+ * Result is cached in type_metadata, so returned reference is valid until
+ * the end of program.
  */
-INJEQT_INTERNAL_API types extract_interfaces(const type &for_type);
+INJEQT_INTERNAL_API const types & extract_interfaces(const type &for_type);
 
 /**
  * @brief Return true if @p implementation implements @p interface
@@ -0,0 +1,45 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <ostream>
+#include <string>
+
+/**
+ * @file
+ * @brief Contains functions for writing JSON strings.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Write @p value to @p stream as quoted JSON string.
+ *
+ * Quotes, backslashes and control characters are escaped. Other bytes are written as they are,
+ * so UTF-8 strings stay valid.
+ */
+INJEQT_INTERNAL_API void write_json_string(std::ostream &stream, const std::string &value);
+
+}}
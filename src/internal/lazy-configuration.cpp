@@ -0,0 +1,238 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "lazy-configuration.h"
+
+#include <injeqt/exception/plugin-load-failed.h>
+
+#include "interfaces-utils.h"
+#include "type-metadata.h"
+#include "type-role.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+const std::vector<std::size_t> & no_indexes()
+{
+	static auto result = std::vector<std::size_t>{};
+	return result;
+}
+
+}
+
+lazy_configuration::lazy_configuration(std::vector<std::shared_ptr<provider_configuration>> configurations,
+	std::vector<plugin_declaration> plugins, module_loader loader) :
+		_interfaces_indexed{false},
+		_loader{std::move(loader)}
+{
+	for (auto &&c : configurations)
+		add_configuration(std::move(c));
+	for (auto &&p : plugins)
+		add_plugin(std::move(p));
+}
+
+void lazy_configuration::add_configuration(std::shared_ptr<provider_configuration> configuration)
+{
+	assert(!configuration->types().empty());
+
+	auto index = _configurations.size();
+	auto provided_type = configuration->types().front();
+	_configurations.push_back(std::move(configuration));
+	_taken.push_back(false);
+	_by_type_name[provided_type.name()].push_back(index);
+	if (_interfaces_indexed)
+		for (auto &&interface_type : extract_interfaces(provided_type))
+			_by_interface_name[interface_type.name()].push_back(index);
+}
+
+void lazy_configuration::add_plugin(plugin_declaration plugin)
+{
+	auto index = _plugins.size();
+	for (auto &&type_name : plugin.type_names)
+		_by_plugin_type_name[type_name].push_back(index);
+	_plugins.push_back(std::move(plugin));
+	_plugin_loaded.push_back(false);
+}
+
+void lazy_configuration::load_plugin(std::size_t index)
+{
+	assert(!_plugin_loaded[index]);
+
+	// copied, as loaded module can add more plugins
+	auto plugin = _plugins[index];
+	auto loaded = _loader(plugin.file_name);
+	auto &&configurations = loaded->_pimpl->provider_configurations();
+
+	for (auto &&type_name : plugin.type_names)
+	{
+		auto provided = std::any_of(std::begin(configurations), std::end(configurations), [&type_name](const std::shared_ptr<provider_configuration> &c){
+			auto &&interfaces = extract_interfaces(c->types().front());
+			return std::any_of(std::begin(interfaces), std::end(interfaces), [&type_name](const type &t){ return t.name() == type_name; });
+		});
+		if (!provided)
+			throw exception::plugin_load_failed{plugin.file_name + ": " + type_name + " is not provided by plugin"};
+	}
+
+	_plugin_loaded[index] = true;
+	for (auto &&c : configurations)
+		add_configuration(c);
+	for (auto &&p : loaded->_pimpl->plugins())
+		add_plugin(p);
+	_plugin_modules.push_back(std::move(loaded));
+}
+
+void lazy_configuration::load_all_plugins()
+{
+	// loaded plugins can add more plugins
+	for (decltype(_plugins.size()) i = 0; i < _plugins.size(); i++)
+		if (!_plugin_loaded[i])
+			load_plugin(i);
+}
+
+const std::vector<std::shared_ptr<provider_configuration>> & lazy_configuration::all() const
+{
+	return _configurations;
+}
+
+std::vector<type> lazy_configuration::provided_types() const
+{
+	auto result = std::vector<type>{};
+	for (auto &&c : _configurations)
+		result.push_back(c->types().front());
+	return result;
+}
+
+const std::vector<std::size_t> & lazy_configuration::providing(const std::string &type_name)
+{
+	auto exact = _by_type_name.find(type_name);
+	if (exact != std::end(_by_type_name))
+		return exact->second;
+
+	if (!_interfaces_indexed)
+	{
+		for (decltype(_configurations.size()) i = 0; i < _configurations.size(); i++)
+			for (auto &&interface_type : extract_interfaces(_configurations[i]->types().front()))
+				_by_interface_name[interface_type.name()].push_back(i);
+		_interfaces_indexed = true;
+	}
+
+	auto by_interface = _by_interface_name.find(type_name);
+	if (by_interface != std::end(_by_interface_name))
+		return by_interface->second;
+
+	auto by_plugin = _by_plugin_type_name.find(type_name);
+	if (by_plugin == std::end(_by_plugin_type_name))
+		return no_indexes();
+
+	// copied, as loaded plugins can add more plugins
+	auto plugin_indexes = by_plugin->second;
+	auto loaded = false;
+	for (auto i : plugin_indexes)
+		if (!_plugin_loaded[i])
+		{
+			load_plugin(i);
+			loaded = true;
+		}
+
+	return loaded
+			? providing(type_name)
+			: no_indexes();
+}
+
+std::vector<std::size_t> lazy_configuration::select(const std::vector<std::string> &type_names)
+{
+	auto selected = std::vector<bool>{};
+	auto result = std::vector<std::size_t>{};
+	auto to_visit = type_names;
+
+	while (!to_visit.empty())
+	{
+		auto type_name = to_visit.back();
+		to_visit.pop_back();
+
+		auto &&indexes = providing(type_name);
+		// configurations of loaded plugins are added at the end
+		selected.resize(_configurations.size(), false);
+		for (auto i : indexes)
+		{
+			if (_taken[i] || selected[i])
+				continue;
+
+			selected[i] = true;
+			result.push_back(i);
+
+			auto &&configuration_types = _configurations[i]->types();
+			for (auto it = std::next(std::begin(configuration_types)); it != std::end(configuration_types); ++it)
+				to_visit.push_back(it->name());
+			for (auto &&t : configuration_types)
+				for (auto &&setter : type_metadata_for(t).setter_candidates())
+					if (!setter.parameter_pointer_name.empty())
+						// remove trailing '*'
+						to_visit.push_back(setter.parameter_pointer_name.substr(0, setter.parameter_pointer_name.size() - 1));
+		}
+	}
+
+	std::sort(std::begin(result), std::end(result));
+	return result;
+}
+
+std::vector<std::size_t> lazy_configuration::select_with_type_role(const std::string &type_role)
+{
+	auto type_names = std::vector<std::string>{};
+	for (decltype(_configurations.size()) i = 0; i < _configurations.size(); i++)
+	{
+		auto provided_type = _configurations[i]->types().front();
+		if (!_taken[i] && has_type_role(provided_type, type_role))
+			type_names.push_back(provided_type.name());
+	}
+
+	return select(type_names);
+}
+
+std::vector<std::size_t> lazy_configuration::select_all()
+{
+	load_all_plugins();
+
+	auto result = std::vector<std::size_t>{};
+	for (decltype(_configurations.size()) i = 0; i < _configurations.size(); i++)
+		if (!_taken[i])
+			result.push_back(i);
+	return result;
+}
+
+std::vector<std::shared_ptr<provider_configuration>> lazy_configuration::configurations(const std::vector<std::size_t> &indexes) const
+{
+	auto result = std::vector<std::shared_ptr<provider_configuration>>{};
+	for (auto i : indexes)
+		result.push_back(_configurations[i]);
+	return result;
+}
+
+void lazy_configuration::take(const std::vector<std::size_t> &indexes)
+{
+	for (auto i : indexes)
+		_taken[i] = true;
+}
+
+}}
@@ -0,0 +1,154 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/module.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+#include "module-impl.h"
+#include "module-plugin-loader.h"
+#include "provider-configuration.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for selecting provider configurations needed by lazy injector.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Set of provider configurations of lazy injector that were not yet used.
+ * @see injector_options::lazy
+ *
+ * Constructor only reads provided type of each configuration, which is the first of its
+ * provider_configuration::types(). Other types of configuration (like factory type) are required by it.
+ *
+ * select(const std::vector<std::string> &) returns indexes of configurations that provide given types together
+ * with all configurations that these depend on. Dependencies are read from setter candidates of type_metadata
+ * only, so no provider is created and nothing is validated. Type is matched by exact name first and then by
+ * names of its interfaces, so selection can contain more configurations than actually needed - never less,
+ * unless configuration is invalid. Configurations passed to take(const std::vector<std::size_t> &) are never
+ * selected again.
+ *
+ * Types declared by plugins are only known by name. When a type name is not provided by any configuration,
+ * plugins declaring it are loaded and configurations of their modules are added at the end, so indexes of
+ * existing configurations do not change. Loaded modules are owned by this object.
+ *
+ * This class is not thread safe.
+ */
+class INJEQT_INTERNAL_API lazy_configuration final
+{
+
+public:
+	/**
+	 * @brief Create lazy configuration with all @p configurations not taken and all @p plugins not loaded.
+	 * @param configurations configurations of types
+	 * @param plugins plugins to load when their types are needed
+	 * @param loader function loading plugins
+	 */
+	explicit lazy_configuration(std::vector<std::shared_ptr<provider_configuration>> configurations,
+		std::vector<plugin_declaration> plugins = std::vector<plugin_declaration>{}, module_loader loader = load_module_plugin);
+
+	/**
+	 * @return all configurations, including taken ones and excluding ones of not loaded plugins
+	 */
+	const std::vector<std::shared_ptr<provider_configuration>> & all() const;
+
+	/**
+	 * @return provided types of all configurations, including taken ones and excluding ones of not loaded plugins
+	 */
+	std::vector<type> provided_types() const;
+
+	/**
+	 * @return sorted indexes of not taken configurations providing @p type_names and their dependencies
+	 *
+	 * Type name that is not provided by any configuration or plugin is ignored.
+	 * @throw plugin_load_failed if plugin declaring any of needed types could not be loaded
+	 */
+	std::vector<std::size_t> select(const std::vector<std::string> &type_names);
+
+	/**
+	 * @return sorted indexes of not taken configurations providing types with @p type_role and their dependencies
+	 */
+	std::vector<std::size_t> select_with_type_role(const std::string &type_role);
+
+	/**
+	 * @return sorted indexes of all not taken configurations, after loading all plugins
+	 * @throw plugin_load_failed if any plugin could not be loaded
+	 */
+	std::vector<std::size_t> select_all();
+
+	/**
+	 * @return configurations with given @p indexes
+	 */
+	std::vector<std::shared_ptr<provider_configuration>> configurations(const std::vector<std::size_t> &indexes) const;
+
+	/**
+	 * @brief Mark configurations with given @p indexes as taken.
+	 */
+	void take(const std::vector<std::size_t> &indexes);
+
+	/**
+	 * @brief Load all plugins that were not loaded yet.
+	 * @throw plugin_load_failed if any plugin could not be loaded
+	 */
+	void load_all_plugins();
+
+private:
+	std::vector<std::shared_ptr<provider_configuration>> _configurations;
+	std::vector<bool> _taken;
+	std::unordered_map<std::string, std::vector<std::size_t>> _by_type_name;
+	std::unordered_map<std::string, std::vector<std::size_t>> _by_interface_name;
+	bool _interfaces_indexed;
+	std::vector<plugin_declaration> _plugins;
+	std::vector<bool> _plugin_loaded;
+	std::unordered_map<std::string, std::vector<std::size_t>> _by_plugin_type_name;
+	module_loader _loader;
+	std::vector<std::unique_ptr<module>> _plugin_modules;
+
+	void add_configuration(std::shared_ptr<provider_configuration> configuration);
+	void add_plugin(plugin_declaration plugin);
+
+	/**
+	 * @brief Load plugin with given @p index and add its configurations and plugins.
+	 * @throw plugin_load_failed if plugin could not be loaded or does not provide all declared types
+	 */
+	void load_plugin(std::size_t index);
+
+	/**
+	 * @return indexes of configurations providing type or interface named @p type_name
+	 *
+	 * Map of interfaces is created on first call that does not find exact name. If neither exact name
+	 * nor interface is found, plugins declaring @p type_name are loaded.
+	 */
+	const std::vector<std::size_t> & providing(const std::string &type_name);
+
+};
+
+}}
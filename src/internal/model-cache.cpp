@@ -0,0 +1,203 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "model-cache.h"
+
+#include "dependencies.h"
+#include "dependency.h"
+#include "implemented-by-mapping.h"
+#include "implemented-by.h"
+#include "provider.h"
+#include "setter-method.h"
+#include "type-dependencies.h"
+#include "type-metadata.h"
+#include "types-dependencies.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+// increase when format of file or content of fingerprint changes
+const auto model_cache_header = std::string{"injeqt-model-cache 1"};
+
+void hash_append(std::uint64_t &hash, const std::string &data)
+{
+	// FNV-1a, each part is terminated with zero byte, so ("ab", "c") and ("a", "bc") differ
+	for (auto c : data)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	hash *= 1099511628211ull;
+}
+
+type type_by_name(const types_by_name &known_types, const std::string &name)
+{
+	auto it = known_types.get(name);
+	return it != std::end(known_types) ? *it : type{};
+}
+
+}
+
+std::uint64_t model_fingerprint(const types_by_name &known_types, const providers &available_providers)
+{
+	auto result = std::uint64_t{14695981039346656037ull};
+	hash_append(result, model_cache_header);
+
+	for (auto &&known_type : known_types)
+	{
+		auto super_class = known_type.meta_object()->superClass();
+		hash_append(result, known_type.name());
+		hash_append(result, super_class ? super_class->className() : std::string{});
+		for (auto &&setter : type_metadata_for(known_type).setter_candidates())
+		{
+			hash_append(result, std::to_string(setter.meta_method.methodIndex()));
+			hash_append(result, setter.meta_method.methodSignature().data());
+			hash_append(result, setter.meta_method.tag());
+		}
+	}
+
+	for (auto &&p : available_providers)
+	{
+		hash_append(result, p->provided_type().name());
+		hash_append(result, std::to_string(static_cast<int>(p->kind())));
+		hash_append(result, p->require_resolving() ? "1" : "0");
+		for (auto &&required_type : p->required_types())
+			hash_append(result, required_type.name());
+	}
+
+	return result;
+}
+
+bool write_model_cache(const std::string &file_name, std::uint64_t fingerprint, const types_model &model)
+{
+	auto temporary_file_name = file_name + ".tmp";
+	{
+		std::ofstream file{temporary_file_name, std::ios::out | std::ios::trunc};
+		if (!file)
+			return false;
+
+		file << model_cache_header << '\n' << fingerprint << '\n';
+		for (auto &&available_type : model.available_types())
+			file << "A " << available_type.interface_type().name() << ' ' << available_type.implementation_type().name() << '\n';
+		for (auto &&mapped_dependencies : model.mapped_dependencies())
+		{
+			file << "T " << mapped_dependencies.dependent_type().name() << '\n';
+			for (auto &&dependency : mapped_dependencies.dependency_list())
+				file << "D " << dependency.setter().meta_method().methodIndex() << ' ' << dependency.required_type().name() << '\n';
+		}
+
+		file.close();
+		if (!file)
+		{
+			std::remove(temporary_file_name.c_str());
+			return false;
+		}
+	}
+
+	// rename does not replace existing files on all platforms
+	if (std::rename(temporary_file_name.c_str(), file_name.c_str()) == 0)
+		return true;
+	std::remove(file_name.c_str());
+	if (std::rename(temporary_file_name.c_str(), file_name.c_str()) == 0)
+		return true;
+	std::remove(temporary_file_name.c_str());
+	return false;
+}
+
+bool read_model_cache(const std::string &file_name, std::uint64_t fingerprint, const types_by_name &known_types, types_model &model)
+{
+	std::ifstream file{file_name};
+	if (!file)
+		return false;
+
+	auto line = std::string{};
+	if (!std::getline(file, line) || line != model_cache_header)
+		return false;
+	if (!std::getline(file, line) || line != std::to_string(fingerprint))
+		return false;
+
+	auto available_types = std::vector<implemented_by>{};
+	auto mapped_dependencies = std::vector<type_dependencies>{};
+	auto dependent_type = type{};
+	auto dependency_list = std::vector<dependency>{};
+	auto flush_dependencies = [&](){
+		if (!dependent_type.is_empty())
+			mapped_dependencies.emplace_back(dependent_type, dependencies{std::move(dependency_list)});
+		dependency_list.clear();
+	};
+
+	while (std::getline(file, line))
+	{
+		std::istringstream line_stream{line};
+		auto kind = std::string{};
+		line_stream >> kind;
+		if (kind == "A")
+		{
+			auto interface_name = std::string{};
+			auto implementation_name = std::string{};
+			if (!(line_stream >> interface_name >> implementation_name))
+				return false;
+			auto interface_type = type_by_name(known_types, interface_name);
+			auto implementation_type = type_by_name(known_types, implementation_name);
+			if (interface_type.is_empty() || implementation_type.is_empty())
+				return false;
+			available_types.emplace_back(interface_type, implementation_type);
+		}
+		else if (kind == "T")
+		{
+			auto dependent_name = std::string{};
+			if (!(line_stream >> dependent_name))
+				return false;
+			flush_dependencies();
+			dependent_type = type_by_name(known_types, dependent_name);
+			if (dependent_type.is_empty())
+				return false;
+		}
+		else if (kind == "D")
+		{
+			auto method_index = int{};
+			auto required_name = std::string{};
+			if (dependent_type.is_empty() || !(line_stream >> method_index >> required_name))
+				return false;
+			auto required_type = type_by_name(known_types, required_name);
+			if (required_type.is_empty() || method_index < 0 || method_index >= dependent_type.meta_object()->methodCount())
+				return false;
+			// fingerprint matches, so method is a valid setter, as it was when model was written
+			dependency_list.emplace_back(setter_method{required_type, dependent_type.meta_object()->method(method_index)});
+		}
+		else
+			return false;
+	}
+
+	if (file.bad())
+		return false;
+
+	flush_dependencies();
+	model = types_model{implemented_by_mapping{std::move(available_types)}, types_dependencies{std::move(mapped_dependencies)}};
+	return true;
+}
+
+}}
@@ -0,0 +1,76 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+#include "providers.h"
+#include "types-by-name.h"
+#include "types-model.h"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @file
+ * @brief Contains functions for storing validated types_model in a file.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Compute fingerprint of everything that types_model of injector depends on.
+ * @param known_types all types known to injector
+ * @param available_providers all providers of injector
+ *
+ * Fingerprint covers names, superclasses and tagged setters (index, signature and tag) of all
+ * @p known_types and provided type, kind and required types of all @p available_providers. Any change
+ * in this data that could change result of make_types_model() or its validation changes the fingerprint.
+ */
+INJEQT_INTERNAL_API std::uint64_t model_fingerprint(const types_by_name &known_types, const providers &available_providers);
+
+/**
+ * @brief Write validated types_model to a file.
+ * @param file_name name of file to write
+ * @param fingerprint result of model_fingerprint() for configuration of @p model
+ * @param model validated types model
+ * @return true if file was written
+ *
+ * Model is written to temporary file first, then renamed to @p file_name, so other processes
+ * never read partially written model.
+ */
+INJEQT_INTERNAL_API bool write_model_cache(const std::string &file_name, std::uint64_t fingerprint, const types_model &model);
+
+/**
+ * @brief Read types_model written by write_model_cache().
+ * @param file_name name of file to read
+ * @param fingerprint result of model_fingerprint() for current configuration
+ * @param known_types all types known to injector, used to resolve type names
+ * @param model read model is stored here
+ * @return true if model was read
+ *
+ * Returns false and leaves @p model unchanged when file does not exist, was written for other
+ * fingerprint or its content is not valid for @p known_types.
+ */
+INJEQT_INTERNAL_API bool read_model_cache(const std::string &file_name, std::uint64_t fingerprint, const types_by_name &known_types, types_model &model);
+
+}}
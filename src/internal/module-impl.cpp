@@ -34,4 +34,14 @@ const std::vector<std::shared_ptr<provider_configuration>> & module_impl::provid
 	return _provider_configurations;
 }
 
+void module_impl::add_plugin(plugin_declaration p)
+{
+	_plugins.push_back(std::move(p));
+}
+
+const std::vector<plugin_declaration> & module_impl::plugins() const
+{
+	return _plugins;
+}
+
 }}
@@ -26,6 +26,8 @@
 #include "provider-configuration.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 /**
  * @file
@@ -34,6 +36,15 @@
 
 namespace injeqt { namespace internal {
 
+/**
+ * @brief Plugin added to module with module::add_plugin(std::string, std::vector<std::string>).
+ */
+struct plugin_declaration
+{
+	std::string file_name;
+	std::vector<std::string> type_names;
+};
+
 /**
  * @brief Implementation of module class.
  * @see module class
@@ -57,8 +68,17 @@ public:
 	 */
 	void add_provider_configuration(std::shared_ptr<provider_configuration> p);
 
+	const std::vector<plugin_declaration> & plugins() const;
+
+	/**
+	 * @brief Add plugin declaration to list
+	 * @param p plugin declaration to add
+	 */
+	void add_plugin(plugin_declaration p);
+
 private:
 	std::vector<std::shared_ptr<provider_configuration>> _provider_configurations;
+	std::vector<plugin_declaration> _plugins;
 
 };
 
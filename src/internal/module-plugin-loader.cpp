@@ -0,0 +1,53 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "module-plugin-loader.h"
+
+#include <injeqt/exception/plugin-load-failed.h>
+#include <injeqt/module-plugin.h>
+
+#include "trace-recorder.h"
+
+#include <QtCore/QPluginLoader>
+
+namespace injeqt { namespace internal {
+
+std::unique_ptr<module> load_module_plugin(const std::string &file_name)
+{
+	trace_span span{"load_module_plugin"};
+
+	QPluginLoader loader{QString::fromStdString(file_name)};
+	auto instance = loader.instance();
+	if (!instance)
+		throw exception::plugin_load_failed{file_name + ": " + loader.errorString().toStdString()};
+
+	auto plugin = qobject_cast<module_plugin *>(instance);
+	if (!plugin)
+		throw exception::plugin_load_failed{file_name + ": plugin does not implement injeqt::module_plugin"};
+
+	auto result = plugin->create_module();
+	if (!result)
+		throw exception::plugin_load_failed{file_name + ": plugin did not create module"};
+
+	// loader is destroyed without calling unload(), so library stays loaded
+	return result;
+}
+
+}}
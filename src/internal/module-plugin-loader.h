@@ -0,0 +1,57 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * @file
+ * @brief Contains classes and functions for loading modules from Qt plugins.
+ */
+
+namespace injeqt { namespace v1 {
+	class module;
+}}
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Function that returns module of plugin with given file name.
+ */
+using module_loader = std::function<std::unique_ptr<::injeqt::v1::module>(const std::string &)>;
+
+/**
+ * @brief Load Qt plugin @p file_name and create its module.
+ * @param file_name file name of plugin, as accepted by QPluginLoader
+ * @return module created by module_plugin::create_module() of plugin
+ * @throw plugin_load_failed if plugin could not be loaded, does not implement module_plugin or did not create module
+ *
+ * Plugin is never unloaded, as returned module and objects created from its configuration use its code.
+ */
+INJEQT_INTERNAL_API std::unique_ptr<::injeqt::v1::module> load_module_plugin(const std::string &file_name);
+
+}}
@@ -30,8 +30,9 @@
 
 namespace injeqt { namespace internal {
 
-provider_by_default_constructor_configuration::provider_by_default_constructor_configuration(type object_type) :
-	_object_type{std::move(object_type)}
+provider_by_default_constructor_configuration::provider_by_default_constructor_configuration(type object_type, QThread *object_thread) :
+	_object_type{std::move(object_type)},
+	_object_thread{object_thread}
 {
 	assert(!_object_type.is_empty());
 }
@@ -54,7 +55,7 @@ std::unique_ptr<provider> provider_by_default_constructor_configuration::create_
 	if (c.is_empty())
 		throw exception::default_constructor_not_found{_object_type.name()};
 
-	return std::unique_ptr<provider_by_default_constructor>{new provider_by_default_constructor{std::move(c)}};
+	return std::unique_ptr<provider_by_default_constructor>{new provider_by_default_constructor{std::move(c), _object_thread}};
 }
 
 }}
@@ -31,6 +31,8 @@
  * @brief Contains classes and functions for representing configuration of provider working on default constructor.
  */
 
+class QThread;
+
 namespace injeqt { namespace internal {
 
 /**
@@ -46,12 +48,13 @@ public:
 	/**
 	 * @brief Create provider configuration instance.
 	 * @param object_type type of object that this provider will return
+	 * @param object_thread thread to create object in, nullptr means thread that requests object
 	 * @pre !object_type.is_empty()
 	 * 
 	 * This constructor does not throw even when @p object_type is invalid or does not have deafult
 	 * contructor. Factory method create_provider(const types_by_name &) will throw in that case.
 	 */
-	explicit provider_by_default_constructor_configuration(type object_type);
+	explicit provider_by_default_constructor_configuration(type object_type, QThread *object_thread = nullptr);
 	virtual ~provider_by_default_constructor_configuration();
 
 	/**
@@ -69,6 +72,7 @@ public:
 
 private:
 	type _object_type;
+	QThread *_object_thread;
 
 };
 
@@ -22,18 +22,25 @@
 
 #include <injeqt/exception/instantiation-failed.h>
 
+#include "thread-call.h"
+
+#include <QtCore/QThread>
 #include <cassert>
 
 namespace injeqt { namespace internal {
 
-provider_by_default_constructor::provider_by_default_constructor(default_constructor_method constructor) :
-	_constructor{std::move(constructor)}
+provider_by_default_constructor::provider_by_default_constructor(default_constructor_method constructor, QThread *object_thread) :
+	_constructor{std::move(constructor)},
+	_object_thread{object_thread}
 {
 	assert(!_constructor.is_empty());
 }
 
 provider_by_default_constructor::~provider_by_default_constructor()
 {
+	// deleting object from other thread is only safe when that thread does not process events anymore
+	if (_object && _object_thread && _object_thread->isRunning())
+		call_in_thread(_object_thread, [this](){ _object.reset(); });
 }
 
 const type & provider_by_default_constructor::provided_type() const
@@ -46,11 +53,15 @@ const default_constructor_method & provider_by_default_constructor::constructor(
 	return _constructor;
 }
 
+void provider_by_default_constructor::prepare(injector_core &)
+{
+}
+
 QObject * provider_by_default_constructor::provide(injector_core &)
 {
 	if (!_object)
 	{
-		_object = _constructor.invoke();
+		call_in_thread(_object_thread, [this](){ _object = _constructor.invoke(); });
 		if (!_object)
 			throw exception::instantiation_failed{provided_type().name()};
 	}
@@ -62,4 +73,24 @@ bool provider_by_default_constructor::require_resolving() const
 	return true;
 }
 
+QThread * provider_by_default_constructor::object_thread() const
+{
+	return _object_thread;
+}
+
+bool provider_by_default_constructor::can_provide_in_any_thread() const
+{
+	return true;
+}
+
+void provider_by_default_constructor::destroy_object()
+{
+	_object.reset();
+}
+
+provider_kind provider_by_default_constructor::kind() const
+{
+	return provider_kind::default_constructor;
+}
+
 }}
@@ -42,6 +42,9 @@ namespace injeqt { namespace internal {
  *
  * Once created, object will be stored inside and return on subsequents calls to provide(injector_core &).
  * This provider has ownershipd over created object and will destroy it at own destruction.
+ *
+ * If object thread is passed to constructor then object is created in that thread, so it lives there.
+ * It is also destroyed in that thread, unless the thread has already finished.
  */
 class INJEQT_INTERNAL_API provider_by_default_constructor final : public provider
 {
@@ -50,9 +53,10 @@ public:
 	/**
 	 * @brief Create provider instance with default constructor to call.
 	 * @param constructor constructor method used to create object
+	 * @param object_thread thread to create object in, nullptr means thread that calls provide(injector_core &)
 	 * @pre !constructor.is_empty()
 	 */
-	explicit provider_by_default_constructor(default_constructor_method constructor);
+	explicit provider_by_default_constructor(default_constructor_method constructor, QThread *object_thread = nullptr);
 	virtual ~provider_by_default_constructor();
 
 	provider_by_default_constructor(provider_by_default_constructor &&x) = delete;
@@ -63,6 +67,13 @@ public:
 	 */
 	virtual const type & provided_type() const override;
 
+	/**
+	 * @brief Does nothing.
+	 *
+	 * Constructor can not be called asynchronously, so object is created in provide(injector_core &).
+	 */
+	virtual void prepare(injector_core &i) override;
+
 	/**
 	 * @return object created by default constructor
 	 * @post result != nullptr
@@ -70,7 +81,8 @@ public:
 	 * @throw instantiation_failed if instantiation of provided type failed
 	 *
 	 * If object was not yet created the constructor() method is called and object is stored
-	 * in internal cache. Then object from cache is returned.
+	 * in internal cache. Then object from cache is returned. Constructor is called in object_thread(),
+	 * current thread waits for it.
 	 */
 	virtual QObject * provide(injector_core &i) override;
 
@@ -86,6 +98,28 @@ public:
 	 */
 	virtual bool require_resolving() const override;
 
+	/**
+	 * @return object thread passed in constructor
+	 */
+	virtual QThread * object_thread() const override;
+
+	/**
+	 * @return true
+	 *
+	 * Default constructor does not use injector, object of type bound to thread is still constructed in that thread.
+	 */
+	virtual bool can_provide_in_any_thread() const override;
+
+	/**
+	 * @brief Delete object created by this provider, if any.
+	 */
+	virtual void destroy_object() override;
+
+	/**
+	 * @return provider_kind::default_constructor
+	 */
+	virtual provider_kind kind() const override;
+
 	/**
 	 * @return constructor object passed in constructor
 	 */
@@ -93,6 +127,7 @@ public:
 
 private:
 	default_constructor_method _constructor;
+	QThread *_object_thread;
 	std::unique_ptr<QObject> _object;
 
 };
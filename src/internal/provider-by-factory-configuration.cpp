@@ -30,9 +30,11 @@
 
 namespace injeqt { namespace internal {
 
-provider_by_factory_configuration::provider_by_factory_configuration(type object_type, type factory_type) :
+provider_by_factory_configuration::provider_by_factory_configuration(type object_type, type factory_type, factory_future_reader read_future, QThread *object_thread) :
 	_object_type{std::move(object_type)},
-	_factory_type{std::move(factory_type)}
+	_factory_type{std::move(factory_type)},
+	_read_future{read_future},
+	_object_thread{object_thread}
 {
 	assert(!_object_type.is_empty());
 	assert(!_factory_type.is_empty());
@@ -54,11 +56,11 @@ std::unique_ptr<provider> provider_by_factory_configuration::create_provider(con
 	if (_factory_type.is_qobject())
 		throw exception::qobject_type();
 
-	auto fm = internal::make_factory_method(known_types, _object_type, _factory_type);
+	auto fm = internal::make_factory_method(known_types, _object_type, _factory_type, _read_future);
 	if (fm.is_empty())
 		throw exception::unique_factory_method_not_found{_object_type.name() + " in " + _factory_type.name()};
 
-	return std::unique_ptr<provider_by_factory>{new provider_by_factory{std::move(fm)}};
+	return std::unique_ptr<provider_by_factory>{new provider_by_factory{std::move(fm), _object_thread}};
 }
 
 }}
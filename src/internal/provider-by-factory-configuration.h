@@ -21,6 +21,7 @@
 #pragma once
 
 #include <injeqt/injeqt.h>
+#include <injeqt/module.h>
 #include <injeqt/type.h>
 
 #include "internal.h"
@@ -31,6 +32,8 @@
  * @brief Contains classes and functions for representing configuration of provider working on factory method.
  */
 
+class QThread;
+
 namespace injeqt { namespace internal {
 
 /**
@@ -47,6 +50,9 @@ public:
 	 * @brief Create provider configuration instance.
 	 * @param object_type type of object that this provider will return
 	 * @param factory_type type of object that contains factory method that will return object of type @p object_type
+	 * @param read_future reader of QFuture<object_type *> returned by asynchronous factory method, nullptr means that
+	 *        asynchronous factory methods are not accepted
+	 * @param object_thread thread to move created object to, nullptr means object is not moved
 	 * @pre !object_type.is_empty()
 	 * @pre !factory.is_empty()
 	 * 
@@ -54,7 +60,7 @@ public:
 	 * @p factory_type does not contain proper factory method.
 	 * Factory method create_provider(const types_by_name &) will throw in that case.
 	 */
-	explicit provider_by_factory_configuration(type object_type, type factory_type);
+	explicit provider_by_factory_configuration(type object_type, type factory_type, factory_future_reader read_future = nullptr, QThread *object_thread = nullptr);
 	virtual ~provider_by_factory_configuration();
 
 	/**
@@ -74,6 +80,8 @@ public:
 private:
 	type _object_type;
 	type _factory_type;
+	factory_future_reader _read_future;
+	QThread *_object_thread;
 
 };
 
@@ -23,16 +23,37 @@
 #include <injeqt/exception/instantiation-failed.h>
 
 #include "injector-impl.h"
+#include "thread-call.h"
+
+#include <QtCore/QThread>
 
 namespace injeqt { namespace internal {
 
-provider_by_factory::provider_by_factory(factory_method factory) :
-	_factory{std::move(factory)}
+provider_by_factory::provider_by_factory(factory_method factory, QThread *object_thread) :
+	_factory{std::move(factory)},
+	_object_thread{object_thread},
+	_prepared{false}
 {
 }
 
 provider_by_factory::~provider_by_factory()
 {
+	// object prepared, but never provided, is still owned by this provider, so pending factory is waited for
+	if (_prepared)
+	{
+		try
+		{
+			delete _pending_object();
+		}
+		catch (...)
+		{
+			// factory failed, so there is nothing to delete
+		}
+	}
+
+	// deleting object from other thread is only safe when that thread does not process events anymore
+	if (_object && _object_thread && _object_thread->isRunning())
+		call_in_thread(_object_thread, [this](){ _object.reset(); });
 }
 
 const type & provider_by_factory::provided_type() const
@@ -45,14 +66,37 @@ const factory_method & provider_by_factory::factory() const
 	return _factory;
 }
 
+void provider_by_factory::prepare(injector_core &i)
+{
+	if (_object || _prepared)
+		return;
+
+	auto factory_object = i.get(_factory.object_type());
+	_pending_object = _factory.invoke_async(factory_object);
+	_prepared = true;
+}
+
 QObject * provider_by_factory::provide(injector_core &i)
 {
 	if (!_object)
 	{
-		auto factory_object = i.get(_factory.object_type());
-		_object = _factory.invoke(factory_object);
+		prepare(i);
+		// factory is called again on next request if this one fails, as for synchronous factory
+		_prepared = false;
+		// rethrows exception reported by factory, future without result is treated as nullptr
+		_object.reset(_pending_object());
 		if (!_object)
 			throw exception::instantiation_failed{provided_type().name()};
+		// only thread that object lives in can move it, so object living in third thread would stay there
+		if (_object_thread && _object->thread() == QThread::currentThread())
+			_object->moveToThread(_object_thread);
+		else if (_object_thread && _object->thread() != _object_thread)
+		{
+			// object can only be deleted safely in its own thread
+			_object.release()->deleteLater();
+			throw exception::instantiation_failed{provided_type().name() + ": object returned by factory lives in other thread than "
+				"the one its type is bound to"};
+		}
 	}
 
 	return _object.get();
@@ -68,4 +112,24 @@ bool provider_by_factory::require_resolving() const
 	return false;
 }
 
+QThread * provider_by_factory::object_thread() const
+{
+	return _object_thread;
+}
+
+bool provider_by_factory::can_provide_in_any_thread() const
+{
+	return false;
+}
+
+void provider_by_factory::destroy_object()
+{
+	_object.reset();
+}
+
+provider_kind provider_by_factory::kind() const
+{
+	return provider_kind::factory;
+}
+
 }}
@@ -43,6 +43,14 @@ namespace injeqt { namespace internal {
  *
  * Once created, object will be stored inside and return on subsequents calls to provide(injector_core &).
  * This provider has ownershipd over created object and will destroy it at own destruction.
+ *
+ * If object thread is passed to constructor then object is moved to that thread right after factory
+ * method returns it. It is destroyed in that thread, unless the thread has already finished. Factory
+ * method can only return object living in current thread or in object thread, as objects living in
+ * other threads can not be moved.
+ *
+ * Destructor waits for future of asynchronous factory method that was prepared, but not provided,
+ * to delete its object, so it blocks until that factory method finishes.
  */
 class INJEQT_INTERNAL_API provider_by_factory final : public provider
 {
@@ -51,8 +59,9 @@ public:
 	/**
 	 * @brief Create provider instance with factory method to call.
 	 * @param factory factory method used to create object
+	 * @param object_thread thread to move created object to, nullptr means object is not moved
 	 */
-	explicit provider_by_factory(factory_method factory);
+	explicit provider_by_factory(factory_method factory, QThread *object_thread = nullptr);
 	virtual ~provider_by_factory();
 
 	provider_by_factory(provider_by_factory &&x) = delete;
@@ -63,15 +72,27 @@ public:
 	 */
 	virtual const type & provided_type() const override;
 
+	/**
+	 * @brief Call factory method.
+	 *
+	 * If object was not yet created the object of type factory_method::object_type() is requested
+	 * from @p i and the factory method is called on it. Future returned by asynchronous factory
+	 * method is stored and waited for in provide(injector_core &).
+	 */
+	virtual void prepare(injector_core &i) override;
+
 	/**
 	 * @return object created by factory method
 	 * @post result != nullptr
 	 * @post implements(type{result->metaObject()}, provided_type())
 	 * @throw instantiation_failed if instantiation of provided type failed
+	 * @throw instantiation_failed if object thread was passed to constructor and created object lives
+	 * neither in current thread nor in object thread
 	 *
 	 * If object was not yet created the object of type factory_method::object_type() is requested
 	 * from @p i and the factory method is called on it to get object and stoe it in internal cache,
-	 * Then object from cache is returned.
+	 * Then object from cache is returned. If prepare(injector_core &) was called before, this method
+	 * waits for result of factory method called there.
 	 */
 	virtual QObject * provide(injector_core &i) override;
 
@@ -89,6 +110,28 @@ public:
 	 */
 	virtual bool require_resolving() const override;
 
+	/**
+	 * @return object thread passed in constructor
+	 */
+	virtual QThread * object_thread() const override;
+
+	/**
+	 * @return false
+	 *
+	 * Factory object lives in thread that created it, so factory method is called from that thread.
+	 */
+	virtual bool can_provide_in_any_thread() const override;
+
+	/**
+	 * @brief Delete object created by factory, if any.
+	 */
+	virtual void destroy_object() override;
+
+	/**
+	 * @return provider_kind::factory
+	 */
+	virtual provider_kind kind() const override;
+
 	/**
 	 * @return factory method object passed in constructor
 	 */
@@ -96,7 +139,10 @@ public:
 
 private:
 	factory_method _factory;
+	QThread *_object_thread;
 	std::unique_ptr<QObject> _object;
+	std::function<QObject *()> _pending_object;
+	bool _prepared;
 
 };
 
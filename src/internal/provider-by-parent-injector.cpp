@@ -34,6 +34,10 @@ const type & provider_by_parent_injector::provided_type() const
 	return _provided_type;
 }
 
+void provider_by_parent_injector::prepare(injector_core &)
+{
+}
+
 QObject * provider_by_parent_injector::provide(injector_core &)
 {
 	return _parent_injector->get(_provided_type);
@@ -44,4 +48,28 @@ bool provider_by_parent_injector::require_resolving() const
 	return false;
 }
 
+QThread * provider_by_parent_injector::object_thread() const
+{
+	return nullptr;
+}
+
+bool provider_by_parent_injector::can_provide_in_any_thread() const
+{
+	return false;
+}
+
+void provider_by_parent_injector::destroy_object()
+{
+}
+
+provider_kind provider_by_parent_injector::kind() const
+{
+	return provider_kind::parent_injector;
+}
+
+injector_impl * provider_by_parent_injector::parent_injector() const
+{
+	return _parent_injector;
+}
+
 }}
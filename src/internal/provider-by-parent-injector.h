@@ -57,6 +57,13 @@ public:
 	 */
 	virtual const type & provided_type() const override;
 
+	/**
+	 * @brief Does nothing.
+	 *
+	 * Parent injector takes care of it.
+	 */
+	virtual void prepare(injector_core &i) override;
+
 	/**
 	 * @return object returned by parent_injector
 	 * @post result != nullptr
@@ -80,6 +87,35 @@ public:
 	 */
 	virtual bool require_resolving() const override;
 
+	/**
+	 * @return nullptr
+	 *
+	 * Parent injector takes care of it.
+	 */
+	virtual QThread * object_thread() const override;
+
+	/**
+	 * @return false
+	 *
+	 * Parent injector takes care of it.
+	 */
+	virtual bool can_provide_in_any_thread() const override;
+
+	/**
+	 * @brief Does nothing, object is owned by parent injector.
+	 */
+	virtual void destroy_object() override;
+
+	/**
+	 * @return provider_kind::parent_injector
+	 */
+	virtual provider_kind kind() const override;
+
+	/**
+	 * @return injector that provides objects
+	 */
+	injector_impl * parent_injector() const;
+
 private:
 	injector_impl *_parent_injector;
 	type _provided_type;
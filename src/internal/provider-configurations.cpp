@@ -0,0 +1,65 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "provider-configurations.h"
+
+#include "interfaces-utils.h"
+#include "provider.h"
+#include "trace-recorder.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace injeqt { namespace internal {
+
+types_by_name make_known_types(const std::vector<std::shared_ptr<provider_configuration>> &configurations, std::size_t threshold)
+{
+	trace_span span{"types_by_name"};
+
+	auto extract_types_lamdba = [](const std::shared_ptr<provider_configuration> &pc){
+		auto result = std::vector<type>{};
+		for (auto &&t : pc->types())
+		{
+			auto &&interfaces = extract_interfaces(t);
+			std::copy(std::begin(interfaces), std::end(interfaces), std::back_inserter(result));
+		}
+		return result;
+	};
+	auto extract_types = std::function<std::vector<type>(const std::shared_ptr<provider_configuration> &)>{extract_types_lamdba};
+
+	auto all_types = std::vector<type>{};
+	for (auto &&configuration_types : parallel_transform(configurations, extract_types, threshold))
+		std::copy(std::begin(configuration_types), std::end(configuration_types), std::back_inserter(all_types));
+	return types_by_name{all_types};
+}
+
+std::vector<std::unique_ptr<provider>> make_providers(const std::vector<std::shared_ptr<provider_configuration>> &configurations,
+	const types_by_name &known_types, std::size_t threshold)
+{
+	auto create_provider_lambda = [&known_types](const std::shared_ptr<provider_configuration> &pc){
+		trace_span span{"create_provider"};
+		return pc->create_provider(known_types);
+	};
+	auto create_provider = std::function<std::unique_ptr<provider>(const std::shared_ptr<provider_configuration> &)>{create_provider_lambda};
+	return parallel_transform(configurations, create_provider, threshold);
+}
+
+}}
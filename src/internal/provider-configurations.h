@@ -0,0 +1,64 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+#include "provider-configuration.h"
+#include "thread-call.h"
+#include "types-by-name.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains functions for creating providers from many provider configurations at once.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @return all types known to @p configurations together with their interfaces
+ * @param configurations configurations of injector
+ * @param threshold if there are fewer configurations, all are read in current thread
+ *
+ * Reading metadata of types is the expensive part, so configurations are read in parallel and
+ * results are merged in order. Result does not depend on @p threshold.
+ */
+INJEQT_INTERNAL_API types_by_name make_known_types(const std::vector<std::shared_ptr<provider_configuration>> &configurations,
+	std::size_t threshold = parallel_transform_threshold);
+
+/**
+ * @return providers created by @p configurations, in order of @p configurations
+ * @param configurations configurations of injector
+ * @param known_types all types known to injector, see make_known_types()
+ * @param threshold if there are fewer configurations, all providers are created in current thread
+ * @throw any exception thrown by provider_configuration::create_provider(const types_by_name &), if many
+ *        configurations are invalid then exception of first of them is thrown, as if providers were created in order
+ *
+ * Result does not depend on @p threshold.
+ */
+INJEQT_INTERNAL_API std::vector<std::unique_ptr<provider>> make_providers(const std::vector<std::shared_ptr<provider_configuration>> &configurations,
+	const types_by_name &known_types, std::size_t threshold = parallel_transform_threshold);
+
+}}
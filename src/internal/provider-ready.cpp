@@ -37,6 +37,10 @@ const implementation & provider_ready::ready_implementation() const
 	return _ready_implementation;
 }
 
+void provider_ready::prepare(injector_core &)
+{
+}
+
 QObject * provider_ready::provide(injector_core &)
 {
 	return _ready_implementation.object();
@@ -47,4 +51,23 @@ bool provider_ready::require_resolving() const
 	return false;
 }
 
+QThread * provider_ready::object_thread() const
+{
+	return nullptr;
+}
+
+bool provider_ready::can_provide_in_any_thread() const
+{
+	return false;
+}
+
+void provider_ready::destroy_object()
+{
+}
+
+provider_kind provider_ready::kind() const
+{
+	return provider_kind::ready;
+}
+
 }}
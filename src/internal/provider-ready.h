@@ -56,6 +56,13 @@ public:
 	 */
 	virtual const type & provided_type() const override;
 
+	/**
+	 * @brief Does nothing.
+	 *
+	 * Object is already created.
+	 */
+	virtual void prepare(injector_core &i) override;
+
 	/**
 	 * @return object passed in constructor
 	 * @post result != nullptr
@@ -75,6 +82,30 @@ public:
 	 */
 	virtual bool require_resolving() const override;
 
+	/**
+	 * @return nullptr
+	 *
+	 * Object is already created and lives in its own thread.
+	 */
+	virtual QThread * object_thread() const override;
+
+	/**
+	 * @return false
+	 *
+	 * Object is already created, so there is nothing to do in other thread.
+	 */
+	virtual bool can_provide_in_any_thread() const override;
+
+	/**
+	 * @brief Does nothing, object is owned by its creator.
+	 */
+	virtual void destroy_object() override;
+
+	/**
+	 * @return provider_kind::ready
+	 */
+	virtual provider_kind kind() const override;
+
 	/**
 	 * @return implementation object passed in constructor
 	 */
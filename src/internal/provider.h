@@ -30,11 +30,38 @@
  */
 
 class QObject;
+class QThread;
 
 namespace injeqt { namespace internal {
 
 class injector_core;
 
+/**
+ * @brief Way in which provider gets its objects.
+ */
+enum class provider_kind
+{
+	/**
+	 * @brief Objects are created with Q_INVOKABLE default constructor.
+	 */
+	default_constructor,
+
+	/**
+	 * @brief Objects are returned by factory method of other object.
+	 */
+	factory,
+
+	/**
+	 * @brief Object was created by user and added to module.
+	 */
+	ready,
+
+	/**
+	 * @brief Objects are taken from parent injector.
+	 */
+	parent_injector
+};
+
 /**
  * @brief Abstract provider of objects.
  *
@@ -62,6 +89,18 @@ public:
 	 */
 	virtual const type & provided_type() const = 0;
 
+	/**
+	 * @brief Start creating provided object.
+	 * @param i injector_core that requests object
+	 *
+	 * Injector calls prepare(injector_core &) of all objects created together before calling
+	 * provide(injector_core &) of any of them. Provider can start asynchronous work here and
+	 * wait for it in provide(injector_core &), so independent objects are created at the same
+	 * time. Types returned by required_types() are already available in injector_core.
+	 * Calling provide(injector_core &) without prepare(injector_core &) must also work.
+	 */
+	virtual void prepare(injector_core &i) = 0;
+
 	/**
 	 * @return provided object
 	 * @param i injector_core that requests object
@@ -87,6 +126,37 @@ public:
 	 */
 	virtual bool require_resolving() const = 0;
 
+	/**
+	 * @return thread that provided object must live in or nullptr if it can live in any thread
+	 *
+	 * Injector calls setters and INJEQT_INIT methods of provided object in that thread.
+	 * Return value of this method must be the same for whole lifetime of this object.
+	 */
+	virtual QThread * object_thread() const = 0;
+
+	/**
+	 * @return true, if provide(injector_core &) can be called from any thread
+	 *
+	 * Injector can then call provide(injector_core &) of many such providers at the same time
+	 * from threads of QThreadPool. Object created in pool thread is moved to thread that
+	 * requested it by injector.
+	 */
+	virtual bool can_provide_in_any_thread() const = 0;
+
+	/**
+	 * @brief Delete provided object if this provider owns it.
+	 *
+	 * Injector calls it from thread that provided object lives in, when that object was moved
+	 * to other thread than one that will destroy this provider. Provided object must not be used
+	 * after this call.
+	 */
+	virtual void destroy_object() = 0;
+
+	/**
+	 * @return way in which this provider gets its objects
+	 */
+	virtual provider_kind kind() const = 0;
+
 };
 
 }}
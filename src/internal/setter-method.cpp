@@ -24,7 +24,10 @@
 #include <injeqt/type.h>
 
 #include "interfaces-utils.h"
+#include "trusted-scope.h"
+#include "type-metadata.h"
 
+#include <QtCore/QThread>
 #include <cassert>
 
 namespace injeqt { namespace internal {
@@ -51,7 +54,7 @@ bool setter_method::validate_setter_method(type parameter_type, const QMetaMetho
 		throw exception::invalid_setter{std::string{"invalid parameter (empty): "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
 	if (parameter_type.is_empty())
 		throw exception::invalid_setter{std::string{"invalid parameter (qobject): "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
-	if (parameter_type.name() + "*" != std::string{meta_method.parameterTypes()[0].data()})
+	if (type_metadata_for(parameter_type).pointer_name() != meta_method.parameterTypes()[0].data())
 		throw exception::invalid_setter{std::string{"invalid parameter (type): "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
 	return true;
 }
@@ -63,9 +66,10 @@ setter_method::setter_method()
 setter_method::setter_method(type parameter_type, QMetaMethod meta_method) :
 	_object_type{meta_method.enclosingMetaObject()},
 	_parameter_type{std::move(parameter_type)},
-	_meta_method{std::move(meta_method)}
+	_meta_method{std::move(meta_method)},
+	_call{_meta_method}
 {
-	assert(validate_setter_method(parameter_type, meta_method));
+	assert(validate_setter_method(_parameter_type, _meta_method));
 }
 
 bool setter_method::is_empty() const
@@ -97,12 +101,18 @@ bool setter_method::invoke(QObject *on, QObject *parameter) const
 {
 	assert(!is_empty());
 	assert(on != nullptr);
-	assert(implements(type{on->metaObject()}, _object_type));
+	assert(trusted_scope::is_active() || implements(type{on->metaObject()}, _object_type));
 	assert(parameter != nullptr);
 	assert(!type{parameter->metaObject()}.is_empty());
-	assert(implements(type{parameter->metaObject()}, _parameter_type));
+	assert(trusted_scope::is_active() || implements(type{parameter->metaObject()}, _parameter_type));
 
-	return _meta_method.invoke(on, Q_ARG(QObject *, parameter));
+	// QMetaMethod::invoke would queue call to object living in other thread
+	if (on->thread() != QThread::currentThread())
+		return _meta_method.invoke(on, Q_ARG(QObject *, parameter));
+
+	void *arguments[] = {nullptr, &parameter};
+	_call.invoke(on, arguments);
+	return true;
 }
 
 bool operator == (const setter_method &x, const setter_method &y)
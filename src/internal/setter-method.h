@@ -24,6 +24,7 @@
 #include <injeqt/injeqt.h>
 #include <injeqt/type.h>
 
+#include "direct-call.h"
 #include "internal.h"
 #include "types-by-name.h"
 
@@ -143,6 +144,7 @@ private:
 	type _object_type;
 	type _parameter_type;
 	QMetaMethod _meta_method;
+	direct_call _call;
 
 };
 
@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <vector>
 
 namespace injeqt { namespace internal {
@@ -83,13 +84,13 @@ public:
 	 * @short Create sorted_unique_vector from given vector.
 	 * @param storage vector to get data from
 	 *
-	 * Copies content of storage, sorts it and removes duplicates.
+	 * Copies content of storage, sorts it and removes duplicates. If storage is already
+	 * sorted and unique (for example it was filled in key order) it is only checked in O(n).
 	 */
 	explicit sorted_unique_vector(storage_type storage) :
 			_content{std::move(storage)}
 	{
-		std::stable_sort(std::begin(_content), std::end(_content), compare_keys);
-		ensure_unique(_content);
+		ensure_sorted_unique();
 	}
 
 	/**
@@ -101,8 +102,7 @@ public:
 	explicit sorted_unique_vector(std::initializer_list<value_type> values) :
 			_content{std::move(values)}
 	{
-		std::stable_sort(std::begin(_content), std::end(_content), compare_keys);
-		ensure_unique(_content);
+		ensure_sorted_unique();
 	}
 
 	const_iterator begin() const
@@ -122,10 +122,16 @@ public:
 	 * Item is added at proper place so vector remains sorted. Item will not be
 	 * added if another one that compares equal (using EqualityComparator)
 	 * already exists.
+	 *
+	 * Adding item greater than all stored items is amortized O(1), adding in the
+	 * middle is O(n). Use add_all(storage_type) to add many unsorted items. Only appending,
+	 * add_all(storage_type) and merge(const type &) are fast on purpose: injector builds all its
+	 * sorted vectors at once and does not add single items to them, so keeping storage in one
+	 * sorted array for O(log n) lookups without extra levels is cheaper than faster middle inserts.
 	 */
 	void add(value_type item)
 	{
-		if (_content.empty())
+		if (_content.empty() || compare_keys(_content.back(), item))
 		{
 			_content.emplace_back(std::move(item));
 			return;
@@ -136,22 +142,47 @@ public:
 			_content.emplace(upperBound, std::move(item));
 	}
 
+	/**
+	 * @short Add many items to sorted vector.
+	 * @param items new items, in any order
+	 *
+	 * Items are appended, sorted once and merged in place with existing ones, so adding
+	 * m items costs O(m log m + n) instead of O(m n) of calling add(value_type) m times.
+	 * If all items are greater than stored ones, cost is O(m log m). As with add(value_type),
+	 * already stored items are kept when items that compare equal are added.
+	 */
+	void add_all(storage_type items)
+	{
+		auto tail_index = _content.size();
+		_content.insert(std::end(_content), std::make_move_iterator(std::begin(items)), std::make_move_iterator(std::end(items)));
+		std::stable_sort(std::begin(_content) + tail_index, std::end(_content), compare_keys);
+		merge_tail(tail_index);
+	}
+
 	/**
 	 * @short Merge with another sorted vector.
 	 * @param sorted_vector vector to merge with
 	 *
 	 * All items from sorted_vector are added at proper places and duplicates are removed.
+	 * Merge is done in place. If all items from sorted_vector are greater than stored ones,
+	 * these are just appended in amortized O(m).
 	 */
 	void merge(const type &sorted_vector)
 	{
-		auto result = storage_type{};
+		if (&sorted_vector == this)
+			return;
 
-		std::merge(std::begin(_content), std::end(_content),
-			std::begin(sorted_vector._content), std::end(sorted_vector._content),
-			std::back_inserter(result), compare_keys);
-		ensure_unique(result);
+		auto tail_index = _content.size();
+		_content.insert(std::end(_content), std::begin(sorted_vector._content), std::end(sorted_vector._content));
+		merge_tail(tail_index);
+	}
 
-		_content = std::move(result);
+	/**
+	 * @short Reserve storage for @p size items.
+	 */
+	void reserve(size_type size)
+	{
+		_content.reserve(size);
 	}
 
 	/**
@@ -229,11 +260,46 @@ public:
 private:
 	storage_type _content;
 
+	void ensure_sorted_unique()
+	{
+		auto not_increasing = std::adjacent_find(std::begin(_content), std::end(_content),
+			[](const value_type &v1, const value_type &v2){ return !compare_keys(v1, v2); });
+		if (not_increasing == std::end(_content))
+			return;
+
+		std::stable_sort(std::begin(_content), std::end(_content), compare_keys);
+		ensure_unique(_content);
+	}
+
 	void ensure_unique(storage_type &storage)
 	{
 		storage.erase(std::unique(std::begin(storage), std::end(storage), keys_equal), std::end(storage));
 	}
 
+	/**
+	 * @short Merge sorted tail of storage starting at @p tail_index with sorted items before it.
+	 *
+	 * Both parts must be sorted. Items from before tail are kept when equal items are in tail,
+	 * as std::inplace_merge is stable. If all tail items are greater than items before it, only
+	 * duplicates inside of tail are removed.
+	 */
+	void merge_tail(size_type tail_index)
+	{
+		auto first = std::begin(_content);
+		auto tail = first + tail_index;
+		auto last = std::end(_content);
+		if (tail == last)
+			return;
+
+		if (tail != first && !compare_keys(*(tail - 1), *tail))
+		{
+			std::inplace_merge(first, tail, last, compare_keys);
+			ensure_unique(_content);
+		}
+		else
+			_content.erase(std::unique(tail, last, keys_equal), last);
+	}
+
 };
 
 /**
@@ -280,19 +346,43 @@ enum class match_increment_mode
 	left
 };
 
-template<typename K, typename K1, typename K2, typename V1, typename V2, K1 (*KeyExtractor1)(const V1 &), K2 (*KeyExtractor2)(const V2 &)>
-match_result<K1, K2, V1, V2, KeyExtractor1, KeyExtractor2>
-match(
+/**
+ * @brief Callback for streaming match() that ignores its arguments.
+ */
+struct match_ignore
+{
+	template<typename... T>
+	void operator () (const T &...) const
+	{
+	}
+};
+
+/**
+ * @brief Match two sorted vectors by keys without materializing results.
+ * @param suv_1 first vector
+ * @param suv_2 second vector
+ * @param ke1 key extractor for items of first vector
+ * @param ke2 key extractor for items of second vector
+ * @param on_matched called with pair of items with equal keys
+ * @param on_unmatched_1 called with items of first vector without equal key in second one
+ * @param on_unmatched_2 called with items of second vector without equal key in first one
+ * @param increment_mode match_increment_mode::left allows one item of second vector to be matched many times
+ *
+ * Callbacks are called in key order and this function does not allocate. Pass match_ignore{}
+ * for outcomes that are not needed.
+ */
+template<typename K, typename K1, typename K2, typename V1, typename V2, K1 (*KeyExtractor1)(const V1 &), K2 (*KeyExtractor2)(const V2 &),
+	typename M, typename U1, typename U2>
+void match(
 	const sorted_unique_vector<K1, V1, KeyExtractor1> &suv_1,
 	const sorted_unique_vector<K2, V2, KeyExtractor2> &suv_2,
 	K(*ke1)(const V1 &),
 	K(*ke2)(const V2 &),
+	M on_matched,
+	U1 on_unmatched_1,
+	U2 on_unmatched_2,
 	match_increment_mode increment_mode = match_increment_mode::both)
 {
-	auto unmatched_1 = std::vector<V1>{};
-	auto unmatched_2 = std::vector<V2>{};
-	auto matched = std::vector<std::pair<V1, V2>>{};
-
 	auto suv_1_it = begin(suv_1);
 	auto suv_1_end = end(suv_1);
 	auto suv_2_it = begin(suv_2);
@@ -304,7 +394,7 @@ match(
 		auto suv_2_key = ke2(*suv_2_it);
 		if (suv_1_key == suv_2_key)
 		{
-			matched.emplace_back(*suv_1_it, *suv_2_it);
+			on_matched(*suv_1_it, *suv_2_it);
 			switch (increment_mode)
 			{
 				case match_increment_mode::both:
@@ -318,33 +408,54 @@ match(
 		}
 		else if (suv_1_key < suv_2_key)
 		{
-			unmatched_1.emplace_back(*suv_1_it);
+			on_unmatched_1(*suv_1_it);
 			++suv_1_it;
 		}
 		else if (suv_2_key < suv_1_key)
 		{
-			unmatched_2.emplace_back(*suv_2_it);
+			on_unmatched_2(*suv_2_it);
 			++suv_2_it;
 		}
 	}
 
 	while (suv_1_it != suv_1_end)
 	{
-		unmatched_1.emplace_back(*suv_1_it);
+		on_unmatched_1(*suv_1_it);
 		suv_1_it++;
 	}
 
 	while (suv_2_it != suv_2_end)
 	{
-		unmatched_2.emplace_back(*suv_2_it);
+		on_unmatched_2(*suv_2_it);
 		suv_2_it++;
 	}
+}
+
+template<typename K, typename K1, typename K2, typename V1, typename V2, K1 (*KeyExtractor1)(const V1 &), K2 (*KeyExtractor2)(const V2 &)>
+match_result<K1, K2, V1, V2, KeyExtractor1, KeyExtractor2>
+match(
+	const sorted_unique_vector<K1, V1, KeyExtractor1> &suv_1,
+	const sorted_unique_vector<K2, V2, KeyExtractor2> &suv_2,
+	K(*ke1)(const V1 &),
+	K(*ke2)(const V2 &),
+	match_increment_mode increment_mode = match_increment_mode::both)
+{
+	auto unmatched_1 = std::vector<V1>{};
+	auto unmatched_2 = std::vector<V2>{};
+	auto matched = std::vector<std::pair<V1, V2>>{};
+
+	match(suv_1, suv_2, ke1, ke2,
+		[&matched](const V1 &v1, const V2 &v2){ matched.emplace_back(v1, v2); },
+		[&unmatched_1](const V1 &v1){ unmatched_1.emplace_back(v1); },
+		[&unmatched_2](const V2 &v2){ unmatched_2.emplace_back(v2); },
+		increment_mode);
 
+	// both unmatched vectors are filled in key order, so these are not sorted again
 	return
 	{
-		matched,
-		sorted_unique_vector<K1, V1, KeyExtractor1>{unmatched_1},
-		sorted_unique_vector<K2, V2, KeyExtractor2>{unmatched_2}
+		std::move(matched),
+		sorted_unique_vector<K1, V1, KeyExtractor1>{std::move(unmatched_1)},
+		sorted_unique_vector<K2, V2, KeyExtractor2>{std::move(unmatched_2)}
 	};
 }
 
@@ -0,0 +1,202 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "thread-call.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+QEvent::Type call_event_type()
+{
+	static auto result = static_cast<QEvent::Type>(QEvent::registerEventType());
+	return result;
+}
+
+class call_event final : public QEvent
+{
+
+public:
+	explicit call_event(const std::function<void()> &function, QSemaphore &done, std::exception_ptr &error) :
+			QEvent{call_event_type()},
+			_function(function),
+			_done(done),
+			_error(error)
+	{
+	}
+
+	void call()
+	{
+		try
+		{
+			_function();
+		}
+		catch (...)
+		{
+			_error = std::current_exception();
+		}
+
+		// waiting thread can return right after release, so nothing from its stack can be used later
+		_done.release();
+	}
+
+private:
+	const std::function<void()> &_function;
+	QSemaphore &_done;
+	std::exception_ptr &_error;
+
+};
+
+class call_receiver final : public QObject
+{
+
+public:
+	virtual bool event(QEvent *e) override
+	{
+		if (e->type() != call_event_type())
+			return QObject::event(e);
+
+		deleteLater();
+		static_cast<call_event *>(e)->call();
+		return true;
+	}
+
+};
+
+class call_runnable final : public QRunnable
+{
+
+public:
+	explicit call_runnable(std::function<void()> function) :
+			_function{std::move(function)}
+	{
+		setAutoDelete(true);
+	}
+
+	virtual void run() override
+	{
+		_function();
+	}
+
+private:
+	std::function<void()> _function;
+
+};
+
+/**
+ * @brief State shared by all threads taking part in one call_in_thread_pool(std::size_t, ...).
+ *
+ * Pool threads can start after all indexes were taken and caller has returned, so state is kept
+ * alive by each of them and function is only used after an index was taken.
+ */
+struct indexed_calls
+{
+	explicit indexed_calls(std::size_t count, const std::function<void(std::size_t)> &function) :
+			count{count},
+			function{function},
+			next{0},
+			errors(count)
+	{
+	}
+
+	void call_all()
+	{
+		for (auto index = next++; index < count; index = next++)
+		{
+			try
+			{
+				function(index);
+			}
+			catch (...)
+			{
+				errors[index] = std::current_exception();
+			}
+
+			finished.release();
+		}
+	}
+
+	const std::size_t count;
+	const std::function<void(std::size_t)> &function;
+	std::atomic<std::size_t> next;
+	std::vector<std::exception_ptr> errors;
+	QSemaphore finished;
+};
+
+}
+
+void call_in_thread(QThread *thread, const std::function<void()> &function)
+{
+	if (!thread || thread == QThread::currentThread())
+	{
+		function();
+		return;
+	}
+
+	QSemaphore done;
+	auto error = std::exception_ptr{};
+
+	// receiver is created for each call, so it does not have to outlive any thread
+	auto receiver = new call_receiver{};
+	receiver->moveToThread(thread);
+	QCoreApplication::postEvent(receiver, new call_event{function, done, error});
+	done.acquire();
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void call_in_thread_pool(std::function<void()> function)
+{
+	QThreadPool::globalInstance()->start(new call_runnable{std::move(function)});
+}
+
+void call_in_thread_pool(std::size_t count, const std::function<void(std::size_t)> &function)
+{
+	if (count == 0)
+		return;
+
+	auto calls = std::make_shared<indexed_calls>(count, function);
+	auto helpers = std::min<std::size_t>(count, std::max(QThreadPool::globalInstance()->maxThreadCount(), 1)) - 1;
+	for (decltype(helpers) i = 0; i < helpers; i++)
+		call_in_thread_pool([calls](){ calls->call_all(); });
+
+	calls->call_all();
+	calls->finished.acquire(static_cast<int>(count));
+
+	for (auto &&error : calls->errors)
+		if (error)
+			std::rethrow_exception(error);
+}
+
+}}
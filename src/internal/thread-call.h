@@ -0,0 +1,108 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+class QThread;
+
+/**
+ * @file
+ * @brief Contains classes and functions for calling functions in other threads.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Call @p function in @p thread and wait until it returns.
+ * @param thread thread to call function in, nullptr means current thread
+ * @param function function to call
+ * @throw any exception thrown by @p function
+ *
+ * If @p thread is nullptr or current thread then @p function is called directly. Otherwise an event
+ * is posted to a receiver living in @p thread and current thread waits until event loop of @p thread
+ * calls @p function. Current thread does not process its own events while waiting, so it is blocked
+ * only for time needed to call @p function. Exception thrown by @p function is rethrown in current thread.
+ *
+ * @p thread must be running its event loop. If it is not or if it waits for current thread then
+ * this function never returns.
+ */
+INJEQT_INTERNAL_API void call_in_thread(QThread *thread, const std::function<void()> &function);
+
+/**
+ * @brief Call @p function in global QThreadPool and return immediately.
+ * @param function function to call
+ *
+ * Function is copied and called in one of threads of QThreadPool::globalInstance(). It must not
+ * throw - there is no one to catch exception in pool thread.
+ */
+INJEQT_INTERNAL_API void call_in_thread_pool(std::function<void()> function);
+
+/**
+ * @brief Call @p function for each index from 0 to @p count - 1 in global QThreadPool and wait until all calls return.
+ * @param count number of calls
+ * @param function function to call with index
+ * @throw any exception thrown by @p function, if many calls throw then one with lowest index is rethrown
+ *
+ * Current thread takes indexes too, so all calls are done even if all pool threads are busy - for example
+ * when this function is called from pool thread. Each index is passed to @p function exactly once. Calls
+ * continue after one of them throws.
+ */
+INJEQT_INTERNAL_API void call_in_thread_pool(std::size_t count, const std::function<void(std::size_t)> &function);
+
+/**
+ * @brief Default minimal number of items that parallel_transform() splits between threads.
+ *
+ * Calls for fewer items are cheaper than waking pool threads up.
+ */
+const std::size_t parallel_transform_threshold = 32;
+
+/**
+ * @brief Transform each item of @p source with @p f, calling it for many items at once in global QThreadPool.
+ * @tparam S type of source items
+ * @tparam T type of result items, must be default constructible
+ * @param source source data
+ * @param f transforming function, must be safe to call from many threads at once
+ * @param threshold if @p source has fewer items, all are transformed in current thread
+ * @throw any exception thrown by @p f, if many calls throw then one for item with lowest index is rethrown
+ *
+ * Result is in order of @p source. Result of @p f must not depend on calls for other items, then result and
+ * thrown exception are the same as if @p f was called for each item in order.
+ */
+template<typename S, typename T>
+inline std::vector<T> parallel_transform(const std::vector<S> &source, const std::function<T(const S &)> &f, std::size_t threshold = parallel_transform_threshold)
+{
+	auto result = std::vector<T>(source.size());
+	if (source.size() < threshold)
+		for (decltype(source.size()) i = 0; i < source.size(); i++)
+			result[i] = f(source[i]);
+	else
+		call_in_thread_pool(source.size(), [&](std::size_t i){ result[i] = f(source[i]); });
+	return result;
+}
+
+}}
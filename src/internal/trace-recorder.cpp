@@ -0,0 +1,132 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "trace-recorder.h"
+
+#include "json-string.h"
+
+#include <QtCore/QMetaMethod>
+#include <QtCore/QMetaObject>
+#include <fstream>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+int current_thread_number()
+{
+	static std::atomic<int> next_thread_number{1};
+	thread_local auto result = next_thread_number.fetch_add(1, std::memory_order_relaxed);
+	return result;
+}
+
+}
+
+std::atomic<bool> trace_recorder::_enabled{false};
+
+trace_recorder & trace_recorder::instance()
+{
+	// never destroyed, so spans of injectors destroyed during static destruction can still be recorded
+	static auto result = new trace_recorder{};
+	return *result;
+}
+
+trace_recorder::trace_recorder()
+{
+}
+
+void trace_recorder::start()
+{
+	std::lock_guard<std::mutex> lock{_mutex};
+	_start = clock::now();
+	_events.clear();
+	_enabled.store(true, std::memory_order_relaxed);
+}
+
+void trace_recorder::stop()
+{
+	std::lock_guard<std::mutex> lock{_mutex};
+	_enabled.store(false, std::memory_order_relaxed);
+}
+
+void trace_recorder::record(std::string name, clock::time_point span_start, clock::time_point span_end)
+{
+	auto thread = current_thread_number();
+
+	std::lock_guard<std::mutex> lock{_mutex};
+	if (!is_enabled() || span_start < _start)
+		return;
+
+	auto start = std::chrono::duration_cast<std::chrono::microseconds>(span_start - _start).count();
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(span_end - span_start).count();
+	_events.push_back(trace_event{std::move(name), start, duration, thread});
+}
+
+std::vector<trace_event> trace_recorder::events() const
+{
+	std::lock_guard<std::mutex> lock{_mutex};
+	return _events;
+}
+
+void trace_span::begin(std::string name)
+{
+	_name = std::move(name);
+	_start = trace_recorder::clock::now();
+}
+
+void trace_span::begin(const char *name, const type &detail)
+{
+	begin(std::string{name} + " " + detail.name());
+}
+
+void trace_span::begin(const char *name, const QMetaMethod &detail)
+{
+	auto class_name = detail.enclosingMetaObject() ? detail.enclosingMetaObject()->className() : "";
+	begin(std::string{name} + " " + class_name + "::" + detail.methodSignature().data());
+}
+
+void trace_span::end()
+{
+	trace_recorder::instance().record(std::move(_name), _start, trace_recorder::clock::now());
+}
+
+bool write_trace_events(const std::string &file_name, const std::vector<trace_event> &events, std::int64_t process_id)
+{
+	std::ofstream file{file_name, std::ios::out | std::ios::trunc};
+	if (!file)
+		return false;
+
+	file << "{\"traceEvents\":[";
+	auto first = true;
+	for (auto &&event : events)
+	{
+		file << (first ? "\n" : ",\n") << "{\"name\":";
+		write_json_string(file, event.name);
+		file << ",\"cat\":\"injeqt\",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << event.duration
+			<< ",\"pid\":" << process_id << ",\"tid\":" << event.thread << "}";
+		first = false;
+	}
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	file.close();
+	return static_cast<bool>(file);
+}
+
+}}
@@ -0,0 +1,191 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class QMetaMethod;
+
+/**
+ * @file
+ * @brief Contains classes and functions for recording trace events of injectors.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Span recorded by trace_recorder.
+ *
+ * Times are in microseconds, @p start is measured from start of tracing. @p thread is small
+ * number assigned to each thread on its first span. Spans are nested if one is contained in
+ * time range of other and both have the same @p thread.
+ */
+struct trace_event
+{
+	std::string name;
+	std::int64_t start;
+	std::int64_t duration;
+	int thread;
+};
+
+/**
+ * @brief Process-wide recorder of trace_event spans.
+ * @see injeqt::v1::start_tracing()
+ *
+ * Recorder is disabled by default. is_enabled() is inline and only loads one atomic flag, so
+ * trace_span objects cost almost nothing until start() is called. This class is thread safe.
+ */
+class INJEQT_INTERNAL_API trace_recorder final
+{
+
+public:
+	using clock = std::chrono::steady_clock;
+
+	/**
+	 * @return the only instance of trace_recorder
+	 */
+	static trace_recorder & instance();
+
+	/**
+	 * @return true if start() was called and stop() was not called after it
+	 */
+	static bool is_enabled()
+	{
+		return _enabled.load(std::memory_order_relaxed);
+	}
+
+	trace_recorder(const trace_recorder &) = delete;
+	trace_recorder & operator = (const trace_recorder &) = delete;
+
+	/**
+	 * @brief Clear all events and start recording.
+	 */
+	void start();
+
+	/**
+	 * @brief Stop recording. Recorded events are kept.
+	 */
+	void stop();
+
+	/**
+	 * @brief Record span named @p name from @p span_start to @p span_end on current thread.
+	 *
+	 * Does nothing if recording is not enabled.
+	 */
+	void record(std::string name, clock::time_point span_start, clock::time_point span_end);
+
+	/**
+	 * @return all events in order of their end
+	 */
+	std::vector<trace_event> events() const;
+
+private:
+	static std::atomic<bool> _enabled;
+
+	mutable std::mutex _mutex;
+	clock::time_point _start;
+	std::vector<trace_event> _events;
+
+	trace_recorder();
+
+};
+
+/**
+ * @brief RAII span of trace_recorder.
+ *
+ * Records span from construction to destruction if tracing was enabled at construction. Name
+ * of span is only built when tracing is enabled.
+ */
+class INJEQT_INTERNAL_API trace_span final
+{
+
+public:
+	explicit trace_span(const char *name) :
+			_enabled{trace_recorder::is_enabled()}
+	{
+		if (_enabled)
+			begin(std::string{name});
+	}
+
+	/**
+	 * @brief Span with name of @p detail type appended to @p name.
+	 */
+	trace_span(const char *name, const type &detail) :
+			_enabled{trace_recorder::is_enabled()}
+	{
+		if (_enabled)
+			begin(name, detail);
+	}
+
+	/**
+	 * @brief Span with class name and signature of @p detail method appended to @p name.
+	 */
+	trace_span(const char *name, const QMetaMethod &detail) :
+			_enabled{trace_recorder::is_enabled()}
+	{
+		if (_enabled)
+			begin(name, detail);
+	}
+
+	~trace_span()
+	{
+		if (_enabled)
+			end();
+	}
+
+	trace_span(const trace_span &) = delete;
+	trace_span & operator = (const trace_span &) = delete;
+
+private:
+	bool _enabled;
+	std::string _name;
+	trace_recorder::clock::time_point _start;
+
+	void begin(std::string name);
+	void begin(const char *name, const type &detail);
+	void begin(const char *name, const QMetaMethod &detail);
+	void end();
+
+};
+
+/**
+ * @brief Write @p events as trace event JSON to file @p file_name.
+ * @param file_name name of file to write
+ * @param events events to write
+ * @param process_id id of process written in each event
+ * @return false if file could not be written
+ *
+ * Written file can be loaded in chrome://tracing or Perfetto. Each event is written as complete
+ * ("X") event in "injeqt" category.
+ */
+INJEQT_INTERNAL_API bool write_trace_events(const std::string &file_name, const std::vector<trace_event> &events, std::int64_t process_id);
+
+}}
@@ -0,0 +1,49 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "trusted-scope.h"
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+thread_local int active_scopes = 0;
+
+}
+
+bool trusted_scope::is_active()
+{
+	return active_scopes > 0;
+}
+
+trusted_scope::trusted_scope(bool active) :
+	_active{active}
+{
+	if (_active)
+		active_scopes++;
+}
+
+trusted_scope::~trusted_scope()
+{
+	if (_active)
+		active_scopes--;
+}
+
+}}
@@ -0,0 +1,66 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+/**
+ * @file
+ * @brief Contains class for skipping debug assertions of trusted injectors.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Skips expensive debug assertions in current thread while it exists.
+ * @see validation_level::trusted
+ *
+ * Assertions checking relations between types, like implements() or extract_interfaces(), dominate
+ * time of debug builds on large configurations. These assertions are written as
+ * assert(trusted_scope::is_active() || condition), so these are skipped in thread that runs code of
+ * injector with trusted validation level. Scopes can be nested. Inactive scope does nothing.
+ */
+class INJEQT_INTERNAL_API trusted_scope final
+{
+
+public:
+	/**
+	 * @return true if any active trusted_scope exists in current thread
+	 */
+	static bool is_active();
+
+	/**
+	 * @param active if false, created scope does nothing
+	 */
+	explicit trusted_scope(bool active);
+	~trusted_scope();
+
+	trusted_scope(const trusted_scope &) = delete;
+	trusted_scope & operator = (const trusted_scope &) = delete;
+
+private:
+	bool _active;
+
+};
+
+}}
@@ -0,0 +1,65 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "type-index.h"
+
+#include <cassert>
+#include <limits>
+
+namespace injeqt { namespace internal {
+
+const type_id type_index::invalid_id = std::numeric_limits<type_id>::max();
+
+type_index::type_index()
+{
+}
+
+type_index::type_index(std::vector<type> types) :
+		_types{std::move(types)}
+{
+	_ids.reserve(_types.size());
+	for (auto i = type_id{0}; i < _types.size(); i++)
+	{
+		assert(!_types[i].is_empty());
+		_ids.emplace(_types[i].meta_object(), i);
+	}
+
+	assert(_ids.size() == _types.size());
+}
+
+std::size_t type_index::size() const
+{
+	return _types.size();
+}
+
+type_id type_index::id_of(const type &for_type) const
+{
+	auto it = _ids.find(for_type.meta_object());
+	return it == std::end(_ids) ? invalid_id : it->second;
+}
+
+const type & type_index::type_of(type_id id) const
+{
+	assert(id < _types.size());
+
+	return _types[id];
+}
+
+}}
@@ -0,0 +1,95 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for assigning dense integer ids to types.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Dense id of a type in one type_index.
+ */
+using type_id = std::size_t;
+
+/**
+ * @brief Maps set of types to dense integer ids.
+ *
+ * Ids are assigned in order of types passed to constructor, starting from 0. These
+ * can be used as indexes of flat arrays that store per-type data, so lookup of such
+ * data is O(1) instead of binary search in sorted_unique_vector.
+ *
+ * Ids are only meaningful for type_index that assigned them.
+ */
+class INJEQT_INTERNAL_API type_index final
+{
+
+public:
+	/**
+	 * @brief Id returned for types not in index.
+	 */
+	static const type_id invalid_id;
+
+	/**
+	 * @brief Create empty type_index.
+	 */
+	type_index();
+
+	/**
+	 * @brief Create type_index of @p types.
+	 * @pre all types in @p types are unique and not empty
+	 */
+	explicit type_index(std::vector<type> types);
+
+	/**
+	 * @return number of types in index, all ids are lower than this value
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @return id of @p for_type or invalid_id if it is not in index
+	 */
+	type_id id_of(const type &for_type) const;
+
+	/**
+	 * @return type with @p id
+	 * @pre id < size()
+	 */
+	const type & type_of(type_id id) const;
+
+private:
+	std::vector<type> _types;
+	std::unordered_map<const QMetaObject *, type_id> _ids;
+
+};
+
+}}
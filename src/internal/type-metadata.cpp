@@ -0,0 +1,207 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "type-metadata.h"
+
+#include <injeqt/exception/invalid-action.h>
+
+#include "setter-method.h"
+
+#include <QtCore/QMetaClassInfo>
+#include <QtCore/QMetaObject>
+#include <cassert>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+struct type_metadata_cache_shard
+{
+	std::mutex mutex;
+	std::unordered_map<const QMetaObject *, std::unique_ptr<type_metadata>> metadata;
+};
+
+// threads reading metadata of different types at the same time, like make_core does, rarely wait for each other
+const std::size_t type_metadata_cache_shards = 64;
+
+type_metadata_cache_shard & cache(const QMetaObject *meta_object)
+{
+	// never destroyed, so injectors destroyed during static destruction can still use it
+	static auto result = new type_metadata_cache_shard[type_metadata_cache_shards];
+	// meta objects are usually placed one after another, so their addresses are divided by their size first
+	auto index = std::hash<const QMetaObject *>{}(meta_object) / sizeof(QMetaObject) % type_metadata_cache_shards;
+	return result[index];
+}
+
+types read_interfaces(const QMetaObject *meta_object)
+{
+	auto result = std::vector<type>{};
+	while (meta_object && meta_object->superClass())
+	{
+		result.emplace_back(meta_object);
+		meta_object = meta_object->superClass();
+	}
+
+	return types{result};
+}
+
+void read_action(const QMetaMethod &meta_method, std::vector<action_method> &actions, std::string &error)
+{
+	if (!error.empty())
+		return;
+
+	try
+	{
+		actions.emplace_back(make_action_method(meta_method));
+	}
+	catch (exception::invalid_action &e)
+	{
+		actions.clear();
+		error = e.what();
+	}
+}
+
+}
+
+type_metadata::type_metadata(const type &for_type) :
+		_interfaces{read_interfaces(for_type.meta_object())},
+		_pointer_name{for_type.name() + "*"},
+		_default_constructor_index{-1},
+		_warm_up_priority{0}
+{
+	assert(!for_type.is_empty());
+
+	auto meta_object = for_type.meta_object();
+	auto method_count = meta_object->methodCount();
+	for (decltype(method_count) i = 0; i < method_count; i++)
+	{
+		auto method = meta_object->method(i);
+		auto tag = std::string{method.tag()};
+		auto parameter_count = method.parameterCount();
+
+		if (setter_method::is_setter_tag(tag))
+			_setter_candidates.push_back(setter_candidate{method, parameter_count == 1 ? std::string{method.parameterTypes()[0].data()} : std::string{}});
+		else if (action_method::is_action_init_tag(tag))
+			read_action(method, _init_actions, _init_actions_error);
+		else if (action_method::is_action_done_tag(tag))
+			read_action(method, _done_actions, _done_actions_error);
+
+		if (parameter_count == 0)
+			_factory_candidates.push_back(factory_candidate{method, std::string{method.typeName()}});
+	}
+
+	auto class_info_count = meta_object->classInfoCount();
+	for (decltype(class_info_count) i = 0; i < class_info_count; i++)
+	{
+		auto class_info = meta_object->classInfo(i);
+		auto name = std::string{class_info.name()};
+		if (name == INJEQT_TYPE_ROLE_CLASSINFO_NAME)
+			_type_roles.emplace_back(class_info.value());
+		// class infos of base classes come first
+		else if (name == INJEQT_WARM_UP_PRIORITY_CLASSINFO_NAME)
+			_warm_up_priority = std::atoi(class_info.value());
+	}
+
+	auto constructor_count = meta_object->constructorCount();
+	for (decltype(constructor_count) i = 0; i < constructor_count; i++)
+	{
+		auto constructor = meta_object->constructor(i);
+		if (constructor.methodType() == QMetaMethod::Constructor && constructor.parameterCount() == 0)
+		{
+			_default_constructor_index = i;
+			break;
+		}
+	}
+}
+
+const types & type_metadata::interfaces() const
+{
+	return _interfaces;
+}
+
+const std::string & type_metadata::pointer_name() const
+{
+	return _pointer_name;
+}
+
+const std::vector<setter_candidate> & type_metadata::setter_candidates() const
+{
+	return _setter_candidates;
+}
+
+const std::vector<factory_candidate> & type_metadata::factory_candidates() const
+{
+	return _factory_candidates;
+}
+
+const std::vector<action_method> & type_metadata::init_actions() const
+{
+	if (!_init_actions_error.empty())
+		throw exception::invalid_action{_init_actions_error};
+	return _init_actions;
+}
+
+const std::vector<action_method> & type_metadata::done_actions() const
+{
+	if (!_done_actions_error.empty())
+		throw exception::invalid_action{_done_actions_error};
+	return _done_actions;
+}
+
+const std::vector<std::string> & type_metadata::type_roles() const
+{
+	return _type_roles;
+}
+
+int type_metadata::default_constructor_index() const
+{
+	return _default_constructor_index;
+}
+
+int type_metadata::warm_up_priority() const
+{
+	return _warm_up_priority;
+}
+
+const type_metadata & type_metadata_for(const type &for_type)
+{
+	assert(!for_type.is_empty());
+
+	auto meta_object = for_type.meta_object();
+	auto &c = cache(meta_object);
+	{
+		std::lock_guard<std::mutex> lock{c.mutex};
+		auto it = c.metadata.find(meta_object);
+		if (it != std::end(c.metadata))
+			return *it->second;
+	}
+
+	// metadata is read without lock, if other thread was faster its result is used
+	auto metadata = std::unique_ptr<type_metadata>{new type_metadata{for_type}};
+	std::lock_guard<std::mutex> lock{c.mutex};
+	return *c.metadata.emplace(meta_object, std::move(metadata)).first->second;
+}
+
+}}
@@ -0,0 +1,161 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "action-method.h"
+#include "internal.h"
+#include "types.h"
+
+#include <QtCore/QMetaMethod>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for caching metadata of QObject types.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Method of a type that could be a setter.
+ *
+ * Contains method tagged with INJEQT_SET or INJEQT_SETTER and name of its only parameter
+ * (or empty string if it does not have exactly one parameter). Method is not validated,
+ * as its parameter type can be only resolved with a set of known types.
+ */
+struct setter_candidate
+{
+	QMetaMethod meta_method;
+	std::string parameter_pointer_name;
+};
+
+/**
+ * @brief Method of a type that could be a factory.
+ *
+ * Contains method without parameters and name of its return type.
+ */
+struct factory_candidate
+{
+	QMetaMethod meta_method;
+	std::string return_pointer_name;
+};
+
+/**
+ * @brief Immutable metadata of QObject type that Injeqt needs.
+ *
+ * QMetaObject of a type does not change during program execution, so everything
+ * Injeqt reads from it can be computed once and reused by all injectors. Each
+ * accessor returns the same result as scanning QMetaObject again would.
+ *
+ * Invalid INJEQT_INIT and INJEQT_DONE methods are not reported on construction of
+ * type_metadata, but when init_actions() or done_actions() is called - as it was
+ * done before by extract_actions().
+ *
+ * Use type_metadata_for() to get cached instance.
+ */
+class INJEQT_INTERNAL_API type_metadata final
+{
+
+public:
+	/**
+	 * @brief Read metadata of @p for_type.
+	 * @pre !for_type.is_empty()
+	 */
+	explicit type_metadata(const type &for_type);
+
+	/**
+	 * @return for_type and all its QObject-based ancestors (excluding QObject)
+	 */
+	const types & interfaces() const;
+
+	/**
+	 * @return name of pointer to type, as used by Qt in method signatures
+	 */
+	const std::string & pointer_name() const;
+
+	/**
+	 * @return all methods tagged with INJEQT_SET or INJEQT_SETTER, in meta object order
+	 */
+	const std::vector<setter_candidate> & setter_candidates() const;
+
+	/**
+	 * @return all methods without parameters, in meta object order
+	 */
+	const std::vector<factory_candidate> & factory_candidates() const;
+
+	/**
+	 * @return all methods tagged with INJEQT_INIT, in meta object order
+	 * @throw invalid_action if any of methods tagged with INJEQT_INIT is invalid
+	 */
+	const std::vector<action_method> & init_actions() const;
+
+	/**
+	 * @return all methods tagged with INJEQT_DONE, in meta object order
+	 * @throw invalid_action if any of methods tagged with INJEQT_DONE is invalid
+	 */
+	const std::vector<action_method> & done_actions() const;
+
+	/**
+	 * @return all roles assigned with INJEQT_TYPE_ROLE macro
+	 */
+	const std::vector<std::string> & type_roles() const;
+
+	/**
+	 * @return index of Q_INVOKABLE default constructor or -1 if type does not have one
+	 */
+	int default_constructor_index() const;
+
+	/**
+	 * @return priority assigned with INJEQT_WARM_UP_PRIORITY macro or 0 if type does not have one
+	 *
+	 * If many classes in hierarchy assign priority, the one of most derived class is used.
+	 */
+	int warm_up_priority() const;
+
+private:
+	types _interfaces;
+	std::string _pointer_name;
+	std::vector<setter_candidate> _setter_candidates;
+	std::vector<factory_candidate> _factory_candidates;
+	std::vector<action_method> _init_actions;
+	std::string _init_actions_error;
+	std::vector<action_method> _done_actions;
+	std::string _done_actions_error;
+	std::vector<std::string> _type_roles;
+	int _default_constructor_index;
+	int _warm_up_priority;
+
+};
+
+/**
+ * @brief Return cached metadata of @p for_type.
+ * @pre !for_type.is_empty()
+ *
+ * Metadata is computed on first call for each type and is kept until the end of
+ * program. Returned reference is always valid. This function is thread safe.
+ */
+INJEQT_INTERNAL_API const type_metadata & type_metadata_for(const type &for_type);
+
+}}
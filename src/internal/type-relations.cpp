@@ -23,6 +23,7 @@
 #include <injeqt/exception/ambiguous-types.h>
 
 #include "interfaces-utils.h"
+#include "thread-call.h"
 
 #include <map>
 
@@ -53,15 +54,16 @@ type_relations make_type_relations(const std::vector<type> &main_types)
 	auto type_count = std::map<type, std::size_t>{};
 	auto implemented_by_type = std::map<type, type>{};
 
-	for (auto &&main_type : main_types)
-	{
-		auto interface_types = extract_interfaces(main_type);
-		for (auto &&interface_type : interface_types)
+	// metadata of types is read in parallel, counting is done in order of types
+	auto extract_interfaces_function = std::function<const types *(const type &)>{[](const type &t){ return &extract_interfaces(t); }};
+	auto all_interface_types = parallel_transform(main_types, extract_interfaces_function);
+
+	for (decltype(main_types.size()) i = 0; i < main_types.size(); i++)
+		for (auto &&interface_type : *all_interface_types[i])
 		{
 			type_count[interface_type]++;
-			implemented_by_type.insert({interface_type, main_type});
+			implemented_by_type.insert({interface_type, main_types[i]});
 		}
-	}
 
 	auto unique = std::vector<implemented_by>{};
 	auto ambiguous = std::vector<type>{};
@@ -20,25 +20,16 @@
 
 #include "type-role.h"
 
-#include <QtCore/QMetaClassInfo>
-#include <QtCore/QMetaObject>
+#include "type-metadata.h"
+
+#include <algorithm>
 
 namespace injeqt { namespace internal {
 
 bool has_type_role(type for_type, const std::string &role)
 {
-	auto meta_object = for_type.meta_object();
-	auto class_info_count = meta_object->classInfoCount();
-	for (decltype(class_info_count) i = 0; i < class_info_count; i++)
-	{
-		auto class_info = meta_object->classInfo(i);
-		auto name = std::string{class_info.name()};
-		auto value = std::string{class_info.value()};
-		if (name == INJEQT_TYPE_ROLE_CLASSINFO_NAME && value == role)
-			return true;
-	}
-
-	return false;
+	auto &&type_roles = type_metadata_for(for_type).type_roles();
+	return std::find(std::begin(type_roles), std::end(type_roles), role) != std::end(type_roles);
 }
 
 }}
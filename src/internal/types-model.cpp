@@ -23,6 +23,7 @@
 #include <injeqt/exception/ambiguous-types.h>
 #include <injeqt/exception/unresolvable-dependencies.h>
 
+#include "thread-call.h"
 #include "type-relations.h"
 
 #include <cassert>
@@ -64,19 +65,29 @@ std::vector<dependency> types_model::get_unresolvable_dependencies() const
 	return result;
 }
 
-types_model make_types_model(const types_by_name &known_types, const std::vector<type> &all_types, const std::vector<type> &need_dependencies)
+types_model make_types_model(const types_by_name &known_types, const std::vector<type> &all_types, const std::vector<type> &need_dependencies, bool validate)
 {
 	auto relations = make_type_relations(all_types);
-	validate_non_ambiguous(all_types, relations);
+	if (validate)
+		validate_non_ambiguous(all_types, relations);
+
+	// setters of types are read in parallel, exception of first invalid type is thrown as if these were read in order
+	auto extract_type_dependencies = std::function<dependencies(const type &)>{[&known_types](const type &t){
+		assert(!t.is_empty());
+		return extract_dependencies(known_types, t);
+	}};
+	auto dependency_lists = parallel_transform(need_dependencies, extract_type_dependencies);
 
 	auto all_dependencies = std::vector<type_dependencies>{};
-	std::transform(std::begin(need_dependencies), std::end(need_dependencies), std::back_inserter(all_dependencies),
-		[&](const type &t){ return make_type_dependencies(known_types, t); });
+	all_dependencies.reserve(need_dependencies.size());
+	for (decltype(need_dependencies.size()) i = 0; i < need_dependencies.size(); i++)
+		all_dependencies.emplace_back(need_dependencies[i], std::move(dependency_lists[i]));
 
 	auto available_types = relations.unique();
 	auto mapped_dependencies = types_dependencies{all_dependencies};
 	auto result = types_model(available_types, mapped_dependencies);
-	validate_non_unresolvable(result);
+	if (validate)
+		validate_non_unresolvable(result);
 
 	return result;
 }
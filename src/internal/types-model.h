@@ -95,9 +95,10 @@ private:
  * @param known_types list of all known types
  * @param all_types set of types to make model from, all types must be valid.
  * @param need_dependencies list of types that will have dependencies extracted
- * @post result.get_unresolvable_dependencies().empty()
- * @throw ambiguous_types if one or more types is ambiguous (@see make_type_relations)
- * @throw unresolvable_dependencies if a type has a dependency type not in @p all_types set
+ * @param validate if false, ambiguous types and unresolvable dependencies are not reported
+ * @post !validate || result.get_unresolvable_dependencies().empty()
+ * @throw ambiguous_types if one or more types is ambiguous (@see make_type_relations) and @p validate is true
+ * @throw unresolvable_dependencies if a type has a dependency type not in @p all_types set and @p validate is true
  * @throw dependency_on_self when type depends on self
  * @throw dependency_on_subtype when type depends on own supertype
  * @throw dependency_on_subtype when type depends on own subtype
@@ -105,7 +106,7 @@ private:
  * @throw invalid_setter if any tagged setter has parameter that is a QObject pointer
  * @throw invalid_setter if any tagged setter has other number of parameters than one
  */
-INJEQT_INTERNAL_API types_model make_types_model(const types_by_name &known_types, const std::vector<type> &all_types, const std::vector<type> &need_dependencies);
+INJEQT_INTERNAL_API types_model make_types_model(const types_by_name &known_types, const std::vector<type> &all_types, const std::vector<type> &need_dependencies, bool validate = true);
 
 /**
  * @brief Check if types model do not have unresolvable types.
@@ -0,0 +1,129 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "warm-up-scheduler.h"
+
+#include "injector-core.h"
+#include "type-metadata.h"
+
+#include <QtCore/QElapsedTimer>
+#include <algorithm>
+#include <cassert>
+
+namespace injeqt { namespace internal {
+
+warm_up_scheduler::warm_up_scheduler(std::function<std::shared_ptr<injector_core> (const type &)> core, int time_slice) :
+		_core{std::move(core)},
+		_time_slice{time_slice},
+		_next_sequence{0}
+{
+	_timer.setInterval(0);
+	QObject::connect(&_timer, &QTimer::timeout, [this](){ run_time_slice(); });
+}
+
+bool warm_up_scheduler::taken_later(const queued_type &x, const queued_type &y)
+{
+	if (x.priority != y.priority)
+		return x.priority < y.priority;
+	return x.sequence > y.sequence;
+}
+
+void warm_up_scheduler::enqueue(const std::vector<type> &types)
+{
+	for (auto &&t : types)
+		enqueue_one(t, type_metadata_for(t).warm_up_priority());
+
+	start_timer();
+}
+
+void warm_up_scheduler::enqueue(const std::vector<type> &types, int priority)
+{
+	for (auto &&t : types)
+		enqueue_one(t, priority);
+
+	start_timer();
+}
+
+void warm_up_scheduler::enqueue_one(const type &queued, int priority)
+{
+	assert(_core(queued)->is_configured(queued));
+
+	_queue.push_back(queued_type{priority, _next_sequence++, queued});
+	std::push_heap(std::begin(_queue), std::end(_queue), taken_later);
+}
+
+void warm_up_scheduler::start_timer()
+{
+	if (!is_finished() && !_timer.isActive())
+		_timer.start();
+}
+
+bool warm_up_scheduler::is_finished() const
+{
+	return _queue.empty() && _steps.empty();
+}
+
+void warm_up_scheduler::run_time_slice()
+{
+	auto timer = QElapsedTimer{};
+	timer.start();
+
+	do
+		run_step();
+	while (!is_finished() && !timer.hasExpired(_time_slice));
+
+	if (is_finished())
+		_timer.stop();
+}
+
+void warm_up_scheduler::run_step()
+{
+	if (is_finished())
+		return;
+
+	try
+	{
+		if (_steps.empty())
+		{
+			std::pop_heap(std::begin(_queue), std::end(_queue), taken_later);
+			auto next = _queue.back().queued;
+			_queue.pop_back();
+
+			// steps are taken from back
+			_steps = _core(next)->instantiation_order(next);
+			std::reverse(std::begin(_steps), std::end(_steps));
+		}
+
+		if (_steps.empty())
+			return;
+
+		auto step = _steps.back();
+		_steps.pop_back();
+		_core(step)->instantiate(step);
+	}
+	catch (...)
+	{
+		// exceptions must not leave event loop, get() of failed type reports its error again - so does
+		// get() of queued type, as all its steps are its dependencies
+		_steps.clear();
+	}
+}
+
+}}
@@ -0,0 +1,146 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <QtCore/QTimer>
+
+/**
+ * @file
+ * @brief Contains classes and functions for instantiating objects in background from Qt event loop.
+ */
+
+namespace injeqt { namespace internal {
+
+class injector_core;
+
+/**
+ * @brief Instantiates queued types in short time slices from Qt event loop.
+ * @see injector::warm_up(const std::vector<type> &)
+ *
+ * Types are queued with enqueue(const std::vector<type> &). Type with highest priority assigned with
+ * INJEQT_WARM_UP_PRIORITY is taken first, types with the same priority are taken in order of queueing.
+ * Taken type is split into steps with injector_core::instantiation_order(const type &) and each step
+ * instantiates its type with injector_core::instantiate(const type &, QThread *), so usually only one
+ * object is created in each step.
+ *
+ * Steps are done by run_time_slice(), called by zero-interval QTimer, until time slice passed to constructor
+ * expires - so at least one step is done in each slice. Then control returns to event loop. Timer is stopped
+ * when all queued types are instantiated.
+ *
+ * Objects requested with injector_core::get(const type &, QThread *) before their step are created right
+ * away, as usual, and their steps do nothing later. Errors of instantiation are ignored, so the same error
+ * is reported by next injector_core::get(const type &, QThread *) of that type.
+ *
+ * Object of this class must be used only from thread that created it and that thread must run event loop.
+ */
+class INJEQT_INTERNAL_API warm_up_scheduler final
+{
+
+public:
+	/**
+	 * @brief Default length of time slice in milliseconds.
+	 */
+	static const int default_time_slice = 4;
+
+	/**
+	 * @brief Create scheduler with empty queue.
+	 * @param core returns injector_core that provides given type, returned pointer is only used for one call
+	 * @param time_slice time in milliseconds after which control returns to event loop
+	 *
+	 * @p core is called before each step, so lazy injector can return segment that owns type of that step.
+	 */
+	explicit warm_up_scheduler(std::function<std::shared_ptr<injector_core> (const type &)> core, int time_slice = default_time_slice);
+
+	warm_up_scheduler(const warm_up_scheduler &) = delete;
+	warm_up_scheduler & operator = (const warm_up_scheduler &) = delete;
+
+	/**
+	 * @brief Queue @p types for instantiation and start timer.
+	 * @pre all @p types are configured in core
+	 */
+	void enqueue(const std::vector<type> &types);
+
+	/**
+	 * @brief Queue @p types for instantiation with @p priority and start timer.
+	 * @pre all @p types are configured in core
+	 *
+	 * Priorities assigned with INJEQT_WARM_UP_PRIORITY are ignored, so @p types are taken in their order,
+	 * unless other types have higher priority.
+	 */
+	void enqueue(const std::vector<type> &types, int priority);
+
+	/**
+	 * @return true if all queued types were instantiated or failed to instantiate
+	 */
+	bool is_finished() const;
+
+	/**
+	 * @brief Do steps until time slice expires or queue is empty.
+	 */
+	void run_time_slice();
+
+private:
+	struct queued_type
+	{
+		int priority;
+		std::size_t sequence;
+		type queued;
+	};
+
+	std::function<std::shared_ptr<injector_core> (const type &)> _core;
+	int _time_slice;
+	std::vector<queued_type> _queue;
+	std::vector<type> _steps;
+	std::size_t _next_sequence;
+	QTimer _timer;
+
+	/**
+	 * @return true if @p x should be taken from queue after @p y
+	 */
+	static bool taken_later(const queued_type &x, const queued_type &y);
+
+	/**
+	 * @brief Add @p queued with @p priority to queue.
+	 */
+	void enqueue_one(const type &queued, int priority);
+
+	/**
+	 * @brief Start timer if there is anything to do.
+	 */
+	void start_timer();
+
+	/**
+	 * @brief Do one step, taking next type from queue if needed.
+	 */
+	void run_step();
+
+};
+
+}}
@@ -53,6 +53,13 @@ void module::add_type(type t)
 	_pimpl->add_provider_configuration(std::make_shared<internal::provider_by_default_constructor_configuration>(std::move(t)));
 }
 
+void module::add_type(type t, QThread *thread)
+{
+	assert(!t.is_empty());
+
+	_pimpl->add_provider_configuration(std::make_shared<internal::provider_by_default_constructor_configuration>(std::move(t), thread));
+}
+
 void module::add_factory(type t, type f)
 {
 	assert(!t.is_empty());
@@ -61,4 +68,27 @@ void module::add_factory(type t, type f)
 	_pimpl->add_provider_configuration(std::make_shared<internal::provider_by_factory_configuration>(std::move(t), std::move(f)));
 }
 
+void module::add_factory(type t, type f, factory_future_reader read_future)
+{
+	assert(!t.is_empty());
+	assert(!f.is_empty());
+	assert(read_future != nullptr);
+
+	_pimpl->add_provider_configuration(std::make_shared<internal::provider_by_factory_configuration>(std::move(t), std::move(f), read_future));
+}
+
+void module::add_factory(type t, type f, factory_future_reader read_future, QThread *thread)
+{
+	assert(!t.is_empty());
+	assert(!f.is_empty());
+	assert(read_future != nullptr);
+
+	_pimpl->add_provider_configuration(std::make_shared<internal::provider_by_factory_configuration>(std::move(t), std::move(f), read_future, thread));
+}
+
+void module::add_plugin(std::string file_name, std::vector<std::string> type_names)
+{
+	_pimpl->add_plugin(internal::plugin_declaration{std::move(file_name), std::move(type_names)});
+}
+
 }}
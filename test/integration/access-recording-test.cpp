@@ -0,0 +1,196 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> created;
+
+}
+
+class dependency_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE dependency_object() { created.push_back("dependency_object"); }
+
+};
+
+class first_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE first_object() { created.push_back("first_object"); }
+
+private slots:
+	INJEQT_SET void set_dependency(dependency_object *) {}
+
+};
+
+class second_object : public QObject
+{
+	Q_OBJECT
+	// recorded order is more important than priority
+	INJEQT_WARM_UP_PRIORITY(100)
+
+public:
+	Q_INVOKABLE second_object() { created.push_back("second_object"); }
+
+};
+
+class recording_module : public injeqt::module
+{
+
+public:
+	explicit recording_module()
+	{
+		add_type<dependency_object>();
+		add_type<first_object>();
+		add_type<second_object>();
+	}
+
+};
+
+class access_recording_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void cleanup();
+	void should_record_first_access_of_requested_types();
+	void should_not_record_before_start();
+	void should_replay_recorded_order();
+	void should_skip_unknown_types_on_replay();
+	void should_not_replay_missing_file();
+
+private:
+	const std::string file_name = "access-recording-test.txt";
+
+	injeqt::injector make_injector();
+	std::vector<std::string> recorded_names();
+
+};
+
+injeqt::injector access_recording_test::make_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new recording_module{}});
+
+	return injeqt::injector{std::move(modules)};
+}
+
+std::vector<std::string> access_recording_test::recorded_names()
+{
+	auto result = std::vector<std::string>{};
+	std::ifstream file{file_name};
+	auto offset = 0ll;
+	auto duration = 0ll;
+	auto name = std::string{};
+	while (file >> offset >> duration >> name)
+		result.push_back(name);
+	return result;
+}
+
+void access_recording_test::init()
+{
+	created.clear();
+}
+
+void access_recording_test::cleanup()
+{
+	std::remove(file_name.c_str());
+}
+
+void access_recording_test::should_record_first_access_of_requested_types()
+{
+	auto injector = make_injector();
+	injector.start_access_recording();
+	injector.get<second_object>();
+	injector.instantiate<first_object>();
+	injector.get<second_object>();
+
+	QVERIFY(injector.save_access_recording(file_name));
+	QCOMPARE(recorded_names(), (std::vector<std::string>{"second_object", "first_object"}));
+}
+
+void access_recording_test::should_not_record_before_start()
+{
+	auto injector = make_injector();
+	injector.get<first_object>();
+	injector.start_access_recording();
+	injector.get<second_object>();
+
+	QVERIFY(injector.save_access_recording(file_name));
+	QCOMPARE(recorded_names(), (std::vector<std::string>{"second_object"}));
+}
+
+void access_recording_test::should_replay_recorded_order()
+{
+	{
+		auto injector = make_injector();
+		injector.start_access_recording();
+		injector.get<first_object>();
+		injector.get<second_object>();
+		QVERIFY(injector.save_access_recording(file_name));
+	}
+
+	created.clear();
+	auto injector = make_injector();
+	QVERIFY(injector.replay_access_recording(file_name));
+	QVERIFY(created.empty());
+
+	QTRY_COMPARE(created.size(), size_t{3});
+	QCOMPARE(created, (std::vector<std::string>{"dependency_object", "first_object", "second_object"}));
+}
+
+void access_recording_test::should_skip_unknown_types_on_replay()
+{
+	{
+		std::ofstream file{file_name};
+		file << "0 10 removed_object\n" << "20 10 second_object\n";
+	}
+
+	auto injector = make_injector();
+	QVERIFY(injector.replay_access_recording(file_name));
+
+	QTRY_COMPARE(created.size(), size_t{1});
+	QCOMPARE(created.front(), std::string{"second_object"});
+}
+
+void access_recording_test::should_not_replay_missing_file()
+{
+	auto injector = make_injector();
+	QVERIFY(!injector.replay_access_recording("missing-access-recording-test.txt"));
+}
+
+QTEST_GUILESS_MAIN(access_recording_test)
+#include "access-recording-test.moc"
@@ -0,0 +1,381 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+
+#include <injeqt/exception/instantiation-failed.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtCore/QFutureInterface>
+#include <QtTest/QtTest>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * Runs @p call in new thread and returns future finished by this thread. Threads are joined
+ * by destructor of thread_list, so all futures are finished before objects used by them
+ * are destroyed.
+ */
+class thread_list
+{
+
+public:
+	~thread_list()
+	{
+		for (auto &&t : _threads)
+			t.join();
+	}
+
+	template<typename T, typename F>
+	QFuture<T> run(F call)
+	{
+		auto result = QFutureInterface<T>{QFutureInterfaceBase::Started};
+		_threads.emplace_back([result, call]() mutable {
+			auto value = call();
+			result.reportFinished(&value);
+		});
+		return result.future();
+	}
+
+	template<typename F>
+	QFuture<void> run_void(F call)
+	{
+		auto result = QFutureInterface<void>{QFutureInterfaceBase::Started};
+		_threads.emplace_back([result, call]() mutable {
+			call();
+			result.reportFinished();
+		});
+		return result.future();
+	}
+
+private:
+	std::vector<std::thread> _threads;
+
+};
+
+}
+
+class slow_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE slow_object() : _initialized{false} {}
+
+	bool initialized() const { return _initialized; }
+
+private:
+	std::atomic<bool> _initialized;
+	thread_list _threads;
+
+private slots:
+	INJEQT_INIT QFuture<void> init()
+	{
+		return _threads.run_void([this]{
+			QThread::msleep(10);
+			_initialized = true;
+		});
+	}
+
+};
+
+class slow_created_object : public QObject
+{
+	Q_OBJECT
+
+};
+
+class slow_created_object_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE slow_created_object_factory() {}
+
+	Q_INVOKABLE QFuture<slow_created_object *> create()
+	{
+		auto thread = QThread::currentThread();
+		return _threads.run<slow_created_object *>([thread]{
+			QThread::msleep(10);
+			auto result = new slow_created_object{};
+			result->moveToThread(thread);
+			return result;
+		});
+	}
+
+private:
+	thread_list _threads;
+
+};
+
+class service_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_object() : _dependency_initialized_in_init{false} {}
+
+	slow_object * dependency() const { return _dependency; }
+	bool dependency_initialized_in_init() const { return _dependency_initialized_in_init; }
+
+private:
+	QPointer<slow_object> _dependency;
+	bool _dependency_initialized_in_init;
+
+private slots:
+	INJEQT_SET void set_dependency(slow_object *dependency)
+	{
+		_dependency = dependency;
+	}
+
+	INJEQT_INIT void init()
+	{
+		_dependency_initialized_in_init = _dependency && _dependency->initialized();
+	}
+
+};
+
+/*
+ * Type ids follow order of types, which compares addresses of their meta objects. These usually follow
+ * order of declarations, so pairs below are declared in opposite order and one of them has dependency
+ * with id greater than id of dependent object.
+ */
+class first_dependency;
+
+class first_dependent : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE first_dependent() : _dependency{nullptr}, _dependency_initialized_in_init{false} {}
+
+	bool dependency_initialized_in_init() const { return _dependency_initialized_in_init; }
+
+private:
+	first_dependency *_dependency;
+	bool _dependency_initialized_in_init;
+
+private slots:
+	INJEQT_SET void set_dependency(first_dependency *dependency)
+	{
+		_dependency = dependency;
+	}
+
+	INJEQT_INIT void init();
+
+};
+
+class first_dependency : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE first_dependency() : _initialized{false} {}
+
+	bool initialized() const { return _initialized; }
+
+private:
+	std::atomic<bool> _initialized;
+	thread_list _threads;
+
+private slots:
+	INJEQT_INIT QFuture<void> init()
+	{
+		return _threads.run_void([this]{
+			QThread::msleep(10);
+			_initialized = true;
+		});
+	}
+
+};
+
+void first_dependent::init()
+{
+	_dependency_initialized_in_init = _dependency && _dependency->initialized();
+}
+
+class second_dependency : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE second_dependency() : _initialized{false} {}
+
+	bool initialized() const { return _initialized; }
+
+private:
+	std::atomic<bool> _initialized;
+	thread_list _threads;
+
+private slots:
+	INJEQT_INIT QFuture<void> init()
+	{
+		return _threads.run_void([this]{
+			QThread::msleep(10);
+			_initialized = true;
+		});
+	}
+
+};
+
+class second_dependent : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE second_dependent() : _dependency{nullptr}, _dependency_initialized_in_init{false} {}
+
+	bool dependency_initialized_in_init() const { return _dependency_initialized_in_init; }
+
+private:
+	second_dependency *_dependency;
+	bool _dependency_initialized_in_init;
+
+private slots:
+	INJEQT_SET void set_dependency(second_dependency *dependency)
+	{
+		_dependency = dependency;
+	}
+
+	INJEQT_INIT void init()
+	{
+		_dependency_initialized_in_init = _dependency && _dependency->initialized();
+	}
+
+};
+
+class null_object : public QObject
+{
+	Q_OBJECT
+
+};
+
+class null_object_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE null_object_factory() {}
+
+	Q_INVOKABLE QFuture<null_object *> create()
+	{
+		return _threads.run<null_object *>([]() -> null_object * { return nullptr; });
+	}
+
+private:
+	thread_list _threads;
+
+};
+
+class async_module : public injeqt::module
+{
+
+public:
+	explicit async_module()
+	{
+		add_type<slow_object>();
+		add_type<slow_created_object_factory>();
+		add_factory<slow_created_object, slow_created_object_factory>();
+		add_type<service_object>();
+		add_type<first_dependent>();
+		add_type<first_dependency>();
+		add_type<second_dependency>();
+		add_type<second_dependent>();
+		add_type<null_object_factory>();
+		add_factory<null_object, null_object_factory>();
+	}
+
+};
+
+class async_factory_init_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_get_object_from_async_factory();
+	void should_wait_for_async_init();
+	void should_init_dependencies_before_dependent_objects();
+	void should_init_dependencies_before_dependent_objects_regardless_of_type_order();
+	void should_throw_when_async_factory_returns_null();
+
+private:
+	injeqt::injector make_injector();
+
+};
+
+injeqt::injector async_factory_init_test::make_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new async_module{}});
+
+	return injeqt::injector{std::move(modules)};
+}
+
+void async_factory_init_test::should_get_object_from_async_factory()
+{
+	auto injector = make_injector();
+	auto object = injector.get<slow_created_object>();
+
+	QVERIFY(object != nullptr);
+	QCOMPARE(object->thread(), QThread::currentThread());
+	QCOMPARE(injector.get<slow_created_object>(), object);
+}
+
+void async_factory_init_test::should_wait_for_async_init()
+{
+	auto injector = make_injector();
+	auto object = injector.get<slow_object>();
+
+	QVERIFY(object->initialized());
+}
+
+void async_factory_init_test::should_init_dependencies_before_dependent_objects()
+{
+	auto injector = make_injector();
+	auto object = injector.get<service_object>();
+
+	QVERIFY(object->dependency() != nullptr);
+	QVERIFY(object->dependency_initialized_in_init());
+}
+
+void async_factory_init_test::should_init_dependencies_before_dependent_objects_regardless_of_type_order()
+{
+	auto injector = make_injector();
+
+	QVERIFY(injector.get<first_dependent>()->dependency_initialized_in_init());
+	QVERIFY(injector.get<second_dependent>()->dependency_initialized_in_init());
+}
+
+void async_factory_init_test::should_throw_when_async_factory_returns_null()
+{
+	auto injector = make_injector();
+
+	expect<injeqt::exception::instantiation_failed>({"null_object"}, [&]{
+		injector.get<null_object>();
+	});
+}
+
+QTEST_GUILESS_MAIN(async_factory_init_test)
+#include "async-factory-init-test.moc"
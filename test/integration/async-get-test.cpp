@@ -0,0 +1,185 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <memory>
+
+class dependency_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE dependency_object() {}
+
+};
+
+class service_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_object() :
+			_constructed_in{QThread::currentThread()},
+			_init_in{nullptr}
+	{
+	}
+
+	QThread * constructed_in() const { return _constructed_in; }
+	QThread * init_in() const { return _init_in; }
+	dependency_object * dependency() const { return _dependency; }
+
+private:
+	QThread *_constructed_in;
+	QThread *_init_in;
+	QPointer<dependency_object> _dependency;
+
+private slots:
+	INJEQT_SET void set_dependency(dependency_object *dependency)
+	{
+		_dependency = dependency;
+	}
+
+	INJEQT_INIT void init()
+	{
+		_init_in = QThread::currentThread();
+	}
+
+};
+
+class unknown_object : public QObject
+{
+	Q_OBJECT
+
+};
+
+class async_module : public injeqt::module
+{
+
+public:
+	explicit async_module()
+	{
+		add_type<dependency_object>();
+		add_type<service_object>();
+	}
+
+};
+
+class async_get_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_get_object_created_in_other_thread();
+	void should_move_objects_to_current_thread();
+	void should_move_objects_to_chosen_thread();
+	void should_return_same_object_as_get();
+	void should_instantiate_object_in_other_thread();
+	void should_report_exception_in_future();
+
+private:
+	injeqt::injector make_injector();
+
+};
+
+injeqt::injector async_get_test::make_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new async_module{}});
+
+	return injeqt::injector{std::move(modules)};
+}
+
+void async_get_test::should_get_object_created_in_other_thread()
+{
+	auto injector = make_injector();
+	auto future = injector.get_async<service_object>();
+	auto object = future.result();
+
+	QVERIFY(future.isFinished());
+	QVERIFY(object != nullptr);
+	QVERIFY(object->dependency() != nullptr);
+	QVERIFY(object->constructed_in() != QThread::currentThread());
+	QCOMPARE(object->init_in(), object->constructed_in());
+}
+
+void async_get_test::should_move_objects_to_current_thread()
+{
+	auto injector = make_injector();
+	auto object = injector.get_async<service_object>().result();
+
+	QCOMPARE(object->thread(), QThread::currentThread());
+	QCOMPARE(object->dependency()->thread(), QThread::currentThread());
+}
+
+void async_get_test::should_move_objects_to_chosen_thread()
+{
+	QThread thread;
+	thread.start();
+
+	{
+		auto injector = make_injector();
+		auto object = injector.get_async<service_object>(&thread).result();
+
+		QCOMPARE(object->thread(), &thread);
+		QCOMPARE(object->dependency()->thread(), &thread);
+	}
+
+	thread.quit();
+	thread.wait();
+}
+
+void async_get_test::should_return_same_object_as_get()
+{
+	auto injector = make_injector();
+	auto object = injector.get_async<service_object>().result();
+
+	QCOMPARE(injector.get<service_object>(), object);
+	QCOMPARE(injector.get_async<service_object>().result(), object);
+	QCOMPARE(injector.get_async(injeqt::make_type<service_object>()).result(), static_cast<QObject *>(object));
+}
+
+void async_get_test::should_instantiate_object_in_other_thread()
+{
+	auto injector = make_injector();
+	injector.instantiate_async<service_object>().waitForFinished();
+
+	auto object = injector.get<service_object>();
+	QVERIFY(object->constructed_in() != QThread::currentThread());
+	QCOMPARE(object->thread(), QThread::currentThread());
+}
+
+void async_get_test::should_report_exception_in_future()
+{
+	auto injector = make_injector();
+	auto future = injector.get_async<unknown_object>();
+
+	expect<injeqt::exception::unknown_type>({"unknown_object"}, [&]{
+		future.result();
+	});
+}
+
+QTEST_GUILESS_MAIN(async_get_test)
+#include "async-get-test.moc"
@@ -0,0 +1,272 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+class counted_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	static std::atomic<int> constructed;
+
+	counted_object() { constructed++; }
+	virtual ~counted_object() {}
+
+	bool initialized() const { return _initialized; }
+
+protected:
+	bool _initialized = false;
+
+};
+
+std::atomic<int> counted_object::constructed{0};
+
+class leaf_a : public counted_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE leaf_a() {}
+
+private slots:
+	INJEQT_INIT void init() { _initialized = true; }
+
+};
+
+class leaf_b : public counted_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE leaf_b() {}
+
+private slots:
+	INJEQT_INIT void init() { _initialized = true; }
+
+};
+
+class shared_leaf : public counted_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE shared_leaf() {}
+
+private slots:
+	INJEQT_INIT void init() { _initialized = true; }
+
+};
+
+class service_a : public counted_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_a() {}
+
+private slots:
+	INJEQT_SET void set_leaf_a(leaf_a *l) { _leaf_a = l; }
+	INJEQT_SET void set_shared_leaf(shared_leaf *l) { _shared_leaf = l; }
+	INJEQT_INIT void init() { _initialized = _leaf_a && _shared_leaf; }
+
+private:
+	leaf_a *_leaf_a = nullptr;
+	shared_leaf *_shared_leaf = nullptr;
+
+};
+
+class service_b : public counted_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_b() {}
+
+private slots:
+	INJEQT_SET void set_leaf_b(leaf_b *l) { _leaf_b = l; }
+	INJEQT_SET void set_shared_leaf(shared_leaf *l) { _shared_leaf = l; }
+	INJEQT_INIT void init() { _initialized = _leaf_b && _shared_leaf; }
+
+private:
+	leaf_b *_leaf_b = nullptr;
+	shared_leaf *_shared_leaf = nullptr;
+
+};
+
+class top : public counted_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE top() {}
+
+private slots:
+	INJEQT_SET void set_service_a(service_a *s) { _service_a = s; }
+	INJEQT_SET void set_service_b(service_b *s) { _service_b = s; }
+	INJEQT_INIT void init() { _initialized = _service_a && _service_b; }
+
+private:
+	service_a *_service_a = nullptr;
+	service_b *_service_b = nullptr;
+
+};
+
+class slow_init_object : public counted_object
+{
+	Q_OBJECT
+
+public:
+	static QSemaphore init_started;
+	static QSemaphore init_allowed;
+
+	Q_INVOKABLE slow_init_object() {}
+
+private slots:
+	INJEQT_INIT void init()
+	{
+		init_started.release();
+		init_allowed.acquire();
+		_initialized = true;
+	}
+
+};
+
+QSemaphore slow_init_object::init_started;
+QSemaphore slow_init_object::init_allowed;
+
+class concurrent_get_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_create_each_object_once_when_used_from_many_threads();
+	void should_return_object_to_other_threads_after_init();
+
+};
+
+void concurrent_get_test::should_create_each_object_once_when_used_from_many_threads()
+{
+	class m : public injeqt::module
+	{
+	public:
+		m()
+		{
+			add_type<leaf_a>();
+			add_type<leaf_b>();
+			add_type<shared_leaf>();
+			add_type<service_a>();
+			add_type<service_b>();
+			add_type<top>();
+		}
+		virtual ~m() {}
+	};
+
+	const auto thread_count = 8;
+	const auto repetitions = 50;
+
+	for (auto r = 0; r < repetitions; r++)
+	{
+		counted_object::constructed = 0;
+
+		auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+		modules.emplace_back(std::unique_ptr<m>{new m{}});
+		auto injector = injeqt::injector{std::move(modules)};
+
+		// each thread starts from other part of graph
+		auto results = std::vector<std::vector<counted_object *>>(thread_count);
+		auto threads = std::vector<std::thread>{};
+		for (auto t = 0; t < thread_count; t++)
+			threads.emplace_back([&injector, &results, t](){
+				auto get_all = std::vector<std::function<counted_object *()>>{
+					[&injector](){ return injector.get<leaf_a>(); },
+					[&injector](){ return injector.get<leaf_b>(); },
+					[&injector](){ return injector.get<shared_leaf>(); },
+					[&injector](){ return injector.get<service_a>(); },
+					[&injector](){ return injector.get<service_b>(); },
+					[&injector](){ return injector.get<top>(); }
+				};
+				auto &&result = results[t];
+				result.resize(get_all.size());
+				for (auto i = 0u; i < get_all.size(); i++)
+				{
+					auto index = (i + t) % get_all.size();
+					result[index] = get_all[index]();
+				}
+			});
+
+		for (auto &&thread : threads)
+			thread.join();
+
+		QCOMPARE(counted_object::constructed.load(), 6);
+		for (auto &&result : results)
+		{
+			QCOMPARE(result, results.front());
+			for (auto &&object : result)
+			{
+				QVERIFY(object != nullptr);
+				QVERIFY(object->initialized());
+			}
+		}
+	}
+}
+
+void concurrent_get_test::should_return_object_to_other_threads_after_init()
+{
+	class m : public injeqt::module
+	{
+	public:
+		m()
+		{
+			add_type<slow_init_object>();
+		}
+		virtual ~m() {}
+	};
+
+	counted_object::constructed = 0;
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{}});
+	auto injector = injeqt::injector{std::move(modules)};
+
+	auto creating_thread = std::thread{[&injector](){ injector.get<slow_init_object>(); }};
+	QVERIFY(slow_init_object::init_started.tryAcquire(1, 5000));
+
+	// other thread asks for object after it was created, but before its INJEQT_INIT method finished
+	auto seen_initialized = false;
+	auto other_thread = std::thread{[&injector, &seen_initialized](){ seen_initialized = injector.get<slow_init_object>()->initialized(); }};
+	QThread::msleep(20);
+
+	slow_init_object::init_allowed.release();
+	creating_thread.join();
+	other_thread.join();
+
+	QVERIFY(seen_initialized);
+	QCOMPARE(counted_object::constructed.load(), 1);
+}
+
+QTEST_APPLESS_MAIN(concurrent_get_test)
+#include "concurrent-get-test.moc"
@@ -0,0 +1,222 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtCore/QThread>
+#include <QtTest/QtTest>
+#include <memory>
+#include <string>
+#include <vector>
+
+class unknown_object : public QObject
+{
+	Q_OBJECT
+};
+
+class leaf_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE leaf_object() { QThread::msleep(20); }
+
+};
+
+class slow_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE slow_object() {}
+
+private slots:
+	INJEQT_INIT void init() { QThread::msleep(30); }
+	INJEQT_SET void set_leaf(leaf_object *) {}
+
+};
+
+class fast_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE fast_object() { QThread::msleep(10); }
+
+};
+
+class root_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE root_object() {}
+
+private slots:
+	INJEQT_SET void set_fast(fast_object *) {}
+	INJEQT_SET void set_slow(slow_object *) {}
+
+};
+
+class cycle_object_1;
+
+class cycle_object_2 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE cycle_object_2() {}
+
+private slots:
+	INJEQT_SET void set_cycle_object_1(cycle_object_1 *) {}
+
+};
+
+class cycle_object_1 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE cycle_object_1() {}
+
+private slots:
+	INJEQT_SET void set_cycle_object_2(cycle_object_2 *) {}
+
+};
+
+class critical_path_module : public injeqt::module
+{
+
+public:
+	explicit critical_path_module()
+	{
+		add_type<leaf_object>();
+		add_type<slow_object>();
+		add_type<fast_object>();
+		add_type<root_object>();
+		add_type<cycle_object_1>();
+		add_type<cycle_object_2>();
+	}
+
+};
+
+class critical_path_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_find_longest_chain_of_created_objects();
+	void should_find_zero_path_of_not_created_objects();
+	void should_find_paths_of_root_types_only();
+	void should_report_paths_as_text();
+	void should_skip_cycles();
+	void should_throw_when_finding_path_of_unknown_type();
+
+private:
+	injeqt::injector make_injector();
+
+};
+
+injeqt::injector critical_path_test::make_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new critical_path_module{}});
+	return injeqt::injector{std::move(modules)};
+}
+
+void critical_path_test::should_find_longest_chain_of_created_objects()
+{
+	auto injector = make_injector();
+	injector.get<root_object>();
+
+	auto path = injector.find_critical_path<root_object>();
+	QCOMPARE(path.types, (std::vector<std::string>{"root_object", "slow_object", "leaf_object"}));
+	QCOMPARE(path.times.size(), size_t{3});
+	QVERIFY(path.times[1] >= 30000);
+	QVERIFY(path.times[2] >= 20000);
+	QCOMPARE(path.path_time, path.times[0] + path.times[1] + path.times[2]);
+	QVERIFY(path.total_time >= path.path_time + 10000);
+	QCOMPARE(path.parallel_saving, path.total_time - path.path_time);
+}
+
+void critical_path_test::should_find_zero_path_of_not_created_objects()
+{
+	auto injector = make_injector();
+
+	auto path = injector.find_critical_path<slow_object>();
+	QCOMPARE(path.types, (std::vector<std::string>{"slow_object", "leaf_object"}));
+	QCOMPARE(path.times, (std::vector<std::int64_t>{0, 0}));
+	QCOMPARE(path.path_time, std::int64_t{0});
+	QCOMPARE(path.total_time, std::int64_t{0});
+	QCOMPARE(path.parallel_saving, std::int64_t{0});
+}
+
+void critical_path_test::should_find_paths_of_root_types_only()
+{
+	auto injector = make_injector();
+	QVERIFY(injector.find_critical_paths().empty());
+
+	injector.get<fast_object>();
+	injector.get<root_object>();
+	injector.get<leaf_object>();
+
+	auto paths = injector.find_critical_paths();
+	QCOMPARE(paths.size(), size_t{1});
+	QCOMPARE(paths[0].types.front(), std::string{"root_object"});
+}
+
+void critical_path_test::should_report_paths_as_text()
+{
+	auto injector = make_injector();
+	QCOMPARE(injector.critical_path_report(), std::string{});
+
+	injector.get<root_object>();
+
+	auto report = injector.critical_path_report();
+	QVERIFY(report.find("root_object: ") == 0);
+	QVERIFY(report.find("  most expensive on path: slow_object (") != std::string::npos);
+	QVERIFY(report.find("    leaf_object ") != std::string::npos);
+	QVERIFY(report.find("    fast_object ") == std::string::npos);
+}
+
+void critical_path_test::should_skip_cycles()
+{
+	auto injector = make_injector();
+	injector.get<cycle_object_1>();
+
+	auto path = injector.find_critical_path<cycle_object_1>();
+	QCOMPARE(path.types, (std::vector<std::string>{"cycle_object_1", "cycle_object_2"}));
+}
+
+void critical_path_test::should_throw_when_finding_path_of_unknown_type()
+{
+	auto injector = make_injector();
+
+	expect<injeqt::exception::unknown_type>({"unknown_object"}, [&]{
+		injector.find_critical_path<unknown_object>();
+	});
+}
+
+QTEST_APPLESS_MAIN(critical_path_test)
+#include "critical-path-test.moc"
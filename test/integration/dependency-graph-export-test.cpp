@@ -0,0 +1,187 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class shared_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE shared_object() {}
+
+};
+
+class dependency_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE dependency_object() {}
+
+};
+
+class service_base : public QObject
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE("service")
+
+};
+
+class service : public service_base
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service() {}
+
+private slots:
+	INJEQT_INIT void init() {}
+	INJEQT_SET void set_dependency(dependency_object *) {}
+	INJEQT_SET void set_shared(shared_object *) {}
+
+};
+
+class product : public QObject
+{
+	Q_OBJECT
+};
+
+class product_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE product_factory() {}
+
+	Q_INVOKABLE product * create_product() { return new product{}; }
+
+};
+
+class parent_module : public injeqt::module
+{
+
+public:
+	explicit parent_module()
+	{
+		add_type<shared_object>();
+	}
+
+};
+
+class graph_module : public injeqt::module
+{
+
+public:
+	explicit graph_module()
+	{
+		add_type<dependency_object>();
+		add_type<service>();
+		add_type<product_factory>();
+		add_factory<product, product_factory>();
+	}
+
+};
+
+class dependency_graph_export_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_save_dot();
+	void should_save_json();
+	void should_not_save_to_invalid_file();
+
+private:
+	const std::string file_name = "dependency-graph-export-test.txt";
+
+	std::string read_and_remove_file();
+
+};
+
+std::string dependency_graph_export_test::read_and_remove_file()
+{
+	std::ifstream file{file_name};
+	std::stringstream content;
+	content << file.rdbuf();
+	file.close();
+	std::remove(file_name.c_str());
+	return content.str();
+}
+
+void dependency_graph_export_test::should_save_dot()
+{
+	auto parent_modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	parent_modules.emplace_back(std::unique_ptr<injeqt::module>{new parent_module{}});
+	auto parent = injeqt::injector{std::move(parent_modules)};
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new graph_module{}});
+	auto injector = injeqt::injector{std::vector<injeqt::injector *>{&parent}, std::move(modules)};
+	injector.get<service>();
+
+	QVERIFY(injector.save_dependency_graph_dot(file_name));
+	auto dot = read_and_remove_file();
+
+	QVERIFY(dot.find("digraph injeqt {") == 0);
+	QVERIFY(dot.find("\t\"service\" [label=\"service\\ndefault_constructor\\ninterfaces: service_base\\nroles: service\\nconstruction: ") != std::string::npos);
+	QVERIFY(dot.find("\t\"product\" [label=\"product\\nfactory\\n\"];") != std::string::npos);
+	QVERIFY(dot.find("\t\"service\" -> \"dependency_object\" [style=solid, label=\"set_dependency(dependency_object*)\"];") != std::string::npos);
+	QVERIFY(dot.find("\t\"service\" -> \"shared_object\" [style=solid, label=\"set_shared(shared_object*)\"];") != std::string::npos);
+	QVERIFY(dot.find("\t\"product\" -> \"product_factory\" [style=dashed];") != std::string::npos);
+	QVERIFY(dot.find("\t\"shared_object\" -> \"parent injector 1\" [style=dotted];") != std::string::npos);
+	QVERIFY(dot.find("\t\"parent injector 1\" [label=\"parent injector 1\\ninjector\\n\"];") != std::string::npos);
+}
+
+void dependency_graph_export_test::should_save_json()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new graph_module{}});
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new parent_module{}});
+	auto injector = injeqt::injector{std::move(modules)};
+	injector.get<dependency_object>();
+
+	QVERIFY(injector.save_dependency_graph_json(file_name));
+	auto json = read_and_remove_file();
+
+	QVERIFY(json.find("{\"name\":\"dependency_object\",\"kind\":\"default_constructor\",\"interfaces\":[],\"type_roles\":[],\"instantiated\":true,\"construction_time\":") != std::string::npos);
+	QVERIFY(json.find("{\"name\":\"service\",\"kind\":\"default_constructor\",\"interfaces\":[\"service_base\"],\"type_roles\":[\"service\"],\"instantiated\":false,\"construction_time\":null,\"init_time\":null}") != std::string::npos);
+	QVERIFY(json.find("{\"from\":\"product\",\"to\":\"product_factory\",\"kind\":\"factory\",\"label\":\"\"}") != std::string::npos);
+	QVERIFY(json.find("parent injector") == std::string::npos);
+}
+
+void dependency_graph_export_test::should_not_save_to_invalid_file()
+{
+	auto injector = injeqt::injector{};
+
+	QVERIFY(!injector.save_dependency_graph_dot("missing-directory/graph.dot"));
+	QVERIFY(!injector.save_dependency_graph_json("missing-directory/graph.json"));
+}
+
+QTEST_APPLESS_MAIN(dependency_graph_export_test)
+#include "dependency-graph-export-test.moc"
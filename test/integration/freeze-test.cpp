@@ -0,0 +1,256 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+
+#include <injeqt/exception/injector-frozen.h>
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+#include <injeqt/type.h>
+
+#include <QtTest/QtTest>
+#include <thread>
+
+#define ROLE "role"
+
+class unconfigured_type : public QObject
+{
+	Q_OBJECT
+};
+
+class dependency_type : public QObject
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE(ROLE)
+
+public:
+	Q_INVOKABLE dependency_type() {}
+
+};
+
+class root_type : public QObject
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE(ROLE)
+
+public:
+	Q_INVOKABLE root_type() {}
+
+	dependency_type *dependency = nullptr;
+
+private slots:
+	INJEQT_SET void set_dependency(dependency_type *d) { dependency = d; }
+
+};
+
+class other_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE other_type() {}
+
+};
+
+class slow_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	static bool blocking;
+	static QSemaphore init_started;
+	static QSemaphore init_allowed;
+
+	Q_INVOKABLE slow_type() {}
+
+private slots:
+	INJEQT_INIT void init()
+	{
+		if (!blocking)
+			return;
+		init_started.release();
+		init_allowed.acquire();
+	}
+
+};
+
+bool slow_type::blocking = false;
+QSemaphore slow_type::init_started;
+QSemaphore slow_type::init_allowed;
+
+class client_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	dependency_type *dependency = nullptr;
+
+private slots:
+	INJEQT_SET void set_dependency(dependency_type *d) { dependency = d; }
+
+};
+
+class other_client_type : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	INJEQT_SET void set_other(other_type *) {}
+
+};
+
+class freeze_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_instantiate_all_types_on_freeze();
+	void should_return_objects_after_freeze();
+	void should_return_objects_with_type_role_after_freeze();
+	void should_inject_into_after_freeze();
+	void should_instantiate_only_root_types_on_partial_freeze();
+	void should_throw_unknown_type_after_freeze();
+	void should_wait_for_objects_being_instantiated();
+
+private:
+	injeqt::injector make_injector();
+
+};
+
+injeqt::injector freeze_test::make_injector()
+{
+	class m : public injeqt::module
+	{
+	public:
+		m()
+		{
+			add_type<dependency_type>();
+			add_type<root_type>();
+			add_type<other_type>();
+			add_type<slow_type>();
+		}
+		virtual ~m() {}
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{}});
+	return injeqt::injector{std::move(modules)};
+}
+
+void freeze_test::should_instantiate_all_types_on_freeze()
+{
+	auto injector = make_injector();
+	QVERIFY(!injector.is_frozen());
+
+	injector.freeze();
+	QVERIFY(injector.is_frozen());
+	QVERIFY(injector.get<dependency_type>() != nullptr);
+	QVERIFY(injector.get<root_type>() != nullptr);
+	QVERIFY(injector.get<other_type>() != nullptr);
+}
+
+void freeze_test::should_return_objects_after_freeze()
+{
+	auto injector = make_injector();
+	auto root = injector.get<root_type>();
+
+	injector.freeze();
+	QCOMPARE(injector.get<root_type>(), root);
+	QCOMPARE(injector.get<root_type>()->dependency, injector.get<dependency_type>());
+}
+
+void freeze_test::should_return_objects_with_type_role_after_freeze()
+{
+	auto injector = make_injector();
+	auto before = injector.get_all_with_type_role(ROLE);
+
+	injector.freeze();
+	QCOMPARE(injector.get_all_with_type_role(ROLE), before);
+	QCOMPARE(injector.get_all_with_type_role(ROLE).size(), size_t{2});
+	QVERIFY(injector.get_all_with_type_role("unknown role").empty());
+}
+
+void freeze_test::should_inject_into_after_freeze()
+{
+	auto injector = make_injector();
+	injector.freeze();
+
+	client_type client{};
+	injector.inject_into(&client);
+	QCOMPARE(client.dependency, injector.get<dependency_type>());
+}
+
+void freeze_test::should_instantiate_only_root_types_on_partial_freeze()
+{
+	auto injector = make_injector();
+	injector.freeze(std::vector<injeqt::type>{injeqt::make_type<root_type>()});
+
+	QVERIFY(injector.is_frozen());
+	QVERIFY(injector.get<root_type>() != nullptr);
+	QCOMPARE(injector.get<root_type>()->dependency, injector.get<dependency_type>());
+
+	expect<injeqt::exception::injector_frozen>({"other_type"}, [&]{
+		injector.get<other_type>();
+	});
+	expect<injeqt::exception::injector_frozen>({"other_type"}, [&]{
+		injector.instantiate<other_type>();
+	});
+
+	other_client_type client{};
+	expect<injeqt::exception::injector_frozen>({"other_type"}, [&]{
+		injector.inject_into(&client);
+	});
+}
+
+void freeze_test::should_throw_unknown_type_after_freeze()
+{
+	auto injector = make_injector();
+	injector.freeze();
+
+	expect<injeqt::exception::unknown_type>({"unconfigured_type"}, [&]{
+		injector.get<unconfigured_type>();
+	});
+}
+
+void freeze_test::should_wait_for_objects_being_instantiated()
+{
+	auto injector = make_injector();
+	slow_type::blocking = true;
+
+	auto slow = static_cast<slow_type *>(nullptr);
+	auto getter = std::thread{[&](){ slow = injector.get<slow_type>(); }};
+	QVERIFY(slow_type::init_started.tryAcquire(1, 5000));
+
+	auto freezer = std::thread{[&](){ injector.freeze(std::vector<injeqt::type>{injeqt::make_type<root_type>()}); }};
+	QThread::msleep(20);
+	QVERIFY(!injector.is_frozen());
+
+	slow_type::init_allowed.release();
+	getter.join();
+	freezer.join();
+	slow_type::blocking = false;
+
+	QVERIFY(injector.is_frozen());
+	QCOMPARE(injector.get<slow_type>(), slow);
+}
+
+QTEST_APPLESS_MAIN(freeze_test)
+#include "freeze-test.moc"
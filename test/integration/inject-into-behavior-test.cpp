@@ -79,6 +79,7 @@ class inject_into_behavior_test : public QObject
 
 private slots:
 	void should_properly_inject_into();
+	void should_properly_inject_into_many_objects();
 
 };
 
@@ -107,5 +108,34 @@ void inject_into_behavior_test::should_properly_inject_into()
 	QCOMPARE(9, sub_service.value());
 }
 
+void inject_into_behavior_test::should_properly_inject_into_many_objects()
+{
+	class m : public injeqt::module
+	{
+	public:
+		m()
+		{
+			add_type<nine_container>();
+		}
+		virtual ~m() {}
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{}});
+	auto injector = injeqt::injector{std::move(modules)};
+
+	int_service service_1{};
+	int_service service_2{};
+	int_sub_service sub_service{};
+	injector.inject_into(std::vector<QObject *>{&service_1, &service_2, &sub_service});
+	QCOMPARE(9, service_1.value());
+	QCOMPARE(9, service_2.value());
+	QCOMPARE(9, sub_service.value());
+
+	int_service service_3{};
+	injector.inject_into(&service_3);
+	QCOMPARE(9, service_3.value());
+}
+
 QTEST_APPLESS_MAIN(inject_into_behavior_test)
 #include "inject-into-behavior-test.moc"
@@ -0,0 +1,226 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <memory>
+
+class constructed_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit constructed_object() :
+			_constructed_in{QThread::currentThread()}
+	{
+	}
+
+	QThread * constructed_in() const { return _constructed_in; }
+
+private:
+	QThread *_constructed_in;
+
+};
+
+class dependency_object : public constructed_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE dependency_object() {}
+
+};
+
+class service_object : public constructed_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_object() :
+			_init_in{nullptr},
+			_dependency_set_before_init{false}
+	{
+	}
+
+	QThread * init_in() const { return _init_in; }
+	dependency_object * dependency() const { return _dependency; }
+	bool dependency_set_before_init() const { return _dependency_set_before_init; }
+
+private:
+	QThread *_init_in;
+	QPointer<dependency_object> _dependency;
+	bool _dependency_set_before_init;
+
+private slots:
+	INJEQT_SET void set_dependency(dependency_object *dependency)
+	{
+		_dependency = dependency;
+	}
+
+	INJEQT_INIT void init()
+	{
+		_init_in = QThread::currentThread();
+		_dependency_set_before_init = _dependency != nullptr;
+	}
+
+};
+
+class product_object : public constructed_object
+{
+	Q_OBJECT
+
+};
+
+class product_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE product_factory() {}
+
+	Q_INVOKABLE product_object * create() { return new product_object{}; }
+
+};
+
+class bound_object : public constructed_object
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE bound_object() {}
+
+};
+
+class instantiate_all_module : public injeqt::module
+{
+
+public:
+	explicit instantiate_all_module(QThread *bound_thread)
+	{
+		add_type<dependency_object>();
+		add_type<service_object>();
+		add_type<product_factory>();
+		add_factory<product_object, product_factory>();
+		if (bound_thread)
+			add_type<bound_object>(bound_thread);
+	}
+
+};
+
+class instantiate_all_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_instantiate_all_types();
+	void should_instantiate_all_types_in_parallel();
+	void should_move_objects_constructed_in_parallel_to_current_thread();
+	void should_construct_bound_objects_in_their_thread_in_parallel();
+	void should_not_create_new_objects_when_called_again();
+
+private:
+	injeqt::injector make_injector(QThread *bound_thread = nullptr);
+	void verify_instantiated(injeqt::injector &injector);
+
+};
+
+injeqt::injector instantiate_all_test::make_injector(QThread *bound_thread)
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new instantiate_all_module{bound_thread}});
+
+	return injeqt::injector{std::move(modules)};
+}
+
+void instantiate_all_test::verify_instantiated(injeqt::injector &injector)
+{
+	auto service = injector.get<service_object>();
+	QVERIFY(service != nullptr);
+	QCOMPARE(service->dependency(), injector.get<dependency_object>());
+	QVERIFY(service->dependency_set_before_init());
+	QCOMPARE(service->init_in(), QThread::currentThread());
+	QVERIFY(injector.get<product_object>() != nullptr);
+}
+
+void instantiate_all_test::should_instantiate_all_types()
+{
+	auto injector = make_injector();
+	injector.instantiate_all();
+
+	verify_instantiated(injector);
+	QCOMPARE(injector.get<service_object>()->constructed_in(), QThread::currentThread());
+}
+
+void instantiate_all_test::should_instantiate_all_types_in_parallel()
+{
+	auto injector = make_injector();
+	injector.instantiate_all_in_parallel();
+
+	verify_instantiated(injector);
+}
+
+void instantiate_all_test::should_move_objects_constructed_in_parallel_to_current_thread()
+{
+	auto injector = make_injector();
+	injector.instantiate_all_in_parallel();
+
+	QCOMPARE(injector.get<dependency_object>()->thread(), QThread::currentThread());
+	QCOMPARE(injector.get<service_object>()->thread(), QThread::currentThread());
+	QCOMPARE(injector.get<product_factory>()->thread(), QThread::currentThread());
+	QCOMPARE(injector.get<product_object>()->thread(), QThread::currentThread());
+	// factory is always called from thread of factory object
+	QCOMPARE(injector.get<product_object>()->constructed_in(), QThread::currentThread());
+}
+
+void instantiate_all_test::should_construct_bound_objects_in_their_thread_in_parallel()
+{
+	QThread thread;
+	thread.start();
+
+	{
+		auto injector = make_injector(&thread);
+		injector.instantiate_all_in_parallel();
+
+		auto object = injector.get<bound_object>();
+		QCOMPARE(object->constructed_in(), &thread);
+		QCOMPARE(object->thread(), &thread);
+		verify_instantiated(injector);
+	}
+
+	thread.quit();
+	thread.wait();
+}
+
+void instantiate_all_test::should_not_create_new_objects_when_called_again()
+{
+	auto injector = make_injector();
+	injector.instantiate_all_in_parallel();
+	auto service = injector.get<service_object>();
+
+	injector.instantiate_all();
+	injector.instantiate_all_in_parallel();
+
+	QCOMPARE(injector.get<service_object>(), service);
+}
+
+QTEST_GUILESS_MAIN(instantiate_all_test)
+#include "instantiate-all-test.moc"
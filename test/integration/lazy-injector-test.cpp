@@ -0,0 +1,323 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+
+#include <injeqt/exception/ambiguous-types.h>
+#include <injeqt/exception/default-constructor-not-found.h>
+#include <injeqt/exception/injector-frozen.h>
+#include <injeqt/exception/not-supported.h>
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+#include <injeqt/type.h>
+
+#include <QtTest/QtTest>
+
+class unconfigured_type : public QObject
+{
+	Q_OBJECT
+};
+
+class shared_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE shared_type() { instances++; }
+
+	static int instances;
+
+};
+
+int shared_type::instances = 0;
+
+class first_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE first_type() {}
+
+	shared_type *shared = nullptr;
+
+private slots:
+	INJEQT_SET void set_shared(shared_type *s) { shared = s; }
+
+};
+
+class second_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE second_type() {}
+
+	shared_type *shared = nullptr;
+	first_type *first = nullptr;
+
+private slots:
+	INJEQT_SET void set_shared(shared_type *s) { shared = s; }
+	INJEQT_SET void set_first(first_type *f) { first = f; }
+
+};
+
+class base_type : public QObject
+{
+	Q_OBJECT
+};
+
+class implementation_type : public base_type
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE implementation_type() {}
+
+};
+
+class sub_implementation_type : public implementation_type
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE sub_implementation_type() {}
+
+};
+
+class invalid_type : public QObject
+{
+	Q_OBJECT
+};
+
+class client_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	base_type *base = nullptr;
+
+private slots:
+	INJEQT_SET void set_base(base_type *b) { base = b; }
+
+};
+
+class lazy_injector_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_not_validate_unused_types();
+	void should_report_error_when_invalid_type_is_needed();
+	void should_report_all_errors_in_validate_all();
+	void should_share_dependencies_between_activations();
+	void should_get_objects_of_earlier_activations_by_interface();
+	void should_get_by_interface();
+	void should_inject_into();
+	void should_throw_unknown_type();
+	void should_instantiate_all();
+	void should_throw_injector_frozen_after_partial_freeze();
+	void should_throw_ambiguous_types_on_activation();
+	void should_not_support_dependency_graph_and_critical_paths();
+
+private:
+	injeqt::injector make_injector(bool with_invalid_type, bool with_sub_implementation);
+
+};
+
+injeqt::injector lazy_injector_test::make_injector(bool with_invalid_type, bool with_sub_implementation)
+{
+	class m : public injeqt::module
+	{
+	public:
+		m(bool with_invalid_type, bool with_sub_implementation)
+		{
+			add_type<shared_type>();
+			add_type<first_type>();
+			add_type<second_type>();
+			add_type<implementation_type>();
+			if (with_invalid_type)
+				add_type<invalid_type>();
+			if (with_sub_implementation)
+				add_type<sub_implementation_type>();
+		}
+		virtual ~m() {}
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{with_invalid_type, with_sub_implementation}});
+
+	auto options = injeqt::injector_options{};
+	options.lazy = true;
+	return injeqt::injector{std::move(modules), options};
+}
+
+void lazy_injector_test::should_not_validate_unused_types()
+{
+	auto injector = make_injector(true, false);
+
+	QVERIFY(injector.get<first_type>() != nullptr);
+	QVERIFY(injector.get<first_type>()->shared != nullptr);
+}
+
+void lazy_injector_test::should_report_error_when_invalid_type_is_needed()
+{
+	auto injector = make_injector(true, false);
+
+	expect<injeqt::exception::default_constructor_not_found>({"invalid_type"}, [&]{
+		injector.get<invalid_type>();
+	});
+	expect<injeqt::exception::default_constructor_not_found>({"invalid_type"}, [&]{
+		injector.get<invalid_type>();
+	});
+	QVERIFY(injector.get<first_type>() != nullptr);
+}
+
+void lazy_injector_test::should_report_all_errors_in_validate_all()
+{
+	auto injector = make_injector(true, false);
+	auto first = injector.get<first_type>();
+
+	expect<injeqt::exception::default_constructor_not_found>({"invalid_type"}, [&]{
+		injector.validate_all();
+	});
+	QCOMPARE(injector.get<first_type>(), first);
+
+	make_injector(false, false).validate_all();
+}
+
+void lazy_injector_test::should_share_dependencies_between_activations()
+{
+	shared_type::instances = 0;
+	auto injector = make_injector(false, false);
+
+	auto first = injector.get<first_type>();
+	auto second = injector.get<second_type>();
+
+	QCOMPARE(shared_type::instances, 1);
+	QCOMPARE(second->shared, first->shared);
+	QCOMPARE(second->first, first);
+	QCOMPARE(injector.get<first_type>(), first);
+	QCOMPARE(injector.get<shared_type>(), first->shared);
+}
+
+void lazy_injector_test::should_get_objects_of_earlier_activations_by_interface()
+{
+	shared_type::instances = 0;
+	auto injector = make_injector(false, false);
+
+	auto implementation = injector.get<implementation_type>();
+	auto first = injector.get<first_type>();
+	auto second = injector.get<second_type>();
+
+	QCOMPARE(injector.get<base_type>(), static_cast<base_type *>(implementation));
+	QCOMPARE(injector.get<shared_type>(), first->shared);
+	QCOMPARE(second->first, first);
+
+	client_type client{};
+	injector.inject_into(&client);
+	QCOMPARE(client.base, static_cast<base_type *>(implementation));
+
+	injector.instantiate_all();
+	QCOMPARE(shared_type::instances, 1);
+}
+
+void lazy_injector_test::should_get_by_interface()
+{
+	auto injector = make_injector(false, false);
+
+	auto base = injector.get<base_type>();
+	QVERIFY(base != nullptr);
+	QCOMPARE(injector.get<implementation_type>(), static_cast<implementation_type *>(base));
+}
+
+void lazy_injector_test::should_inject_into()
+{
+	auto injector = make_injector(false, false);
+
+	client_type client{};
+	injector.inject_into(&client);
+	QCOMPARE(client.base, injector.get<base_type>());
+}
+
+void lazy_injector_test::should_throw_unknown_type()
+{
+	auto injector = make_injector(false, false);
+
+	expect<injeqt::exception::unknown_type>({"unconfigured_type"}, [&]{
+		injector.get<unconfigured_type>();
+	});
+}
+
+void lazy_injector_test::should_instantiate_all()
+{
+	shared_type::instances = 0;
+	auto injector = make_injector(false, false);
+	auto first = injector.get<first_type>();
+
+	injector.instantiate_all();
+	QCOMPARE(shared_type::instances, 1);
+	QCOMPARE(injector.get<second_type>()->first, first);
+	QVERIFY(injector.get<implementation_type>() != nullptr);
+}
+
+void lazy_injector_test::should_throw_injector_frozen_after_partial_freeze()
+{
+	auto injector = make_injector(false, false);
+	injector.freeze(std::vector<injeqt::type>{injeqt::make_type<first_type>()});
+
+	QVERIFY(injector.is_frozen());
+	QVERIFY(injector.get<first_type>() != nullptr);
+	expect<injeqt::exception::injector_frozen>({"second_type"}, [&]{
+		injector.get<second_type>();
+	});
+}
+
+void lazy_injector_test::should_throw_ambiguous_types_on_activation()
+{
+	auto injector = make_injector(false, true);
+
+	QVERIFY(injector.get<implementation_type>() != nullptr);
+	expect<injeqt::exception::ambiguous_types>([&]{
+		injector.get<sub_implementation_type>();
+	});
+	expect<injeqt::exception::ambiguous_types>([&]{
+		injector.validate_all();
+	});
+}
+
+void lazy_injector_test::should_not_support_dependency_graph_and_critical_paths()
+{
+	auto injector = make_injector(false, false);
+	injector.get<first_type>();
+
+	expect<injeqt::exception::not_supported>({"save_dependency_graph_dot"}, [&]{
+		injector.save_dependency_graph_dot("graph.dot");
+	});
+	expect<injeqt::exception::not_supported>({"find_critical_path"}, [&]{
+		injector.find_critical_path<first_type>();
+	});
+	expect<injeqt::exception::not_supported>({"critical_path_report"}, [&]{
+		injector.critical_path_report();
+	});
+}
+
+QTEST_APPLESS_MAIN(lazy_injector_test)
+#include "lazy-injector-test.moc"
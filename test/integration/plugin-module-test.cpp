@@ -0,0 +1,135 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+#include "../plugins/test-plugin-api.h"
+
+#include <injeqt/exception/plugin-load-failed.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+#include <injeqt/plugin-module.h>
+
+#include <QtTest/QtTest>
+
+class host_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE host_type() {}
+
+};
+
+class missing_service : public QObject
+{
+	Q_OBJECT
+};
+
+class plugin_module_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_not_load_plugin_until_type_is_needed();
+	void should_load_plugin_in_constructor_of_not_lazy_injector();
+	void should_throw_when_plugin_could_not_be_loaded();
+	void should_throw_when_plugin_does_not_provide_declared_type();
+
+private:
+	injeqt::injector make_injector(std::string file_name, std::vector<std::string> type_names, bool lazy);
+
+};
+
+injeqt::injector plugin_module_test::make_injector(std::string file_name, std::vector<std::string> type_names, bool lazy)
+{
+	class m : public injeqt::module
+	{
+	public:
+		m()
+		{
+			add_type<host_type>();
+			add_type<test_plugin_dependency>();
+		}
+		virtual ~m() {}
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{}});
+	modules.emplace_back(std::unique_ptr<injeqt::plugin_module>{new injeqt::plugin_module{std::move(file_name), std::move(type_names)}});
+
+	auto options = injeqt::injector_options{};
+	options.lazy = lazy;
+	return injeqt::injector{std::move(modules), options};
+}
+
+void plugin_module_test::should_not_load_plugin_until_type_is_needed()
+{
+	auto created_modules = test_plugin_service::created_modules;
+	auto injector = make_injector(TEST_PLUGIN_FILE_NAME, {"test_plugin_service"}, true);
+
+	QVERIFY(injector.get<host_type>() != nullptr);
+	QCOMPARE(test_plugin_service::created_modules, created_modules);
+
+	auto service = injector.get<test_plugin_service>();
+	QCOMPARE(test_plugin_service::created_modules, created_modules + 1);
+	QCOMPARE(service->name(), std::string{"plugin"});
+	QCOMPARE(service->dependency(), injector.get<test_plugin_dependency>());
+	QCOMPARE(injector.get<test_plugin_service>(), service);
+	QCOMPARE(test_plugin_service::created_modules, created_modules + 1);
+}
+
+void plugin_module_test::should_load_plugin_in_constructor_of_not_lazy_injector()
+{
+	auto created_modules = test_plugin_service::created_modules;
+	auto injector = make_injector(TEST_PLUGIN_FILE_NAME, {"test_plugin_service"}, false);
+	QCOMPARE(test_plugin_service::created_modules, created_modules + 1);
+
+	auto service = injector.get<test_plugin_service>();
+	QCOMPARE(service->name(), std::string{"plugin"});
+	QCOMPARE(service->dependency(), injector.get<test_plugin_dependency>());
+}
+
+void plugin_module_test::should_throw_when_plugin_could_not_be_loaded()
+{
+	auto injector = make_injector("/nonexistent/plugin", {"missing_service"}, true);
+
+	QVERIFY(injector.get<host_type>() != nullptr);
+	expect<injeqt::exception::plugin_load_failed>({"/nonexistent/plugin"}, [&]{
+		injector.get<missing_service>();
+	});
+	expect<injeqt::exception::plugin_load_failed>({"/nonexistent/plugin"}, [&]{
+		injector.validate_all();
+	});
+	expect<injeqt::exception::plugin_load_failed>({"/nonexistent/plugin"}, [&]{
+		make_injector("/nonexistent/plugin", {"missing_service"}, false);
+	});
+}
+
+void plugin_module_test::should_throw_when_plugin_does_not_provide_declared_type()
+{
+	auto injector = make_injector(TEST_PLUGIN_FILE_NAME, {"missing_service"}, true);
+
+	expect<injeqt::exception::plugin_load_failed>({"missing_service"}, [&]{
+		injector.get<missing_service>();
+	});
+}
+
+QTEST_APPLESS_MAIN(plugin_module_test)
+#include "plugin-module-test.moc"
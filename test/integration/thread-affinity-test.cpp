@@ -0,0 +1,359 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+
+#include <injeqt/exception/instantiation-failed.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <memory>
+
+class dependency_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE dependency_object() {}
+
+};
+
+class bound_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	static QThread *constructed_in;
+	static QThread *set_in;
+	static QThread *init_in;
+	static QThread *done_in;
+	static QThread *destroyed_in;
+
+	Q_INVOKABLE bound_object()
+	{
+		constructed_in = QThread::currentThread();
+	}
+
+	virtual ~bound_object()
+	{
+		destroyed_in = QThread::currentThread();
+	}
+
+	dependency_object * dependency() const { return _dependency; }
+
+private:
+	QPointer<dependency_object> _dependency;
+
+private slots:
+	INJEQT_SET void set_dependency(dependency_object *dependency)
+	{
+		set_in = QThread::currentThread();
+		_dependency = dependency;
+	}
+
+	INJEQT_INIT void init()
+	{
+		init_in = QThread::currentThread();
+	}
+
+	INJEQT_DONE void done()
+	{
+		done_in = QThread::currentThread();
+	}
+
+};
+
+QThread *bound_object::constructed_in = nullptr;
+QThread *bound_object::set_in = nullptr;
+QThread *bound_object::init_in = nullptr;
+QThread *bound_object::done_in = nullptr;
+QThread *bound_object::destroyed_in = nullptr;
+
+class moved_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	static QThread *done_in;
+	static QThread *destroyed_in;
+
+	Q_INVOKABLE moved_object() {}
+
+	virtual ~moved_object()
+	{
+		destroyed_in = QThread::currentThread();
+	}
+
+private slots:
+	INJEQT_DONE void done()
+	{
+		done_in = QThread::currentThread();
+	}
+
+};
+
+QThread *moved_object::done_in = nullptr;
+QThread *moved_object::destroyed_in = nullptr;
+
+class slow_bound_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	static QSemaphore init_started;
+	static QSemaphore init_allowed;
+
+	Q_INVOKABLE slow_bound_object() {}
+
+private slots:
+	INJEQT_INIT void init()
+	{
+		init_started.release();
+		init_allowed.acquire();
+	}
+
+};
+
+QSemaphore slow_bound_object::init_started;
+QSemaphore slow_bound_object::init_allowed;
+
+class by_factory_object : public QObject
+{
+	Q_OBJECT
+
+};
+
+class object_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE object_factory() {}
+
+	Q_INVOKABLE by_factory_object * create()
+	{
+		return new by_factory_object{};
+	}
+
+};
+
+class third_thread_object : public QObject
+{
+	Q_OBJECT
+
+};
+
+class third_thread_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	static QThread *third_thread;
+
+	Q_INVOKABLE third_thread_factory() {}
+
+	Q_INVOKABLE third_thread_object * create()
+	{
+		auto result = new third_thread_object{};
+		result->moveToThread(third_thread);
+		return result;
+	}
+
+};
+
+QThread *third_thread_factory::third_thread = nullptr;
+
+class bound_module : public injeqt::module
+{
+
+public:
+	explicit bound_module(QThread *thread)
+	{
+		add_type<dependency_object>();
+		add_type<bound_object>(thread);
+		add_type<slow_bound_object>(thread);
+		add_type<moved_object>();
+		add_type<object_factory>();
+		add_factory<by_factory_object, object_factory>(thread);
+		add_type<third_thread_factory>();
+		add_factory<third_thread_object, third_thread_factory>(thread);
+	}
+
+};
+
+class thread_affinity_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void cleanup();
+	void should_construct_object_in_bound_thread();
+	void should_call_setters_and_init_in_bound_thread();
+	void should_call_done_and_destroy_in_bound_thread();
+	void should_move_object_from_factory_to_bound_thread();
+	void should_not_move_unbound_objects();
+	void should_not_block_caller_of_get_async();
+	void should_call_done_and_destroy_in_thread_of_get_async();
+	void should_not_move_or_destroy_objects_of_parent_injector();
+	void should_not_accept_factory_object_living_in_third_thread();
+
+private:
+	std::unique_ptr<QThread> _thread;
+
+	injeqt::injector make_injector();
+
+};
+
+void thread_affinity_test::init()
+{
+	bound_object::constructed_in = nullptr;
+	bound_object::set_in = nullptr;
+	bound_object::init_in = nullptr;
+	bound_object::done_in = nullptr;
+	bound_object::destroyed_in = nullptr;
+	moved_object::done_in = nullptr;
+	moved_object::destroyed_in = nullptr;
+
+	_thread.reset(new QThread{});
+	_thread->start();
+}
+
+void thread_affinity_test::cleanup()
+{
+	_thread->quit();
+	_thread->wait();
+	_thread.reset();
+}
+
+injeqt::injector thread_affinity_test::make_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new bound_module{_thread.get()}});
+
+	return injeqt::injector{std::move(modules)};
+}
+
+void thread_affinity_test::should_construct_object_in_bound_thread()
+{
+	auto injector = make_injector();
+	auto object = injector.get<bound_object>();
+
+	QCOMPARE(object->thread(), _thread.get());
+	QCOMPARE(bound_object::constructed_in, _thread.get());
+}
+
+void thread_affinity_test::should_call_setters_and_init_in_bound_thread()
+{
+	auto injector = make_injector();
+	auto object = injector.get<bound_object>();
+
+	QCOMPARE(object->dependency(), injector.get<dependency_object>());
+	QCOMPARE(bound_object::set_in, _thread.get());
+	QCOMPARE(bound_object::init_in, _thread.get());
+}
+
+void thread_affinity_test::should_call_done_and_destroy_in_bound_thread()
+{
+	{
+		auto injector = make_injector();
+		injector.get<bound_object>();
+		QVERIFY(bound_object::done_in == nullptr);
+	}
+
+	QCOMPARE(bound_object::done_in, _thread.get());
+	QCOMPARE(bound_object::destroyed_in, _thread.get());
+}
+
+void thread_affinity_test::should_move_object_from_factory_to_bound_thread()
+{
+	auto injector = make_injector();
+
+	QCOMPARE(injector.get<by_factory_object>()->thread(), _thread.get());
+	QCOMPARE(injector.get<object_factory>()->thread(), QThread::currentThread());
+}
+
+void thread_affinity_test::should_not_move_unbound_objects()
+{
+	auto injector = make_injector();
+	injector.get<bound_object>();
+
+	QCOMPARE(injector.get<dependency_object>()->thread(), QThread::currentThread());
+}
+
+void thread_affinity_test::should_not_block_caller_of_get_async()
+{
+	auto injector = make_injector();
+	auto future = injector.get_async<slow_bound_object>();
+
+	// caller got future back while INJEQT_INIT is still running in bound thread
+	QVERIFY(slow_bound_object::init_started.tryAcquire(1, 5000));
+	QVERIFY(!future.isFinished());
+
+	slow_bound_object::init_allowed.release();
+	future.waitForFinished();
+	QCOMPARE(future.result()->thread(), _thread.get());
+}
+
+void thread_affinity_test::should_call_done_and_destroy_in_thread_of_get_async()
+{
+	{
+		auto injector = make_injector();
+		auto object = injector.get_async<moved_object>(_thread.get()).result();
+		QCOMPARE(object->thread(), _thread.get());
+		QVERIFY(moved_object::done_in == nullptr);
+	}
+
+	QCOMPARE(moved_object::done_in, _thread.get());
+	QCOMPARE(moved_object::destroyed_in, _thread.get());
+}
+
+void thread_affinity_test::should_not_move_or_destroy_objects_of_parent_injector()
+{
+	auto parent = make_injector();
+	{
+		auto child = injeqt::injector{std::vector<injeqt::injector *>{&parent}, std::vector<std::unique_ptr<injeqt::module>>{}};
+		auto object = child.get_async<moved_object>(_thread.get()).result();
+		QVERIFY(object->thread() != _thread.get());
+		QCOMPARE(parent.get<moved_object>(), object);
+	}
+
+	QVERIFY(moved_object::done_in == nullptr);
+	QVERIFY(moved_object::destroyed_in == nullptr);
+}
+
+void thread_affinity_test::should_not_accept_factory_object_living_in_third_thread()
+{
+	auto third_thread = std::unique_ptr<QThread>{new QThread{}};
+	third_thread->start();
+	third_thread_factory::third_thread = third_thread.get();
+
+	auto injector = make_injector();
+	expect<injeqt::exception::instantiation_failed>({"third_thread_object"}, [&]{
+		injector.get<third_thread_object>();
+	});
+
+	third_thread->quit();
+	third_thread->wait();
+}
+
+QTEST_GUILESS_MAIN(thread_affinity_test)
+#include "thread-affinity-test.moc"
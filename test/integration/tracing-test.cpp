@@ -0,0 +1,133 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+#include <injeqt/trace.h>
+
+#include <QtTest/QtTest>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class dependency_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE dependency_object() {}
+
+};
+
+class traced_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE traced_object() {}
+
+private slots:
+	INJEQT_INIT void init() {}
+	INJEQT_DONE void done() {}
+	INJEQT_SET void set_dependency(dependency_object *) {}
+
+};
+
+class tracing_module : public injeqt::module
+{
+
+public:
+	explicit tracing_module()
+	{
+		add_type<dependency_object>();
+		add_type<traced_object>();
+	}
+
+};
+
+class tracing_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_save_spans_of_injector_lifecycle();
+	void should_not_save_spans_when_stopped();
+
+private:
+	const std::string file_name = "tracing-test.json";
+
+	std::string save_and_read_trace();
+	std::unique_ptr<injeqt::injector> make_injector();
+
+};
+
+std::string tracing_test::save_and_read_trace()
+{
+	if (!injeqt::save_trace(file_name))
+		return std::string{};
+
+	std::ifstream file{file_name};
+	std::stringstream content;
+	content << file.rdbuf();
+	file.close();
+	std::remove(file_name.c_str());
+	return content.str();
+}
+
+std::unique_ptr<injeqt::injector> tracing_test::make_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new tracing_module{}});
+	return std::unique_ptr<injeqt::injector>{new injeqt::injector{std::move(modules)}};
+}
+
+void tracing_test::should_save_spans_of_injector_lifecycle()
+{
+	injeqt::start_tracing();
+	auto injector = make_injector();
+	injector->get<traced_object>();
+	injector.reset();
+	injeqt::stop_tracing();
+
+	auto trace = save_and_read_trace();
+	for (auto &&name : {
+		"injector_impl::init", "types_by_name", "create_provider", "make_types_model", "index_types",
+		"validate_required_types", "create_plans", "provide traced_object", "provide dependency_object",
+		"INJEQT_SET traced_object::set_dependency(dependency_object*)",
+		"INJEQT_INIT traced_object::init()", "INJEQT_DONE traced_object::done()"})
+		QVERIFY2(trace.find(std::string{"\"name\":\""} + name + "\"") != std::string::npos, name);
+}
+
+void tracing_test::should_not_save_spans_when_stopped()
+{
+	injeqt::start_tracing();
+	injeqt::stop_tracing();
+	make_injector()->get<traced_object>();
+
+	auto trace = save_and_read_trace();
+	QVERIFY(trace.find("\"traceEvents\":[") != std::string::npos);
+	QVERIFY(trace.find("\"name\"") == std::string::npos);
+}
+
+QTEST_APPLESS_MAIN(tracing_test)
+#include "tracing-test.moc"
@@ -0,0 +1,159 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+class shared_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE shared_type() {}
+
+};
+
+class client_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE client_type() {}
+
+	shared_type *shared = nullptr;
+
+private slots:
+	INJEQT_SET void set_shared(shared_type *s) { shared = s; }
+
+};
+
+class validated_model_cache_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void cleanup();
+	void should_write_cache_file();
+	void should_use_cache_file();
+	void should_replace_outdated_cache_file();
+	void should_replace_invalid_cache_file();
+	void should_ignore_cache_in_lazy_injector();
+
+private:
+	const std::string file_name = "validated-model-cache-test.txt";
+
+	injeqt::injector make_injector(bool with_client, bool lazy = false);
+	std::string read_cache_file() const;
+
+};
+
+injeqt::injector validated_model_cache_test::make_injector(bool with_client, bool lazy)
+{
+	class m : public injeqt::module
+	{
+	public:
+		explicit m(bool with_client)
+		{
+			add_type<shared_type>();
+			if (with_client)
+				add_type<client_type>();
+		}
+		virtual ~m() {}
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{with_client}});
+
+	auto options = injeqt::injector_options{};
+	options.lazy = lazy;
+	options.model_cache_file = file_name;
+	return injeqt::injector{std::move(modules), options};
+}
+
+std::string validated_model_cache_test::read_cache_file() const
+{
+	std::ifstream file{file_name};
+	return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+void validated_model_cache_test::cleanup()
+{
+	std::remove(file_name.c_str());
+}
+
+void validated_model_cache_test::should_write_cache_file()
+{
+	make_injector(true);
+
+	auto content = read_cache_file();
+	QVERIFY(content.find("injeqt-model-cache") == 0);
+	QVERIFY(content.find("client_type") != std::string::npos);
+}
+
+void validated_model_cache_test::should_use_cache_file()
+{
+	make_injector(true);
+	auto content = read_cache_file();
+
+	auto injector = make_injector(true);
+	auto client = injector.get<client_type>();
+	QVERIFY(client->shared != nullptr);
+	QCOMPARE(client->shared, injector.get<shared_type>());
+	QCOMPARE(read_cache_file(), content);
+}
+
+void validated_model_cache_test::should_replace_outdated_cache_file()
+{
+	make_injector(false);
+	QVERIFY(read_cache_file().find("client_type") == std::string::npos);
+
+	auto injector = make_injector(true);
+	QVERIFY(injector.get<client_type>()->shared != nullptr);
+	QVERIFY(read_cache_file().find("client_type") != std::string::npos);
+}
+
+void validated_model_cache_test::should_replace_invalid_cache_file()
+{
+	{
+		std::ofstream file{file_name};
+		file << "invalid content\n";
+	}
+
+	auto injector = make_injector(true);
+	QVERIFY(injector.get<client_type>()->shared != nullptr);
+	QVERIFY(read_cache_file().find("injeqt-model-cache") == 0);
+}
+
+void validated_model_cache_test::should_ignore_cache_in_lazy_injector()
+{
+	auto injector = make_injector(true, true);
+	QVERIFY(injector.get<client_type>()->shared != nullptr);
+
+	std::ifstream file{file_name};
+	QVERIFY(!file);
+}
+
+QTEST_APPLESS_MAIN(validated_model_cache_test)
+#include "validated-model-cache-test.moc"
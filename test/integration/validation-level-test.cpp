@@ -0,0 +1,223 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+
+#include <injeqt/exception/ambiguous-types.h>
+#include <injeqt/exception/unresolvable-dependencies.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <cstdio>
+#include <fstream>
+
+class base_type : public QObject
+{
+	Q_OBJECT
+};
+
+class first_implementation : public base_type
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE first_implementation() {}
+
+};
+
+class second_implementation : public base_type
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE second_implementation() {}
+
+};
+
+class sub_implementation : public first_implementation
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE sub_implementation() {}
+
+};
+
+class base_client : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE base_client() {}
+
+	base_type *base = nullptr;
+
+private slots:
+	INJEQT_SET void set_base(base_type *b) { base = b; }
+
+};
+
+class first_client : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE first_client() {}
+
+	first_implementation *first = nullptr;
+
+private slots:
+	INJEQT_SET void set_first(first_implementation *f) { first = f; }
+
+};
+
+class validation_level_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_throw_in_constructor_when_strict();
+	void should_report_unresolvable_dependency_on_first_use_when_deferred();
+	void should_report_ambiguous_type_on_first_use_when_deferred();
+	void should_not_report_errors_when_trusted();
+	void should_create_valid_configuration_when_trusted();
+	void should_use_cache_written_by_strict_injector();
+
+private:
+	enum class configuration
+	{
+		valid,
+		unresolvable,
+		ambiguous
+	};
+
+	injeqt::injector make_injector(configuration c, injeqt::validation_level validation, const std::string &model_cache_file = std::string{});
+
+};
+
+injeqt::injector validation_level_test::make_injector(configuration c, injeqt::validation_level validation, const std::string &model_cache_file)
+{
+	class m : public injeqt::module
+	{
+	public:
+		explicit m(configuration c)
+		{
+			add_type<first_implementation>();
+			add_type<first_client>();
+			if (c == configuration::unresolvable)
+			{
+				add_type<second_implementation>();
+				add_type<base_client>();
+			}
+			if (c == configuration::ambiguous)
+				add_type<sub_implementation>();
+		}
+		virtual ~m() {}
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{c}});
+
+	auto options = injeqt::injector_options{};
+	options.validation = validation;
+	options.model_cache_file = model_cache_file;
+	return injeqt::injector{std::move(modules), options};
+}
+
+void validation_level_test::should_throw_in_constructor_when_strict()
+{
+	expect<injeqt::exception::unresolvable_dependencies>({"base_type"}, [&]{
+		make_injector(configuration::unresolvable, injeqt::validation_level::strict);
+	});
+	expect<injeqt::exception::ambiguous_types>({"first_implementation"}, [&]{
+		make_injector(configuration::ambiguous, injeqt::validation_level::strict);
+	});
+}
+
+void validation_level_test::should_report_unresolvable_dependency_on_first_use_when_deferred()
+{
+	auto injector = make_injector(configuration::unresolvable, injeqt::validation_level::deferred);
+
+	QVERIFY(injector.get<second_implementation>() != nullptr);
+	QVERIFY(injector.get<first_client>()->first != nullptr);
+	expect<injeqt::exception::unresolvable_dependencies>({"base_type"}, [&]{
+		injector.get<base_client>();
+	});
+	expect<injeqt::exception::unresolvable_dependencies>({"base_type"}, [&]{
+		injector.get<base_client>();
+	});
+	expect<injeqt::exception::unresolvable_dependencies>({"base_type"}, [&]{
+		injector.validate_all();
+	});
+}
+
+void validation_level_test::should_report_ambiguous_type_on_first_use_when_deferred()
+{
+	auto injector = make_injector(configuration::ambiguous, injeqt::validation_level::deferred);
+
+	QVERIFY(injector.get<sub_implementation>() != nullptr);
+	expect<injeqt::exception::ambiguous_types>({"first_implementation"}, [&]{
+		injector.get<first_implementation>();
+	});
+	expect<injeqt::exception::ambiguous_types>({"first_implementation"}, [&]{
+		injector.validate_all();
+	});
+}
+
+void validation_level_test::should_not_report_errors_when_trusted()
+{
+	auto injector = make_injector(configuration::unresolvable, injeqt::validation_level::trusted);
+
+	QVERIFY(injector.get<second_implementation>() != nullptr);
+	expect<injeqt::exception::unresolvable_dependencies>({"base_type"}, [&]{
+		injector.validate_all();
+	});
+}
+
+void validation_level_test::should_create_valid_configuration_when_trusted()
+{
+	auto injector = make_injector(configuration::valid, injeqt::validation_level::trusted);
+
+	auto client = injector.get<first_client>();
+	QVERIFY(client->first != nullptr);
+	QCOMPARE(client->first, injector.get<first_implementation>());
+	injector.validate_all();
+}
+
+void validation_level_test::should_use_cache_written_by_strict_injector()
+{
+	const std::string file_name = "validation-level-test.txt";
+	std::remove(file_name.c_str());
+
+	make_injector(configuration::valid, injeqt::validation_level::deferred, file_name);
+	QVERIFY(!std::ifstream{file_name});
+
+	make_injector(configuration::valid, injeqt::validation_level::strict, file_name);
+	QVERIFY(static_cast<bool>(std::ifstream{file_name}));
+
+	auto injector = make_injector(configuration::valid, injeqt::validation_level::trusted, file_name);
+	QVERIFY(injector.get<first_client>()->first != nullptr);
+
+	std::remove(file_name.c_str());
+}
+
+QTEST_APPLESS_MAIN(validation_level_test)
+#include "validation-level-test.moc"
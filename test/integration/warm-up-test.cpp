@@ -0,0 +1,229 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../unit/expect.h"
+
+#include <injeqt/exception/instantiation-failed.h>
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ROLE "warm-up-role"
+
+namespace {
+
+std::vector<std::string> created;
+
+}
+
+class dependency_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE dependency_object() { created.push_back("dependency_object"); }
+
+};
+
+class low_priority_object : public QObject
+{
+	Q_OBJECT
+	INJEQT_WARM_UP_PRIORITY(-1)
+
+public:
+	Q_INVOKABLE low_priority_object() { created.push_back("low_priority_object"); }
+
+	dependency_object * dependency() const { return _dependency; }
+
+private:
+	QPointer<dependency_object> _dependency;
+
+private slots:
+	INJEQT_SET void set_dependency(dependency_object *dependency) { _dependency = dependency; }
+
+};
+
+class high_priority_object : public QObject
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE(ROLE)
+	INJEQT_WARM_UP_PRIORITY(10)
+
+public:
+	Q_INVOKABLE high_priority_object() { created.push_back("high_priority_object"); }
+
+};
+
+class unknown_object : public QObject
+{
+	Q_OBJECT
+
+};
+
+class failing_object : public QObject
+{
+	Q_OBJECT
+
+};
+
+class failing_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE failing_factory() {}
+
+	Q_INVOKABLE failing_object * create() { return nullptr; }
+
+};
+
+class warm_up_module : public injeqt::module
+{
+
+public:
+	explicit warm_up_module()
+	{
+		add_type<dependency_object>();
+		add_type<low_priority_object>();
+		add_type<high_priority_object>();
+		add_type<failing_factory>();
+		add_factory<failing_object, failing_factory>();
+	}
+
+};
+
+class warm_up_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void should_instantiate_queued_types_from_event_loop();
+	void should_instantiate_types_with_higher_priority_first();
+	void should_instantiate_types_with_type_role();
+	void should_get_queued_type_without_waiting();
+	void should_throw_when_queueing_unknown_type();
+	void should_report_warm_up_error_on_get();
+	void should_warm_up_lazy_injector_with_earlier_activations();
+
+private:
+	injeqt::injector make_injector(bool lazy = false);
+
+};
+
+injeqt::injector warm_up_test::make_injector(bool lazy)
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new warm_up_module{}});
+
+	auto options = injeqt::injector_options{};
+	options.lazy = lazy;
+	return injeqt::injector{std::move(modules), options};
+}
+
+void warm_up_test::init()
+{
+	created.clear();
+}
+
+void warm_up_test::should_instantiate_queued_types_from_event_loop()
+{
+	auto injector = make_injector();
+	injector.warm_up<low_priority_object>();
+
+	QVERIFY(created.empty());
+	QTRY_COMPARE(created.size(), size_t{2});
+	QCOMPARE(created, (std::vector<std::string>{"dependency_object", "low_priority_object"}));
+
+	auto object = injector.get<low_priority_object>();
+	QCOMPARE(object->dependency(), injector.get<dependency_object>());
+	QCOMPARE(created.size(), size_t{2});
+}
+
+void warm_up_test::should_instantiate_types_with_higher_priority_first()
+{
+	auto injector = make_injector();
+	injector.warm_up(std::vector<injeqt::type>{injeqt::make_type<low_priority_object>(), injeqt::make_type<high_priority_object>()});
+
+	QTRY_COMPARE(created.size(), size_t{3});
+	QCOMPARE(created.front(), std::string{"high_priority_object"});
+}
+
+void warm_up_test::should_instantiate_types_with_type_role()
+{
+	auto injector = make_injector();
+	injector.warm_up_with_type_role(ROLE);
+
+	QTRY_COMPARE(created.size(), size_t{1});
+	QCOMPARE(created.front(), std::string{"high_priority_object"});
+}
+
+void warm_up_test::should_get_queued_type_without_waiting()
+{
+	auto injector = make_injector();
+	injector.warm_up<low_priority_object>();
+
+	auto object = injector.get<low_priority_object>();
+	QVERIFY(object != nullptr);
+	QVERIFY(object->dependency() != nullptr);
+
+	QTest::qWait(20);
+	QCOMPARE(created.size(), size_t{2});
+	QCOMPARE(injector.get<low_priority_object>(), object);
+}
+
+void warm_up_test::should_throw_when_queueing_unknown_type()
+{
+	auto injector = make_injector();
+
+	expect<injeqt::exception::unknown_type>({"unknown_object"}, [&]{
+		injector.warm_up<unknown_object>();
+	});
+}
+
+void warm_up_test::should_report_warm_up_error_on_get()
+{
+	auto injector = make_injector();
+	injector.warm_up<failing_object>();
+
+	QTest::qWait(20);
+	expect<injeqt::exception::instantiation_failed>({"failing_object"}, [&]{
+		injector.get<failing_object>();
+	});
+}
+
+void warm_up_test::should_warm_up_lazy_injector_with_earlier_activations()
+{
+	auto injector = make_injector(true);
+	auto dependency = injector.get<dependency_object>();
+	injector.warm_up<low_priority_object>();
+
+	QTRY_COMPARE(created.size(), size_t{2});
+	QCOMPARE(created, (std::vector<std::string>{"dependency_object", "low_priority_object"}));
+	QCOMPARE(injector.get<low_priority_object>()->dependency(), dependency);
+}
+
+QTEST_GUILESS_MAIN(warm_up_test)
+#include "warm-up-test.moc"
@@ -42,6 +42,8 @@ public:
 
 	virtual const type & provided_type() const override { return _provided_type; };
 
+	virtual void prepare(injector_core &) override {}
+
 	virtual QObject * provide(injector_core &) override
 	{
 		if (!_object)
@@ -53,6 +55,14 @@ public:
 
 	virtual bool require_resolving() const override { return true; }
 
+	virtual QThread * object_thread() const override { return nullptr; }
+
+	virtual bool can_provide_in_any_thread() const override { return false; }
+
+	virtual void destroy_object() override {}
+
+	virtual provider_kind kind() const override { return provider_kind::default_constructor; }
+
 	QObject * object() const { return _object; }
 
 private:
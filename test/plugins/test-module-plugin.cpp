@@ -0,0 +1,75 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "test-plugin-api.h"
+
+#include <injeqt/module.h>
+#include <injeqt/module-plugin.h>
+
+#include <QtCore/QObject>
+#include <QtCore/QtPlugin>
+
+class test_plugin_service_implementation : public test_plugin_service
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE test_plugin_service_implementation() {}
+
+	virtual std::string name() const override { return "plugin"; }
+	virtual test_plugin_dependency * dependency() const override { return _dependency; }
+
+private slots:
+	INJEQT_SET void set_dependency(test_plugin_dependency *dependency) { _dependency = dependency; }
+
+private:
+	test_plugin_dependency *_dependency = nullptr;
+
+};
+
+class test_plugin_module : public injeqt::module
+{
+
+public:
+	test_plugin_module()
+	{
+		add_type<test_plugin_service_implementation>();
+	}
+
+	virtual ~test_plugin_module() {}
+
+};
+
+class test_module_plugin : public QObject, public injeqt::module_plugin
+{
+	Q_OBJECT
+	Q_PLUGIN_METADATA(IID INJEQT_MODULE_PLUGIN_IID)
+	Q_INTERFACES(injeqt::v1::module_plugin)
+
+public:
+	virtual std::unique_ptr<injeqt::module> create_module() override
+	{
+		test_plugin_service::created_modules++;
+		return std::unique_ptr<injeqt::module>{new test_plugin_module{}};
+	}
+
+};
+
+#include "test-module-plugin.moc"
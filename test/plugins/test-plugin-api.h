@@ -0,0 +1,62 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <string>
+
+#ifdef injeqt_test_plugin_api_EXPORTS
+#define TEST_PLUGIN_API Q_DECL_EXPORT
+#else
+#define TEST_PLUGIN_API Q_DECL_IMPORT
+#endif
+
+/**
+ * @file
+ * @brief Contains types shared by test plugin and tests that load it.
+ */
+
+class TEST_PLUGIN_API test_plugin_dependency : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE test_plugin_dependency();
+	virtual ~test_plugin_dependency();
+
+};
+
+class TEST_PLUGIN_API test_plugin_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @brief Number of modules created by test plugin in this process.
+	 */
+	static int created_modules;
+
+	virtual ~test_plugin_service();
+
+	virtual std::string name() const = 0;
+	virtual test_plugin_dependency * dependency() const = 0;
+
+};
@@ -0,0 +1,141 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/type.h>
+
+#include "internal/access-recorder.h"
+
+#include <QtTest/QtTest>
+#include <cstdio>
+#include <fstream>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+};
+
+class access_recorder_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_not_record_before_start();
+	void should_record_first_access_only();
+	void should_clear_records_on_start();
+	void should_write_and_read_records();
+	void should_not_read_missing_file();
+	void should_not_read_invalid_file();
+
+private:
+	const std::string file_name = "access-recorder-test.txt";
+
+};
+
+void access_recorder_test::should_not_record_before_start()
+{
+	access_recorder recorder;
+	recorder.record(make_type<type_1>(), access_recorder::clock::now());
+
+	QVERIFY(!recorder.is_recording());
+	QVERIFY(recorder.records().empty());
+}
+
+void access_recorder_test::should_record_first_access_only()
+{
+	access_recorder recorder;
+	recorder.start();
+	recorder.record(make_type<type_2>(), access_recorder::clock::now());
+	recorder.record(make_type<type_1>(), access_recorder::clock::now());
+	recorder.record(make_type<type_2>(), access_recorder::clock::now());
+	recorder.record(make_type<type_1>(), access_recorder::clock::time_point{});
+
+	auto records = recorder.records();
+	QVERIFY(recorder.is_recording());
+	QCOMPARE(records.size(), size_t{2});
+	QCOMPARE(records[0].type_name, std::string{"type_2"});
+	QCOMPARE(records[1].type_name, std::string{"type_1"});
+	QVERIFY(records[0].offset >= 0);
+	QVERIFY(records[0].duration >= 0);
+	QVERIFY(records[1].offset >= records[0].offset);
+}
+
+void access_recorder_test::should_clear_records_on_start()
+{
+	access_recorder recorder;
+	recorder.start();
+	recorder.record(make_type<type_1>(), access_recorder::clock::now());
+	recorder.start();
+
+	QVERIFY(recorder.records().empty());
+}
+
+void access_recorder_test::should_write_and_read_records()
+{
+	auto records = std::vector<access_record>{
+		access_record{"type_2", 10, 200},
+		access_record{"ns::type_1", 300, 0}
+	};
+
+	QVERIFY(write_access_records(file_name, records));
+
+	auto read = std::vector<access_record>{};
+	QVERIFY(read_access_records(file_name, read));
+	std::remove(file_name.c_str());
+
+	QCOMPARE(read.size(), size_t{2});
+	QCOMPARE(read[0].type_name, std::string{"type_2"});
+	QCOMPARE(read[0].offset, std::int64_t{10});
+	QCOMPARE(read[0].duration, std::int64_t{200});
+	QCOMPARE(read[1].type_name, std::string{"ns::type_1"});
+	QCOMPARE(read[1].offset, std::int64_t{300});
+	QCOMPARE(read[1].duration, std::int64_t{0});
+}
+
+void access_recorder_test::should_not_read_missing_file()
+{
+	auto read = std::vector<access_record>{access_record{"type_1", 0, 0}};
+	QVERIFY(!read_access_records("missing-access-recorder-test.txt", read));
+	QCOMPARE(read.size(), size_t{1});
+}
+
+void access_recorder_test::should_not_read_invalid_file()
+{
+	{
+		std::ofstream file{file_name};
+		file << "10 20 type_1\n" << "not a record\n";
+	}
+
+	auto read = std::vector<access_record>{};
+	QVERIFY(!read_access_records(file_name, read));
+	std::remove(file_name.c_str());
+
+	QVERIFY(read.empty());
+}
+
+QTEST_APPLESS_MAIN(access_recorder_test)
+#include "access-recorder-test.moc"
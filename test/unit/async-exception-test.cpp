@@ -0,0 +1,79 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+
+#include <injeqt/exception/unknown-type.h>
+
+#include "internal/async-exception.h"
+
+#include <QtTest/QtTest>
+#include <memory>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class async_exception_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_rethrow_original_exception();
+	void should_rethrow_original_exception_from_clone();
+
+private:
+	std::exception_ptr make_error();
+
+};
+
+std::exception_ptr async_exception_test::make_error()
+{
+	try
+	{
+		throw exception::unknown_type{"unknown_object"};
+	}
+	catch (...)
+	{
+		return std::current_exception();
+	}
+}
+
+void async_exception_test::should_rethrow_original_exception()
+{
+	auto e = async_exception{make_error()};
+
+	expect<exception::unknown_type>({"unknown_object"}, [&]{
+		e.raise();
+	});
+}
+
+void async_exception_test::should_rethrow_original_exception_from_clone()
+{
+	auto error = make_error();
+	auto e = std::unique_ptr<QException>{async_exception{error}.clone()};
+
+	QVERIFY(static_cast<async_exception *>(e.get())->error() == error);
+	expect<exception::unknown_type>({"unknown_object"}, [&]{
+		e->raise();
+	});
+}
+
+QTEST_APPLESS_MAIN(async_exception_test)
+#include "async-exception-test.moc"
@@ -0,0 +1,82 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "internal/critical-path-report.h"
+
+#include <QtTest/QtTest>
+#include <sstream>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class critical_path_report_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_write_nothing_for_no_paths();
+	void should_write_all_paths();
+	void should_not_write_most_expensive_type_of_not_measured_path();
+
+};
+
+void critical_path_report_test::should_write_nothing_for_no_paths()
+{
+	std::ostringstream report;
+	write_critical_path_report(report, std::vector<critical_path>{});
+
+	QCOMPARE(report.str(), std::string{});
+}
+
+void critical_path_report_test::should_write_all_paths()
+{
+	auto paths = std::vector<critical_path>{
+		critical_path{{"root", "slow", "leaf"}, {5, 300, 20}, 325, 400, 75},
+		critical_path{{"other_root"}, {10}, 10, 10, 0}
+	};
+
+	std::ostringstream report;
+	write_critical_path_report(report, paths);
+
+	QCOMPARE(report.str(), std::string{
+		"root: 325 us on critical path, 400 us in total, 75 us could be saved by parallel instantiation\n"
+		"  most expensive on path: slow (300 us)\n"
+		"    root 5 us\n"
+		"    slow 300 us\n"
+		"    leaf 20 us\n"
+		"other_root: 10 us on critical path, 10 us in total, 0 us could be saved by parallel instantiation\n"
+		"  most expensive on path: other_root (10 us)\n"
+		"    other_root 10 us\n"
+	});
+}
+
+void critical_path_report_test::should_not_write_most_expensive_type_of_not_measured_path()
+{
+	std::ostringstream report;
+	write_critical_path_report(report, std::vector<critical_path>{critical_path{{"root"}, {0}, 0, 0, 0}});
+
+	QCOMPARE(report.str(), std::string{
+		"root: 0 us on critical path, 0 us in total, 0 us could be saved by parallel instantiation\n"
+		"    root 0 us\n"
+	});
+}
+
+QTEST_APPLESS_MAIN(critical_path_report_test)
+#include "critical-path-report-test.moc"
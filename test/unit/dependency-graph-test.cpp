@@ -0,0 +1,88 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "internal/dependency-graph.h"
+
+#include <QtTest/QtTest>
+#include <sstream>
+
+using namespace injeqt::internal;
+
+class dependency_graph_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_write_empty_graph();
+	void should_write_dot();
+	void should_write_json();
+
+private:
+	dependency_graph make_graph();
+
+};
+
+dependency_graph dependency_graph_test::make_graph()
+{
+	auto result = dependency_graph{};
+	result.nodes.push_back(dependency_graph_node{"service", "default_constructor", {"service_base"}, {"role"}, true, 120, 30});
+	result.nodes.push_back(dependency_graph_node{"ns::\"quoted\"", "factory", {}, {}, false, -1, -1});
+	result.edges.push_back(dependency_graph_edge{"service", "ns::\"quoted\"", "setter", "set_quoted(quoted*)"});
+	result.edges.push_back(dependency_graph_edge{"ns::\"quoted\"", "service", "factory", ""});
+	return result;
+}
+
+void dependency_graph_test::should_write_empty_graph()
+{
+	std::stringstream dot;
+	write_dependency_graph_dot(dot, dependency_graph{});
+	std::stringstream json;
+	write_dependency_graph_json(json, dependency_graph{});
+
+	QCOMPARE(dot.str(), std::string{"digraph injeqt {\n\tnode [shape=box];\n}\n"});
+	QCOMPARE(json.str(), std::string{"{\"nodes\":[\n],\"edges\":[\n]}\n"});
+}
+
+void dependency_graph_test::should_write_dot()
+{
+	std::stringstream stream;
+	write_dependency_graph_dot(stream, make_graph());
+	auto dot = stream.str();
+
+	QVERIFY(dot.find("\t\"service\" [label=\"service\\ndefault_constructor\\ninterfaces: service_base\\nroles: role\\nconstruction: 120 us\\ninit: 30 us\\n\", style=filled, fillcolor=lightgray];\n") != std::string::npos);
+	QVERIFY(dot.find("\t\"ns::\\\"quoted\\\"\" [label=\"ns::\\\"quoted\\\"\\nfactory\\n\"];\n") != std::string::npos);
+	QVERIFY(dot.find("\t\"service\" -> \"ns::\\\"quoted\\\"\" [style=solid, label=\"set_quoted(quoted*)\"];\n") != std::string::npos);
+	QVERIFY(dot.find("\t\"ns::\\\"quoted\\\"\" -> \"service\" [style=dashed];\n") != std::string::npos);
+}
+
+void dependency_graph_test::should_write_json()
+{
+	std::stringstream stream;
+	write_dependency_graph_json(stream, make_graph());
+	auto json = stream.str();
+
+	QVERIFY(json.find("{\"name\":\"service\",\"kind\":\"default_constructor\",\"interfaces\":[\"service_base\"],\"type_roles\":[\"role\"],\"instantiated\":true,\"construction_time\":120,\"init_time\":30}") != std::string::npos);
+	QVERIFY(json.find("{\"name\":\"ns::\\\"quoted\\\"\",\"kind\":\"factory\",\"interfaces\":[],\"type_roles\":[],\"instantiated\":false,\"construction_time\":null,\"init_time\":null}") != std::string::npos);
+	QVERIFY(json.find("{\"from\":\"service\",\"to\":\"ns::\\\"quoted\\\"\",\"kind\":\"setter\",\"label\":\"set_quoted(quoted*)\"}") != std::string::npos);
+	QVERIFY(json.find("{\"from\":\"ns::\\\"quoted\\\"\",\"to\":\"service\",\"kind\":\"factory\",\"label\":\"\"}") != std::string::npos);
+}
+
+QTEST_APPLESS_MAIN(dependency_graph_test)
+#include "dependency-graph-test.moc"
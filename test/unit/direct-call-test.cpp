@@ -0,0 +1,148 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2014 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/direct-call.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class dependency_type : public QObject
+{
+	Q_OBJECT
+};
+
+class base_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	dependency_type *dependency = nullptr;
+	int base_calls = 0;
+
+public slots:
+	void set_dependency(dependency_type *d) { dependency = d; }
+	void call_base() { base_calls++; }
+
+};
+
+class derived_type : public base_type
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE derived_type() {}
+	Q_INVOKABLE derived_type(int) {}
+
+	int derived_calls = 0;
+
+public slots:
+	void call_derived() { derived_calls++; }
+	dependency_type * create_dependency() { return new dependency_type{}; }
+
+};
+
+class direct_call_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_be_empty_when_default_constructed();
+	void should_call_method();
+	void should_call_inherited_method_on_derived_object();
+	void should_pass_argument();
+	void should_return_value();
+	void should_create_instance_with_default_constructor();
+
+};
+
+void direct_call_test::should_be_empty_when_default_constructed()
+{
+	QVERIFY(direct_call{}.is_empty());
+	QVERIFY(!direct_call{get_method<derived_type>("call_derived()")}.is_empty());
+}
+
+void direct_call_test::should_call_method()
+{
+	auto object = make_object<derived_type>();
+	auto call = direct_call{get_method<derived_type>("call_derived()")};
+	void *arguments[] = {nullptr};
+
+	call.invoke(object.get(), arguments);
+	call.invoke(object.get(), arguments);
+
+	QCOMPARE(static_cast<derived_type *>(object.get())->derived_calls, 2);
+	QCOMPARE(static_cast<derived_type *>(object.get())->base_calls, 0);
+}
+
+void direct_call_test::should_call_inherited_method_on_derived_object()
+{
+	auto object = make_object<derived_type>();
+	auto call = direct_call{get_method<derived_type>("call_base()")};
+	void *arguments[] = {nullptr};
+
+	call.invoke(object.get(), arguments);
+
+	QCOMPARE(static_cast<derived_type *>(object.get())->derived_calls, 0);
+	QCOMPARE(static_cast<derived_type *>(object.get())->base_calls, 1);
+}
+
+void direct_call_test::should_pass_argument()
+{
+	auto object = make_object<derived_type>();
+	auto dependency = make_object<dependency_type>();
+	auto parameter = dependency.get();
+	auto call = direct_call{get_method<derived_type>("set_dependency(dependency_type*)")};
+	void *arguments[] = {nullptr, &parameter};
+
+	call.invoke(object.get(), arguments);
+
+	QCOMPARE(static_cast<QObject *>(static_cast<derived_type *>(object.get())->dependency), dependency.get());
+}
+
+void direct_call_test::should_return_value()
+{
+	auto object = make_object<derived_type>();
+	auto call = direct_call{get_method<derived_type>("create_dependency()")};
+	QObject *result = nullptr;
+	void *arguments[] = {&result};
+
+	call.invoke(object.get(), arguments);
+
+	auto created = std::unique_ptr<QObject>{result};
+	QVERIFY(created != nullptr);
+	QCOMPARE(created->metaObject(), &dependency_type::staticMetaObject);
+}
+
+void direct_call_test::should_create_instance_with_default_constructor()
+{
+	auto meta_object = &derived_type::staticMetaObject;
+	auto object = std::unique_ptr<QObject>{create_instance(meta_object, meta_object->indexOfConstructor("derived_type()"))};
+
+	QVERIFY(object != nullptr);
+	QCOMPARE(object->metaObject(), meta_object);
+}
+
+QTEST_APPLESS_MAIN(direct_call_test)
+#include "direct-call-test.moc"
@@ -25,6 +25,7 @@
 
 #include "internal/factory-method.h"
 
+#include <QtCore/QFutureInterface>
 #include <QtTest/QtTest>
 #include <string>
 
@@ -93,6 +94,21 @@ public slots:
 
 };
 
+class async_factory : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	Q_INVOKABLE QFuture<result_object *> create_result_object()
+	{
+		auto result = QFutureInterface<result_object *>{QFutureInterfaceBase::Started};
+		auto object = new result_object{};
+		result.reportFinished(&object);
+		return result.future();
+	}
+
+};
+
 class invalid_factory : public QObject
 {
 	Q_OBJECT
@@ -119,6 +135,8 @@ private slots:
 	void should_create_valid_subtype_with_invokable_factory_method();
 	void should_create_valid_with_invokable_factory_with_default_parameter_method();
 	void should_create_object_with_factory_method();
+	void should_create_valid_with_async_factory_method();
+	void should_create_object_with_async_factory_method();
 	void should_properly_compare();
 
 private:
@@ -137,6 +155,7 @@ factory_method_test::factory_method_test()
 		make_type<valid_factory_subtype>(),
 		make_type<valid_multi_factory>(),
 		make_type<valid_factory_with_default_parameter>(),
+		make_type<async_factory>(),
 		make_type<invalid_factory>()
 	}};
 }
@@ -218,6 +237,34 @@ void factory_method_test::should_create_object_with_factory_method()
 	QVERIFY(cast != nullptr);
 }
 
+void factory_method_test::should_create_valid_with_async_factory_method()
+{
+	auto f = make_factory_method(known_types, make_type<result_object>(), make_type<async_factory>(), &read_factory_future<result_object>);
+	QVERIFY(!f.is_empty());
+	QVERIFY(f.is_async());
+	QCOMPARE(f.object_type(), make_type<async_factory>());
+	QCOMPARE(f.result_type(), make_type<result_object>());
+
+	auto sync = make_factory_method(known_types, make_type<result_object>(), make_type<valid_factory>());
+	QVERIFY(!sync.is_async());
+
+	// future of unknown type can not be read
+	auto without_reader = make_factory_method(known_types, make_type<result_object>(), make_type<async_factory>());
+	QVERIFY(without_reader.is_empty());
+}
+
+void factory_method_test::should_create_object_with_async_factory_method()
+{
+	auto f = make_factory_method(known_types, make_type<result_object>(), make_type<async_factory>(), &read_factory_future<result_object>);
+	auto factory_object = make_object<async_factory>();
+
+	auto async_object = std::unique_ptr<QObject>{f.invoke_async(factory_object.get())()};
+	QVERIFY(qobject_cast<result_object *>(async_object.get()) != nullptr);
+
+	auto object = f.invoke(factory_object.get());
+	QVERIFY(qobject_cast<result_object *>(object.get()) != nullptr);
+}
+
 void factory_method_test::should_properly_compare()
 {
 	auto fm_empty = factory_method{};
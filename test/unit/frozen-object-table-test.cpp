@@ -0,0 +1,96 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2014 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "internal/frozen-object-table.h"
+
+#include <QtTest/QtTest>
+#include <memory>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+};
+
+class frozen_object_table_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_be_empty_after_default_construction();
+	void should_be_empty_when_created_with_no_objects();
+	void should_return_stored_objects();
+	void should_return_nullptr_for_missing_type();
+
+};
+
+void frozen_object_table_test::should_be_empty_after_default_construction()
+{
+	auto table = frozen_object_table{};
+	QCOMPARE(table.size(), size_t{0});
+	QVERIFY(table.get(make_type<type_1>()) == nullptr);
+}
+
+void frozen_object_table_test::should_be_empty_when_created_with_no_objects()
+{
+	auto table = frozen_object_table{std::vector<std::pair<type, QObject *>>{}};
+	QCOMPARE(table.size(), size_t{0});
+	QVERIFY(table.get(make_type<type_1>()) == nullptr);
+}
+
+void frozen_object_table_test::should_return_stored_objects()
+{
+	auto object_1 = std::unique_ptr<QObject>{new type_1{}};
+	auto object_2 = std::unique_ptr<QObject>{new type_2{}};
+	auto table = frozen_object_table{std::vector<std::pair<type, QObject *>>{
+		{make_type<type_1>(), object_1.get()},
+		{make_type<type_2>(), object_2.get()}
+	}};
+
+	QCOMPARE(table.size(), size_t{2});
+	QCOMPARE(table.get(make_type<type_1>()), object_1.get());
+	QCOMPARE(table.get(make_type<type_2>()), object_2.get());
+}
+
+void frozen_object_table_test::should_return_nullptr_for_missing_type()
+{
+	auto object_1 = std::unique_ptr<QObject>{new type_1{}};
+	auto table = frozen_object_table{std::vector<std::pair<type, QObject *>>{
+		{make_type<type_1>(), object_1.get()}
+	}};
+
+	QVERIFY(table.get(make_type<type_2>()) == nullptr);
+	QVERIFY(table.get(make_type<type_3>()) == nullptr);
+}
+
+QTEST_APPLESS_MAIN(frozen_object_table_test)
+#include "frozen-object-table-test.moc"
@@ -28,7 +28,9 @@
 #include <injeqt/exception/unknown-type.h>
 
 #include "internal/injector-core.h"
+#include "internal/provider-ready.h"
 
+#include <QtCore/QThread>
 #include <QtTest/QtTest>
 #include <string>
 
@@ -167,8 +169,12 @@ private slots:
 	void should_not_accept_ambiguous_required_supertype();
 	void should_accept_cyclic_dependencies();
 	void should_accept_dependencies_that_are_required();
+	void should_instantiate_only_missing_dependencies();
 	void should_inject_into_unregistered_type();
 	void should_not_inject_into_when_unknown_dependencies();
+	void should_order_dependencies_before_dependents();
+	void should_order_cyclic_dependencies();
+	void should_not_move_ready_objects_to_object_thread();
 	// TODO: https://github.com/vogel/injeqt/issues/3
 	/*
 		void should_not_accept_cyclic_required_types();
@@ -451,6 +457,35 @@ void injector_core_test::should_accept_dependencies_that_are_required()
 	QVERIFY(o8 == get<type_8>(i));
 }
 
+void injector_core_test::should_instantiate_only_missing_dependencies()
+{
+	auto type_7_provider_p = make_mocked_provider<type_7>();
+	auto type_7_provider = type_7_provider_p.get();
+	auto type_8_provider_p = make_mocked_provider<type_8>();
+	auto type_8_provider = type_8_provider_p.get();
+	auto type_9_provider_p = make_mocked_provider<type_9>();
+	auto type_9_provider = type_9_provider_p.get();
+
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(std::move(type_7_provider_p));
+	configuration.push_back(std::move(type_8_provider_p));
+	configuration.push_back(std::move(type_9_provider_p));
+
+	auto i = injector_core{types_by_name{make_type<type_7>(), make_type<type_8>(), make_type<type_9>()}, std::move(configuration)};
+
+	auto o7 = get<type_7>(i);
+	QVERIFY(o7 != nullptr);
+	QVERIFY(type_8_provider->object() == nullptr);
+	QVERIFY(type_9_provider->object() == nullptr);
+
+	auto o9 = get<type_9>(i);
+	QVERIFY(o9 != nullptr);
+	QVERIFY(o7 == type_7_provider->object());
+	QVERIFY(o7 == o9->o7);
+	QVERIFY(type_8_provider->object() == o9->o8);
+	QVERIFY(o9->o8 != nullptr);
+}
+
 void injector_core_test::should_inject_into_unregistered_type()
 {
 	auto type_1_provider_p = make_mocked_provider<type_1>();
@@ -485,6 +520,57 @@ void injector_core_test::should_not_inject_into_when_unknown_dependencies()
 	});
 }
 
+void injector_core_test::should_order_dependencies_before_dependents()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_7>());
+	configuration.push_back(make_mocked_provider<type_8>());
+	configuration.push_back(make_mocked_provider<type_9>());
+
+	auto i = injector_core{types_by_name{make_type<type_7>(), make_type<type_8>(), make_type<type_9>()}, std::move(configuration)};
+
+	auto order = i.instantiation_order(make_type<type_9>());
+	QCOMPARE(order.size(), size_t{3});
+	QCOMPARE(order.back(), make_type<type_9>());
+	QVERIFY(std::find(std::begin(order), std::end(order), make_type<type_7>()) != std::end(order));
+	QVERIFY(std::find(std::begin(order), std::end(order), make_type<type_8>()) != std::end(order));
+
+	get<type_7>(i);
+	QCOMPARE(i.instantiation_order(make_type<type_9>()), (std::vector<type>{make_type<type_8>(), make_type<type_9>()}));
+
+	get<type_9>(i);
+	QCOMPARE(i.instantiation_order(make_type<type_9>()), std::vector<type>{});
+}
+
+void injector_core_test::should_order_cyclic_dependencies()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_4>());
+	configuration.push_back(make_mocked_provider<type_5>());
+	configuration.push_back(make_mocked_provider<type_6>());
+
+	auto i = injector_core{types_by_name{make_type<type_4>(), make_type<type_5>(), make_type<type_6>()}, std::move(configuration)};
+
+	QCOMPARE(i.instantiation_order(make_type<type_4>()), (std::vector<type>{make_type<type_6>(), make_type<type_5>(), make_type<type_4>()}));
+}
+
+void injector_core_test::should_not_move_ready_objects_to_object_thread()
+{
+	auto ready = std::unique_ptr<type_1>(new type_1{});
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(std::unique_ptr<provider>(new provider_ready{implementation{make_type<type_1>(), ready.get()}}));
+
+	auto thread = std::unique_ptr<QThread>(new QThread{});
+	{
+		auto i = injector_core{types_by_name{make_type<type_1>()}, std::move(configuration)};
+		i.instantiate(make_type<type_1>(), thread.get());
+
+		QCOMPARE(get<type_1>(i), ready.get());
+		QCOMPARE(ready->thread(), QThread::currentThread());
+	}
+	QCOMPARE(ready->thread(), QThread::currentThread());
+}
+
 // TODO: https://github.com/vogel/injeqt/issues/3
 /*
 void injector_core_test::should_not_accept_cyclic_required_types()
@@ -0,0 +1,266 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+
+#include <injeqt/exception/plugin-load-failed.h>
+#include <injeqt/module.h>
+
+#include "internal/lazy-configuration.h"
+#include "internal/provider-by-default-constructor-configuration.h"
+#include "internal/provider-by-factory-configuration.h"
+
+#include <QtTest/QtTest>
+#include <memory>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class dependency_type : public QObject
+{
+	Q_OBJECT
+};
+
+class base_type : public QObject
+{
+	Q_OBJECT
+};
+
+class implementation_type : public base_type
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE("role")
+
+public slots:
+	INJEQT_SET void set_dependency(dependency_type *) {}
+
+};
+
+class client_type : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_base(base_type *) {}
+
+};
+
+class product_type : public QObject
+{
+	Q_OBJECT
+};
+
+class factory_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE product_type * create() { return nullptr; }
+
+};
+
+class unrelated_type : public QObject
+{
+	Q_OBJECT
+};
+
+class plugin_type : public base_type
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_dependency(dependency_type *) {}
+
+};
+
+class plugin_type_module : public injeqt::module
+{
+
+public:
+	plugin_type_module()
+	{
+		add_type<plugin_type>();
+	}
+
+	virtual ~plugin_type_module() {}
+
+};
+
+class lazy_configuration_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_return_provided_types();
+	void should_select_type_with_dependencies();
+	void should_select_type_by_interface();
+	void should_select_factory_type();
+	void should_ignore_unknown_type();
+	void should_not_select_taken_configurations();
+	void should_select_with_type_role();
+	void should_select_all_not_taken();
+	void should_load_plugin_when_declared_type_is_needed();
+	void should_throw_when_plugin_does_not_provide_declared_type();
+	void should_load_all_plugins_on_select_all();
+
+private:
+	int loaded_plugins;
+
+	lazy_configuration make_configuration(std::vector<plugin_declaration> plugins = std::vector<plugin_declaration>{});
+
+};
+
+namespace {
+
+std::vector<std::size_t> indexes(std::initializer_list<std::size_t> list)
+{
+	return std::vector<std::size_t>(list);
+}
+
+}
+
+lazy_configuration lazy_configuration_test::make_configuration(std::vector<plugin_declaration> plugins)
+{
+	loaded_plugins = 0;
+	auto loader = [this](const std::string &){
+		loaded_plugins++;
+		return std::unique_ptr<injeqt::module>{new plugin_type_module{}};
+	};
+
+	return lazy_configuration{std::vector<std::shared_ptr<provider_configuration>>{
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<dependency_type>()),
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<implementation_type>()),
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<client_type>()),
+		std::make_shared<provider_by_factory_configuration>(make_type<product_type>(), make_type<factory_type>()),
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<factory_type>()),
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<unrelated_type>())
+	}, std::move(plugins), loader};
+}
+
+void lazy_configuration_test::should_return_provided_types()
+{
+	auto configuration = make_configuration();
+
+	QCOMPARE(configuration.all().size(), size_t{6});
+	QCOMPARE(configuration.provided_types(), (std::vector<type>{
+		make_type<dependency_type>(),
+		make_type<implementation_type>(),
+		make_type<client_type>(),
+		make_type<product_type>(),
+		make_type<factory_type>(),
+		make_type<unrelated_type>()
+	}));
+}
+
+void lazy_configuration_test::should_select_type_with_dependencies()
+{
+	auto configuration = make_configuration();
+
+	QCOMPARE(configuration.select({"implementation_type"}), indexes({0, 1}));
+	QCOMPARE(configuration.select({"dependency_type"}), indexes({0}));
+}
+
+void lazy_configuration_test::should_select_type_by_interface()
+{
+	auto configuration = make_configuration();
+
+	QCOMPARE(configuration.select({"base_type"}), indexes({0, 1}));
+	QCOMPARE(configuration.select({"client_type"}), indexes({0, 1, 2}));
+}
+
+void lazy_configuration_test::should_select_factory_type()
+{
+	auto configuration = make_configuration();
+
+	QCOMPARE(configuration.select({"product_type"}), indexes({3, 4}));
+	QCOMPARE(configuration.select({"factory_type"}), indexes({4}));
+}
+
+void lazy_configuration_test::should_ignore_unknown_type()
+{
+	auto configuration = make_configuration();
+
+	QVERIFY(configuration.select({"unknown_type"}).empty());
+	QCOMPARE(configuration.select({"unknown_type", "dependency_type"}), indexes({0}));
+}
+
+void lazy_configuration_test::should_not_select_taken_configurations()
+{
+	auto configuration = make_configuration();
+	configuration.take(configuration.select({"implementation_type"}));
+
+	QVERIFY(configuration.select({"implementation_type"}).empty());
+	QCOMPARE(configuration.select({"client_type"}), indexes({2}));
+	QCOMPARE(configuration.configurations(indexes({2})), (std::vector<std::shared_ptr<provider_configuration>>{configuration.all()[2]}));
+}
+
+void lazy_configuration_test::should_select_with_type_role()
+{
+	auto configuration = make_configuration();
+
+	QCOMPARE(configuration.select_with_type_role("role"), indexes({0, 1}));
+	QVERIFY(configuration.select_with_type_role("unknown role").empty());
+}
+
+void lazy_configuration_test::should_select_all_not_taken()
+{
+	auto configuration = make_configuration();
+	configuration.take(indexes({1, 3}));
+
+	QCOMPARE(configuration.select_all(), indexes({0, 2, 4, 5}));
+}
+
+void lazy_configuration_test::should_load_plugin_when_declared_type_is_needed()
+{
+	auto configuration = make_configuration({plugin_declaration{"plugin", {"plugin_type"}}});
+
+	QCOMPARE(configuration.select({"implementation_type"}), indexes({0, 1}));
+	QCOMPARE(loaded_plugins, 0);
+	QCOMPARE(configuration.all().size(), size_t{6});
+
+	QCOMPARE(configuration.select({"plugin_type"}), indexes({0, 6}));
+	QCOMPARE(loaded_plugins, 1);
+	QCOMPARE(configuration.all().size(), size_t{7});
+	QCOMPARE(configuration.provided_types().back(), make_type<plugin_type>());
+
+	QCOMPARE(configuration.select({"plugin_type"}), indexes({0, 6}));
+	QCOMPARE(loaded_plugins, 1);
+}
+
+void lazy_configuration_test::should_throw_when_plugin_does_not_provide_declared_type()
+{
+	auto configuration = make_configuration({plugin_declaration{"plugin", {"missing_type"}}});
+
+	expect<exception::plugin_load_failed>({"plugin", "missing_type"}, [&]{
+		configuration.select({"missing_type"});
+	});
+	QCOMPARE(configuration.all().size(), size_t{6});
+}
+
+void lazy_configuration_test::should_load_all_plugins_on_select_all()
+{
+	auto configuration = make_configuration({plugin_declaration{"plugin", {"plugin_type"}}});
+
+	QCOMPARE(configuration.select_all(), indexes({0, 1, 2, 3, 4, 5, 6}));
+	QCOMPARE(loaded_plugins, 1);
+}
+
+QTEST_APPLESS_MAIN(lazy_configuration_test)
+#include "lazy-configuration-test.moc"
@@ -0,0 +1,166 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../mocks/mocked-provider.h"
+#include "utils.h"
+
+#include <injeqt/type.h>
+
+#include "internal/model-cache.h"
+
+#include <QtTest/QtTest>
+#include <cstdio>
+#include <fstream>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_1_subtype_1 : public type_1
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	INJEQT_SET void set_type_1(type_1 *) {}
+
+};
+
+class model_cache_test : public QObject
+{
+	Q_OBJECT
+
+public:
+	model_cache_test();
+
+private slots:
+	void cleanup();
+	void should_compute_same_fingerprint_for_same_configuration();
+	void should_compute_other_fingerprint_for_other_providers();
+	void should_compute_other_fingerprint_for_other_known_types();
+	void should_write_and_read_model();
+	void should_not_read_model_with_other_fingerprint();
+	void should_not_read_missing_file();
+	void should_not_read_invalid_file();
+
+private:
+	const std::string file_name = "model-cache-test.txt";
+	types_by_name known_types;
+
+	providers make_providers() const;
+	types_model make_model() const;
+
+};
+
+model_cache_test::model_cache_test() :
+	known_types{std::vector<type>{make_type<type_1>(), make_type<type_1_subtype_1>(), make_type<type_2>()}}
+{
+}
+
+providers model_cache_test::make_providers() const
+{
+	auto result = std::vector<std::unique_ptr<provider>>{};
+	result.push_back(make_mocked_provider<type_1_subtype_1>());
+	result.push_back(make_mocked_provider<type_2>());
+	return providers{std::move(result)};
+}
+
+types_model model_cache_test::make_model() const
+{
+	auto type_1_type = make_type<type_1>();
+	auto type_1_subtype_1_type = make_type<type_1_subtype_1>();
+	auto type_2_type = make_type<type_2>();
+	return make_types_model(known_types, {type_1_subtype_1_type, type_2_type}, {type_1_type, type_1_subtype_1_type, type_2_type});
+}
+
+void model_cache_test::cleanup()
+{
+	std::remove(file_name.c_str());
+}
+
+void model_cache_test::should_compute_same_fingerprint_for_same_configuration()
+{
+	QCOMPARE(model_fingerprint(known_types, make_providers()), model_fingerprint(known_types, make_providers()));
+}
+
+void model_cache_test::should_compute_other_fingerprint_for_other_providers()
+{
+	auto other_providers = std::vector<std::unique_ptr<provider>>{};
+	other_providers.push_back(make_mocked_provider<type_1_subtype_1>());
+	other_providers.push_back(make_mocked_provider<type_2, type_1>());
+
+	QVERIFY(model_fingerprint(known_types, make_providers()) != model_fingerprint(known_types, providers{std::move(other_providers)}));
+}
+
+void model_cache_test::should_compute_other_fingerprint_for_other_known_types()
+{
+	auto other_known_types = types_by_name{std::vector<type>{make_type<type_1>(), make_type<type_1_subtype_1>()}};
+
+	QVERIFY(model_fingerprint(known_types, make_providers()) != model_fingerprint(other_known_types, make_providers()));
+}
+
+void model_cache_test::should_write_and_read_model()
+{
+	auto model = make_model();
+	QVERIFY(write_model_cache(file_name, 7, model));
+
+	auto read_model = types_model{};
+	QVERIFY(read_model_cache(file_name, 7, known_types, read_model));
+	QCOMPARE(read_model.available_types(), model.available_types());
+	QCOMPARE(read_model.mapped_dependencies(), model.mapped_dependencies());
+}
+
+void model_cache_test::should_not_read_model_with_other_fingerprint()
+{
+	QVERIFY(write_model_cache(file_name, 7, make_model()));
+
+	auto read_model = types_model{};
+	QVERIFY(!read_model_cache(file_name, 8, known_types, read_model));
+	QVERIFY(read_model.available_types().empty());
+}
+
+void model_cache_test::should_not_read_missing_file()
+{
+	auto read_model = types_model{};
+	QVERIFY(!read_model_cache(file_name, 7, known_types, read_model));
+}
+
+void model_cache_test::should_not_read_invalid_file()
+{
+	{
+		std::ofstream file{file_name};
+		file << "injeqt-model-cache 1\n7\nA type_1 type_3\n";
+	}
+
+	auto read_model = types_model{};
+	QVERIFY(!read_model_cache(file_name, 7, known_types, read_model));
+	QVERIFY(read_model.available_types().empty());
+}
+
+QTEST_APPLESS_MAIN(model_cache_test)
+#include "model-cache-test.moc"
@@ -0,0 +1,168 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+
+#include <injeqt/exception/default-constructor-not-found.h>
+
+#include "internal/provider-by-default-constructor-configuration.h"
+#include "internal/provider-by-factory-configuration.h"
+#include "internal/provider-configurations.h"
+#include "internal/provider.h"
+
+#include <QtTest/QtTest>
+#include <limits>
+#include <memory>
+
+using namespace injeqt::v1;
+using namespace injeqt::internal;
+
+class base_type : public QObject
+{
+	Q_OBJECT
+};
+
+class implementation_type : public base_type
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE implementation_type() {}
+
+};
+
+class product_type : public QObject
+{
+	Q_OBJECT
+};
+
+class factory_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE factory_type() {}
+
+	Q_INVOKABLE product_type * create() { return nullptr; }
+
+};
+
+class first_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE first_type() {}
+
+};
+
+class second_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE second_type() {}
+
+};
+
+class not_default_constructor_type : public QObject
+{
+	Q_OBJECT
+};
+
+class provider_configurations_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_make_the_same_known_types_in_parallel_and_in_sequence();
+	void should_make_the_same_providers_in_parallel_and_in_sequence();
+	void should_throw_for_first_invalid_configuration_in_parallel_and_in_sequence();
+
+private:
+	std::vector<std::shared_ptr<provider_configuration>> make_configurations();
+
+};
+
+namespace {
+
+// every call is parallel, as no number of configurations is lower
+const std::size_t parallel = 0;
+const std::size_t sequential = std::numeric_limits<std::size_t>::max();
+
+}
+
+std::vector<std::shared_ptr<provider_configuration>> provider_configurations_test::make_configurations()
+{
+	return std::vector<std::shared_ptr<provider_configuration>>{
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<implementation_type>()),
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<factory_type>()),
+		std::make_shared<provider_by_factory_configuration>(make_type<product_type>(), make_type<factory_type>()),
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<first_type>()),
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<second_type>())
+	};
+}
+
+void provider_configurations_test::should_make_the_same_known_types_in_parallel_and_in_sequence()
+{
+	auto configurations = make_configurations();
+	auto parallel_types = make_known_types(configurations, parallel);
+	auto sequential_types = make_known_types(configurations, sequential);
+
+	QVERIFY(parallel_types == sequential_types);
+	QCOMPARE(parallel_types.size(), size_t{6});
+	QVERIFY(parallel_types.contains(make_type<base_type>()));
+}
+
+void provider_configurations_test::should_make_the_same_providers_in_parallel_and_in_sequence()
+{
+	auto configurations = make_configurations();
+	auto known_types = make_known_types(configurations);
+	auto parallel_providers = make_providers(configurations, known_types, parallel);
+	auto sequential_providers = make_providers(configurations, known_types, sequential);
+
+	QCOMPARE(parallel_providers.size(), configurations.size());
+	QCOMPARE(sequential_providers.size(), configurations.size());
+	for (decltype(configurations.size()) i = 0; i < configurations.size(); i++)
+	{
+		QCOMPARE(parallel_providers[i]->provided_type(), configurations[i]->types().front());
+		QCOMPARE(sequential_providers[i]->provided_type(), configurations[i]->types().front());
+		QVERIFY(parallel_providers[i]->kind() == sequential_providers[i]->kind());
+		QCOMPARE(parallel_providers[i]->required_types(), sequential_providers[i]->required_types());
+	}
+}
+
+void provider_configurations_test::should_throw_for_first_invalid_configuration_in_parallel_and_in_sequence()
+{
+	auto configurations = make_configurations();
+	configurations.insert(std::begin(configurations) + 1,
+		std::make_shared<provider_by_default_constructor_configuration>(make_type<not_default_constructor_type>()));
+	auto known_types = make_known_types(configurations);
+
+	expect<injeqt::exception::default_constructor_not_found>({"not_default_constructor_type"}, [&](){
+		make_providers(configurations, known_types, parallel);
+	});
+	expect<injeqt::exception::default_constructor_not_found>({"not_default_constructor_type"}, [&](){
+		make_providers(configurations, known_types, sequential);
+	});
+}
+
+QTEST_GUILESS_MAIN(provider_configurations_test)
+#include "provider-configurations-test.moc"
@@ -62,12 +62,19 @@ private slots:
 	void should_be_valid_after_merging_misc_unique_elements();
 	void should_be_valid_after_merging_greater_or_equal_elements();
 	void should_be_valid_after_merging_greater_elements();
+	void should_keep_existing_items_after_merging_equal_keys();
+	void should_be_valid_after_adding_all_to_empty();
+	void should_be_valid_after_adding_all_greater_elements();
+	void should_be_valid_after_adding_all_misc_elements();
+	void should_keep_existing_items_after_adding_all_equal_keys();
 	void should_match_return_nothing_for_two_empty_vectors();
 	void should_match_return_only_unresolved_for_first_empty_vector();
 	void should_match_return_only_unresolved_for_second_empty_vector();
 	void should_match_return_only_unresolved_for_non_matching_vectors();
 	void should_match_return_only_resolved_for_matching_vectors();
 	void should_match_return_valid_data_for_partially_matching_vectors();
+	void should_match_stream_valid_data_for_partially_matching_vectors();
+	void should_match_stream_only_requested_data();
 	void should_return_false_for_contains_when_empty();
 	void should_return_false_for_contains_when_does_not_contain();
 	void should_return_true_for_contains_when_contains();
@@ -282,6 +289,55 @@ void sorted_unique_vector_test::should_be_valid_after_merging_greater_elements()
 	QCOMPARE(data.content(), (std::vector<int>{1, 2, 4, 5, 6, 7}));
 }
 
+void sorted_unique_vector_test::should_keep_existing_items_after_merging_equal_keys()
+{
+	auto data = suv_pair{{1, "a"}, {3, "c"}};
+	auto data_to_add = suv_pair{{0, "x"}, {1, "y"}, {3, "z"}, {4, "w"}};
+	data.merge(data_to_add);
+
+	QCOMPARE(data.size(), size_t{4});
+	QCOMPARE(data.content(), (std::vector<std::pair<int, std::string>>{{0, "x"}, {1, "a"}, {3, "c"}, {4, "w"}}));
+}
+
+void sorted_unique_vector_test::should_be_valid_after_adding_all_to_empty()
+{
+	auto data = suv_int{};
+	data.add_all({5, 1, 4, 1, 2, 5});
+
+	QVERIFY(!data.empty());
+	QCOMPARE(data.size(), size_t{4});
+	QCOMPARE(data.content(), (std::vector<int>{1, 2, 4, 5}));
+}
+
+void sorted_unique_vector_test::should_be_valid_after_adding_all_greater_elements()
+{
+	auto data = suv_int{1, 2, 4, 5};
+	data.add_all({8, 6, 7, 6});
+
+	QVERIFY(!data.empty());
+	QCOMPARE(data.size(), size_t{7});
+	QCOMPARE(data.content(), (std::vector<int>{1, 2, 4, 5, 6, 7, 8}));
+}
+
+void sorted_unique_vector_test::should_be_valid_after_adding_all_misc_elements()
+{
+	auto data = suv_int{1, 2, 4, 5};
+	data.add_all({7, 0, 3, 5, 3});
+
+	QVERIFY(!data.empty());
+	QCOMPARE(data.size(), size_t{7});
+	QCOMPARE(data.content(), (std::vector<int>{0, 1, 2, 3, 4, 5, 7}));
+}
+
+void sorted_unique_vector_test::should_keep_existing_items_after_adding_all_equal_keys()
+{
+	auto data = suv_pair{{1, "a"}, {3, "c"}};
+	data.add_all({{3, "z"}, {2, "b"}, {1, "y"}, {2, "x"}});
+
+	QCOMPARE(data.size(), size_t{3});
+	QCOMPARE(data.content(), (std::vector<std::pair<int, std::string>>{{1, "a"}, {2, "b"}, {3, "c"}}));
+}
+
 void sorted_unique_vector_test::should_match_return_nothing_for_two_empty_vectors()
 {
 	auto result = match(suv_int{}, suv_int{});
@@ -330,6 +386,34 @@ void sorted_unique_vector_test::should_match_return_valid_data_for_partially_mat
 	QCOMPARE(result.unmatched_2.content(), (std::vector<int>{4, 5}));
 }
 
+void sorted_unique_vector_test::should_match_stream_valid_data_for_partially_matching_vectors()
+{
+	auto matched = std::vector<std::pair<int, int>>{};
+	auto unmatched_1 = std::vector<int>{};
+	auto unmatched_2 = std::vector<int>{};
+
+	match(suv_int{1, 2, 3, 6}, suv_int{2, 3, 4, 5}, extract_key, extract_key,
+		[&](int x, int y){ matched.emplace_back(x, y); },
+		[&](int x){ unmatched_1.push_back(x); },
+		[&](int y){ unmatched_2.push_back(y); });
+
+	QCOMPARE(matched, (std::vector<std::pair<int, int>>{{2, 2}, {3, 3}}));
+	QCOMPARE(unmatched_1, (std::vector<int>{1, 6}));
+	QCOMPARE(unmatched_2, (std::vector<int>{4, 5}));
+}
+
+void sorted_unique_vector_test::should_match_stream_only_requested_data()
+{
+	auto unmatched_1 = std::vector<int>{};
+
+	match(suv_int{1, 2, 3, 6}, suv_int{2, 3, 4, 5}, extract_key, extract_key,
+		match_ignore{},
+		[&](int x){ unmatched_1.push_back(x); },
+		match_ignore{});
+
+	QCOMPARE(unmatched_1, (std::vector<int>{1, 6}));
+}
+
 void sorted_unique_vector_test::should_return_false_for_contains_when_empty()
 {
 	auto data = suv_pair{};
@@ -0,0 +1,175 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+
+#include "internal/thread-call.h"
+
+#include <QtTest/QtTest>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace injeqt::internal;
+
+class thread_call_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_call_directly_without_thread();
+	void should_call_directly_in_current_thread();
+	void should_call_in_other_thread();
+	void should_rethrow_exception_from_other_thread();
+	void should_call_in_thread_pool();
+	void should_call_each_index_once_in_thread_pool();
+	void should_rethrow_exception_with_lowest_index_from_thread_pool();
+	void should_transform_in_order_in_thread_pool();
+	void should_transform_in_current_thread_below_threshold();
+	void should_rethrow_exception_of_first_item_from_parallel_transform();
+
+};
+
+void thread_call_test::should_call_directly_without_thread()
+{
+	auto called_in = static_cast<QThread *>(nullptr);
+	call_in_thread(nullptr, [&](){ called_in = QThread::currentThread(); });
+
+	QCOMPARE(called_in, QThread::currentThread());
+}
+
+void thread_call_test::should_call_directly_in_current_thread()
+{
+	auto called_in = static_cast<QThread *>(nullptr);
+	call_in_thread(QThread::currentThread(), [&](){ called_in = QThread::currentThread(); });
+
+	QCOMPARE(called_in, QThread::currentThread());
+}
+
+void thread_call_test::should_call_in_other_thread()
+{
+	QThread thread;
+	thread.start();
+
+	auto called_in = static_cast<QThread *>(nullptr);
+	call_in_thread(&thread, [&](){ called_in = QThread::currentThread(); });
+
+	thread.quit();
+	thread.wait();
+
+	QCOMPARE(called_in, &thread);
+}
+
+void thread_call_test::should_rethrow_exception_from_other_thread()
+{
+	QThread thread;
+	thread.start();
+
+	expect<std::runtime_error>({"thrown in thread"}, [&]{
+		call_in_thread(&thread, [](){ throw std::runtime_error{"thrown in thread"}; });
+	});
+
+	thread.quit();
+	thread.wait();
+}
+
+void thread_call_test::should_call_in_thread_pool()
+{
+	QSemaphore done;
+	auto called_in = static_cast<QThread *>(nullptr);
+	call_in_thread_pool([&](){
+		called_in = QThread::currentThread();
+		done.release();
+	});
+	done.acquire();
+
+	QVERIFY(called_in != nullptr);
+	QVERIFY(called_in != QThread::currentThread());
+}
+
+void thread_call_test::should_call_each_index_once_in_thread_pool()
+{
+	auto count = std::size_t{1000};
+	auto calls = std::unique_ptr<std::atomic<int>[]>{new std::atomic<int>[count]};
+	for (decltype(count) i = 0; i < count; i++)
+		calls[i] = 0;
+
+	call_in_thread_pool(count, [&](std::size_t index){ calls[index]++; });
+
+	for (decltype(count) i = 0; i < count; i++)
+		QCOMPARE(calls[i].load(), 1);
+}
+
+void thread_call_test::should_rethrow_exception_with_lowest_index_from_thread_pool()
+{
+	std::atomic<int> calls{0};
+
+	expect<std::runtime_error>({"index 3"}, [&]{
+		call_in_thread_pool(100, [&](std::size_t index){
+			calls++;
+			if (index == 3 || index == 50)
+				throw std::runtime_error{"index " + std::to_string(index)};
+		});
+	});
+
+	QCOMPARE(calls.load(), 100);
+}
+
+void thread_call_test::should_transform_in_order_in_thread_pool()
+{
+	auto source = std::vector<int>{};
+	for (auto i = 0; i < 1000; i++)
+		source.push_back(i);
+
+	auto result = parallel_transform(source, std::function<std::string(const int &)>{[](const int &i){ return std::to_string(i); }}, 1);
+
+	QCOMPARE(result.size(), source.size());
+	for (decltype(source.size()) i = 0; i < source.size(); i++)
+		QCOMPARE(result[i], std::to_string(source[i]));
+}
+
+void thread_call_test::should_transform_in_current_thread_below_threshold()
+{
+	auto source = std::vector<int>{1, 2, 3};
+	auto result = parallel_transform(source, std::function<QThread *(const int &)>{[](const int &){ return QThread::currentThread(); }}, 4);
+
+	QCOMPARE(result, (std::vector<QThread *>{QThread::currentThread(), QThread::currentThread(), QThread::currentThread()}));
+}
+
+void thread_call_test::should_rethrow_exception_of_first_item_from_parallel_transform()
+{
+	auto source = std::vector<int>{};
+	for (auto i = 0; i < 100; i++)
+		source.push_back(i);
+
+	auto transform = std::function<int(const int &)>{[](const int &i){
+		if (i == 7 || i == 70)
+			throw std::runtime_error{"item " + std::to_string(i)};
+		return i;
+	}};
+
+	expect<std::runtime_error>({"item 7"}, [&]{ parallel_transform(source, transform, 1); });
+	expect<std::runtime_error>({"item 7"}, [&]{ parallel_transform(source, transform, source.size() + 1); });
+}
+
+QTEST_GUILESS_MAIN(thread_call_test)
+#include "thread-call-test.moc"
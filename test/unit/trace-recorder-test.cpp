@@ -0,0 +1,161 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "internal/trace-recorder.h"
+
+#include <QtTest/QtTest>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class traced_type : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	void traced_method(QObject *) {}
+
+};
+
+class trace_recorder_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void cleanup();
+	void should_not_record_when_not_started();
+	void should_not_record_after_stop();
+	void should_record_nested_spans();
+	void should_append_details_to_name();
+	void should_record_thread_of_span();
+	void should_write_escaped_json();
+
+private:
+	const std::string file_name = "trace-recorder-test.json";
+
+};
+
+void trace_recorder_test::cleanup()
+{
+	trace_recorder::instance().stop();
+}
+
+void trace_recorder_test::should_not_record_when_not_started()
+{
+	trace_recorder::instance().start();
+	trace_recorder::instance().stop();
+	{
+		trace_span span{"span"};
+	}
+
+	QVERIFY(!trace_recorder::is_enabled());
+	QVERIFY(trace_recorder::instance().events().empty());
+}
+
+void trace_recorder_test::should_not_record_after_stop()
+{
+	trace_recorder::instance().start();
+	{
+		trace_span span{"span"};
+	}
+	trace_recorder::instance().stop();
+	{
+		trace_span span{"other span"};
+	}
+
+	QCOMPARE(trace_recorder::instance().events().size(), size_t{1});
+}
+
+void trace_recorder_test::should_record_nested_spans()
+{
+	trace_recorder::instance().start();
+	{
+		trace_span outer{"outer"};
+		trace_span inner{"inner"};
+	}
+
+	auto events = trace_recorder::instance().events();
+	QCOMPARE(events.size(), size_t{2});
+	QCOMPARE(events[0].name, std::string{"inner"});
+	QCOMPARE(events[1].name, std::string{"outer"});
+	QVERIFY(events[1].start <= events[0].start);
+	QVERIFY(events[1].start + events[1].duration >= events[0].start + events[0].duration);
+	QCOMPARE(events[0].thread, events[1].thread);
+}
+
+void trace_recorder_test::should_append_details_to_name()
+{
+	auto meta_object = &traced_type::staticMetaObject;
+	auto method = meta_object->method(meta_object->indexOfMethod("traced_method(QObject*)"));
+
+	trace_recorder::instance().start();
+	{
+		trace_span span{"provide", make_type<traced_type>()};
+	}
+	{
+		trace_span span{"INJEQT_SET", method};
+	}
+
+	auto events = trace_recorder::instance().events();
+	QCOMPARE(events.size(), size_t{2});
+	QCOMPARE(events[0].name, std::string{"provide traced_type"});
+	QCOMPARE(events[1].name, std::string{"INJEQT_SET traced_type::traced_method(QObject*)"});
+}
+
+void trace_recorder_test::should_record_thread_of_span()
+{
+	trace_recorder::instance().start();
+	{
+		trace_span span{"main"};
+	}
+	std::thread{[](){ trace_span span{"other"}; }}.join();
+
+	auto events = trace_recorder::instance().events();
+	QCOMPARE(events.size(), size_t{2});
+	QVERIFY(events[0].thread != events[1].thread);
+}
+
+void trace_recorder_test::should_write_escaped_json()
+{
+	auto events = std::vector<trace_event>{
+		trace_event{"plain", 10, 20, 1},
+		trace_event{"quote \" backslash \\", 15, 5, 2}
+	};
+
+	QVERIFY(write_trace_events(file_name, events, 42));
+
+	std::ifstream file{file_name};
+	std::stringstream content;
+	content << file.rdbuf();
+	file.close();
+	std::remove(file_name.c_str());
+
+	auto json = content.str();
+	QVERIFY(json.find("{\"traceEvents\":[") == 0);
+	QVERIFY(json.find("{\"name\":\"plain\",\"cat\":\"injeqt\",\"ph\":\"X\",\"ts\":10,\"dur\":20,\"pid\":42,\"tid\":1}") != std::string::npos);
+	QVERIFY(json.find("\"name\":\"quote \\\" backslash \\\\\"") != std::string::npos);
+}
+
+QTEST_APPLESS_MAIN(trace_recorder_test)
+#include "trace-recorder-test.moc"
@@ -0,0 +1,88 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "internal/trusted-scope.h"
+
+#include <QtTest/QtTest>
+#include <thread>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class trusted_scope_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_not_be_active_by_default();
+	void should_be_active_in_active_scope();
+	void should_not_be_active_in_inactive_scope();
+	void should_be_active_in_nested_scopes();
+	void should_not_be_active_in_other_thread();
+
+};
+
+void trusted_scope_test::should_not_be_active_by_default()
+{
+	QVERIFY(!trusted_scope::is_active());
+}
+
+void trusted_scope_test::should_be_active_in_active_scope()
+{
+	{
+		trusted_scope scope{true};
+		QVERIFY(trusted_scope::is_active());
+	}
+	QVERIFY(!trusted_scope::is_active());
+}
+
+void trusted_scope_test::should_not_be_active_in_inactive_scope()
+{
+	trusted_scope scope{false};
+	QVERIFY(!trusted_scope::is_active());
+}
+
+void trusted_scope_test::should_be_active_in_nested_scopes()
+{
+	{
+		trusted_scope outer{true};
+		{
+			trusted_scope inner{true};
+			trusted_scope inactive{false};
+			QVERIFY(trusted_scope::is_active());
+		}
+		QVERIFY(trusted_scope::is_active());
+	}
+	QVERIFY(!trusted_scope::is_active());
+}
+
+void trusted_scope_test::should_not_be_active_in_other_thread()
+{
+	trusted_scope scope{true};
+
+	auto active_in_other_thread = true;
+	std::thread other{[&](){ active_in_other_thread = trusted_scope::is_active(); }};
+	other.join();
+
+	QVERIFY(!active_in_other_thread);
+}
+
+QTEST_APPLESS_MAIN(trusted_scope_test)
+#include "trusted-scope-test.moc"
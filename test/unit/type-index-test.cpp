@@ -0,0 +1,84 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2014 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "internal/type-index.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_index_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_be_empty_after_default_construction();
+	void should_assign_ids_in_order();
+	void should_return_invalid_id_for_unknown_type();
+	void should_return_type_of_id();
+
+};
+
+void type_index_test::should_be_empty_after_default_construction()
+{
+	auto index = type_index{};
+	QCOMPARE(index.size(), size_t{0});
+	QCOMPARE(index.id_of(make_type<type_1>()), type_index::invalid_id);
+}
+
+void type_index_test::should_assign_ids_in_order()
+{
+	auto index = type_index{std::vector<type>{make_type<type_2>(), make_type<type_1>()}};
+	QCOMPARE(index.size(), size_t{2});
+	QCOMPARE(index.id_of(make_type<type_2>()), type_id{0});
+	QCOMPARE(index.id_of(make_type<type_1>()), type_id{1});
+}
+
+void type_index_test::should_return_invalid_id_for_unknown_type()
+{
+	auto index = type_index{std::vector<type>{make_type<type_1>(), make_type<type_2>()}};
+	QCOMPARE(index.id_of(make_type<type_3>()), type_index::invalid_id);
+}
+
+void type_index_test::should_return_type_of_id()
+{
+	auto index = type_index{std::vector<type>{make_type<type_1>(), make_type<type_2>(), make_type<type_3>()}};
+	for (auto &&t : {make_type<type_1>(), make_type<type_2>(), make_type<type_3>()})
+		QCOMPARE(index.type_of(index.id_of(t)), t);
+}
+
+QTEST_APPLESS_MAIN(type_index_test)
+#include "type-index-test.moc"
@@ -0,0 +1,182 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include <injeqt/exception/invalid-action.h>
+
+#include "internal/type-metadata.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class dependency_type : public QObject
+{
+	Q_OBJECT
+};
+
+class base_type : public QObject
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE("role1")
+	INJEQT_WARM_UP_PRIORITY(1)
+
+public slots:
+	INJEQT_SET void set_dependency(dependency_type *) {}
+	INJEQT_INIT void init_base() {}
+	INJEQT_DONE void done_base() {}
+
+};
+
+class derived_type : public base_type
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE("role2")
+	INJEQT_WARM_UP_PRIORITY(-5)
+
+public:
+	Q_INVOKABLE derived_type() {}
+
+public slots:
+	INJEQT_SETTER void set_dependency_2(dependency_type *) {}
+	INJEQT_SET void invalid_setter(dependency_type *, int) {}
+	INJEQT_INIT void init_derived() {}
+	dependency_type * create_dependency() { return nullptr; }
+
+};
+
+class invalid_init_type : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_INIT void invalid_init(int) {}
+	INJEQT_DONE void done() {}
+
+};
+
+class type_metadata_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_return_same_object_for_same_type();
+	void should_have_interfaces();
+	void should_have_pointer_name();
+	void should_have_setter_candidates();
+	void should_have_factory_candidates();
+	void should_have_actions_in_order();
+	void should_throw_only_for_invalid_actions();
+	void should_have_type_roles();
+	void should_have_default_constructor_index();
+	void should_have_warm_up_priority_of_most_derived_type();
+
+};
+
+void type_metadata_test::should_return_same_object_for_same_type()
+{
+	QCOMPARE(&type_metadata_for(make_type<derived_type>()), &type_metadata_for(make_type<derived_type>()));
+	QVERIFY(&type_metadata_for(make_type<derived_type>()) != &type_metadata_for(make_type<base_type>()));
+}
+
+void type_metadata_test::should_have_interfaces()
+{
+	QCOMPARE(type_metadata_for(make_type<QObject>()).interfaces(), types{});
+	QCOMPARE(type_metadata_for(make_type<base_type>()).interfaces(), (types{make_type<base_type>()}));
+	QCOMPARE(type_metadata_for(make_type<derived_type>()).interfaces(), (types{make_type<base_type>(), make_type<derived_type>()}));
+}
+
+void type_metadata_test::should_have_pointer_name()
+{
+	QCOMPARE(type_metadata_for(make_type<derived_type>()).pointer_name(), std::string{"derived_type*"});
+}
+
+void type_metadata_test::should_have_setter_candidates()
+{
+	auto &&candidates = type_metadata_for(make_type<derived_type>()).setter_candidates();
+
+	QCOMPARE(candidates.size(), size_t{3});
+	QCOMPARE(candidates[0].meta_method.methodSignature(), QByteArray{"set_dependency(dependency_type*)"});
+	QCOMPARE(candidates[0].parameter_pointer_name, std::string{"dependency_type*"});
+	QCOMPARE(candidates[1].meta_method.methodSignature(), QByteArray{"set_dependency_2(dependency_type*)"});
+	QCOMPARE(candidates[1].parameter_pointer_name, std::string{"dependency_type*"});
+	QCOMPARE(candidates[2].meta_method.methodSignature(), QByteArray{"invalid_setter(dependency_type*,int)"});
+	QCOMPARE(candidates[2].parameter_pointer_name, std::string{});
+}
+
+void type_metadata_test::should_have_factory_candidates()
+{
+	auto &&candidates = type_metadata_for(make_type<derived_type>()).factory_candidates();
+	auto factory = std::find_if(std::begin(candidates), std::end(candidates), [](const factory_candidate &c){
+		return c.meta_method.methodSignature() == "create_dependency()";
+	});
+
+	QVERIFY(factory != std::end(candidates));
+	QCOMPARE(factory->return_pointer_name, std::string{"dependency_type*"});
+	QVERIFY(std::none_of(std::begin(candidates), std::end(candidates), [](const factory_candidate &c){
+		return c.meta_method.parameterCount() != 0;
+	}));
+}
+
+void type_metadata_test::should_have_actions_in_order()
+{
+	auto &&metadata = type_metadata_for(make_type<derived_type>());
+
+	QCOMPARE(metadata.init_actions().size(), size_t{2});
+	QCOMPARE(metadata.init_actions()[0].object_type(), make_type<base_type>());
+	QCOMPARE(metadata.init_actions()[1].object_type(), make_type<derived_type>());
+	QCOMPARE(metadata.done_actions().size(), size_t{1});
+	QCOMPARE(metadata.done_actions()[0].object_type(), make_type<base_type>());
+}
+
+void type_metadata_test::should_throw_only_for_invalid_actions()
+{
+	auto &&metadata = type_metadata_for(make_type<invalid_init_type>());
+
+	expect<exception::invalid_action>({"invalid_init(int)"}, [&]{
+		metadata.init_actions();
+	});
+	QCOMPARE(metadata.done_actions().size(), size_t{1});
+}
+
+void type_metadata_test::should_have_type_roles()
+{
+	QCOMPARE(type_metadata_for(make_type<base_type>()).type_roles(), (std::vector<std::string>{"role1"}));
+	QCOMPARE(type_metadata_for(make_type<derived_type>()).type_roles(), (std::vector<std::string>{"role1", "role2"}));
+}
+
+void type_metadata_test::should_have_default_constructor_index()
+{
+	QCOMPARE(type_metadata_for(make_type<base_type>()).default_constructor_index(), -1);
+	QCOMPARE(type_metadata_for(make_type<derived_type>()).default_constructor_index(), 0);
+}
+
+void type_metadata_test::should_have_warm_up_priority_of_most_derived_type()
+{
+	QCOMPARE(type_metadata_for(make_type<dependency_type>()).warm_up_priority(), 0);
+	QCOMPARE(type_metadata_for(make_type<base_type>()).warm_up_priority(), 1);
+	QCOMPARE(type_metadata_for(make_type<derived_type>()).warm_up_priority(), -5);
+}
+
+QTEST_APPLESS_MAIN(type_metadata_test)
+#include "type-metadata-test.moc"
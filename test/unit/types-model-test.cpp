@@ -77,6 +77,7 @@ private slots:
 	void should_create_with_common_supertype();
 	void should_create_with_dependencies();
 	void should_throw_when_unresolvable_dependency();
+	void should_not_throw_when_not_validated();
 
 private:
 	types_by_name known_types;
@@ -218,5 +219,17 @@ void types_model_test::should_throw_when_unresolvable_dependency()
 	});
 }
 
+void types_model_test::should_not_throw_when_not_validated()
+{
+	auto m1 = make_types_model(known_types, {type_1_type, type_1_subtype_1_type}, {type_1_type, type_1_subtype_1_type}, false);
+	QCOMPARE(m1.available_types(), (implemented_by_mapping
+	{
+		implemented_by{type_1_subtype_1_type, type_1_subtype_1_type}
+	}));
+
+	auto m2 = make_types_model(known_types, {type_1_subtype_3_type}, {type_1_subtype_3_type}, false);
+	QCOMPARE(m2.get_unresolvable_dependencies().size(), size_t{2});
+}
+
 QTEST_APPLESS_MAIN(types_model_test)
 #include "types-model-test.moc"